@@ -53,6 +53,25 @@
 // 20240213 Added PM1.0 to Air Quality (Particulate Matter) Sensor decoder
 // 20240716 Fixed output of invalid battery state with 6-in-1 decoder
 // 20241228 Simplified for the sensor in Kassel
+// 20261019 Timestamps captured in receive ISR and converted to UTC via NTP anchored Timebase
+//          Per-sensor state (rain baseline, timestamps, RSSI statistics) in SensorTable
+//          Rain delta from per-sensor RainAccumulator (counter wrap/sensor reset handling)
+//          Recent readings kept in ColumnStore
+//          Rain statistics per sensor from GaugeManager (published as rain_hour/rain_day)
+//          Rain rate estimated per sensor (published as rain_rate)
+//          Interval summaries per sensor (published to weather/summary, optionally instead
+//          of the raw data)
+//          Wind vector mean, gusts and wind rose in interval summaries
+//          Readings logged to LittleFS (SegmentLog)
+//          Latest reading per sensor in lock-free SnapshotTable for concurrent readers
+//          Local HTTP server (/latest, /history, /metrics)
+//          Frame and encode buffers from static block pools
+//          Latency of the pipeline stages traced per frame (reported to serial and weather/trace)
+//          Per-sensor link statistics (RSSI, lost/duplicate frames, digest errors) published
+//          to weather/link
+//          Duplicate frames are discarded after counting
+//          Rain accumulator baselines persisted as one table blob (RainAccTable)
+//          Intervals of sensors which stopped sending are closed periodically
 // ToDo: 
 // - 
 //
@@ -62,22 +81,53 @@
 #include "src/WeatherSensorCfg.h"
 #include "src/WeatherSensor.h"
 #include "src/Decoder.h"
+#include "src/Timebase.h"
+#include "src/SensorTable.h"
+#include "src/ColumnStore.h"
+#include "src/GaugeManager.h"
+#include "src/RainAccTable.h"
+#include "src/IntervalAggregator.h"
+#include "src/SegmentLog.h"
+#include "src/SnapshotTable.h"
+#include "src/HttpServer.h"
+#include "src/BlockPool.h"
+#include "src/PipelineTrace.h"
 #include <WiFi.h>
 #include <time.h>
+#include <esp_sntp.h>
+#include <esp_system.h>
+#if defined(SEGMENT_LOG)
+#include <LittleFS.h>
+#endif
 #include <RadioLib.h>
 #include <PubSubClient.h>
 #include <ArduinoJson.h>
 #include "src/Secrets.h"
 
-#define JSON_BUFFER_SIZE 300
+#define JSON_BUFFER_SIZE 384
+// Interval summary: top-level members, wind rose (sectors x bins) and copied timestamp string
+#define JSON_SUMMARY_SIZE (JSON_OBJECT_SIZE(20) + JSON_ARRAY_SIZE(WIND_ROSE_SECTORS) + \
+                           WIND_ROSE_SECTORS * JSON_ARRAY_SIZE(WIND_ROSE_BINS) + 32)
+#define MQTT_BUFFER_SIZE 1024
 
-bool publishWeatherData(weather_data_t *ws, PubSubClient& mqtt_client, const char* mqtt_topic) {
+// Receive frame buffers and MQTT message buffers - static, no heap fragmentation
+StaticBlockPool<MSG_BUF_SIZE, POOL_FRAMES> framePool;
+StaticBlockPool<MQTT_BUFFER_SIZE, POOL_BUFFERS> bufferPool;
+
+#if defined(PIPELINE_TRACE)
+// Latency of the receive pipeline stages
+PipelineTrace pipelineTrace;
+// Cycle counter at packet reception (captured in ISR)
+volatile uint32_t receivedCycles = 0;
+#endif
+
+bool publishWeatherData(weather_data_t *ws, RainGauge *rain, PubSubClient& mqtt_client, const char* mqtt_topic) {
     if (!mqtt_client.connected()) {
         Serial.println("MQTT client not connected");
         return false;
     }
 
-    StaticJsonDocument<300> doc;
+    StaticJsonDocument<JSON_BUFFER_SIZE> doc;
     char time_str[26];
     strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", &ws->timestamp);
     
@@ -88,15 +138,35 @@ bool publishWeatherData(weather_data_t *ws, PubSubClient& mqtt_client, const cha
     doc["wind_direction"] = ws->wind_direction_deg;
     doc["rain"] = ws->rain_mm;
     doc["rain_delta"] = ws->delta_rain;
+    doc["rain_rate"] = ws->rain_rate;
+    if (rain) {
+        bool valid;
+        float rain_hour = rain->pastHour(&valid);
+        if (valid) {
+            doc["rain_hour"] = rain_hour;
+        }
+        doc["rain_day"] = rain->currentDay();
+    }
     doc["light_lux"] = ws->light_lux;
     doc["timestamp"] = time_str;
     doc["delta_t"] = ws->delta_t;
     doc["battery_ok"] = ws->battery_ok;
     
-    char buffer[JSON_BUFFER_SIZE];
-    serializeJson(doc, buffer);
+    PoolBlock block(bufferPool);
+    char *buffer = (char *)block.get();
+    if (!buffer) {
+        log_e("No encode buffer available");
+        return false;
+    }
+    serializeJson(doc, buffer, bufferPool.size());
+    #if defined(PIPELINE_TRACE)
+    pipelineTrace.mark(TRACE_JSON);
+    #endif
     
     bool published = mqtt_client.publish(mqtt_topic, buffer);
+    #if defined(PIPELINE_TRACE)
+    pipelineTrace.mark(TRACE_PUBLISH);
+    #endif
     
     if (!published) {
         Serial.println("Failed to publish MQTT message");
@@ -105,12 +175,171 @@ bool publishWeatherData(weather_data_t *ws, PubSubClient& mqtt_client, const cha
     return published;
 }
 
+#if defined(AGG_PUBLISH_SUMMARY)
+// Interval summary - same fields as the server's resample_data() plus min/max/count
+bool publishSummary(uint32_t sensor_id, const agg_interval_t &iv, PubSubClient& mqtt_client, const char* mqtt_topic) {
+    if (!mqtt_client.connected()) {
+        Serial.println("MQTT client not connected");
+        return false;
+    }
+
+    StaticJsonDocument<JSON_SUMMARY_SIZE> doc;
+    char time_str[26];
+    time_t start = iv.start;
+    struct tm tm;
+    gmtime_r(&start, &tm);
+    strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", &tm);
+
+    doc["sensor_id"] = sensor_id;
+    doc["timestamp"] = time_str;
+    doc["interval"] = AGG_INTERVAL;
+    doc["count"] = iv.frames;
+    if (aggValid(iv, AGG_TEMP)) {
+        doc["temperature"] = aggMean(iv, AGG_TEMP);
+        doc["temperature_min"] = iv.stat[AGG_TEMP].min;
+        doc["temperature_max"] = iv.stat[AGG_TEMP].max;
+    }
+    if (aggValid(iv, AGG_HUMIDITY)) {
+        doc["humidity"] = aggMean(iv, AGG_HUMIDITY);
+    }
+    if (aggValid(iv, AGG_WIND_SPEED)) {
+        doc["wind_speed"] = aggMean(iv, AGG_WIND_SPEED);
+        doc["wind_gust_max"] = iv.stat[AGG_WIND_GUST].max;
+        bool dir_valid;
+        float dir = iv.wind.direction(&dir_valid);
+        if (dir_valid) {
+            doc["wind_direction"] = dir;
+            doc["wind_direction_sd"] = iv.wind.directionStdDev();
+        }
+        doc["wind_speed_sd"] = iv.wind.speedStdDev();
+        doc["wind_calm"] = iv.wind.calm();
+        JsonArray rose = doc.createNestedArray("wind_rose");
+        for (int sector = 0; sector < WIND_ROSE_SECTORS; sector++) {
+            JsonArray bins = rose.createNestedArray();
+            for (int bin = 0; bin < WIND_ROSE_BINS; bin++) {
+                bins.add(iv.wind.rose(sector, bin));
+            }
+        }
+    }
+    if (aggValid(iv, AGG_RAIN)) {
+        doc["rain_delta"] = iv.stat[AGG_RAIN].sum;
+    }
+    if (aggValid(iv, AGG_LIGHT)) {
+        doc["light_lux"] = aggMean(iv, AGG_LIGHT);
+    }
+
+    PoolBlock block(bufferPool);
+    char *buffer = (char *)block.get();
+    if (!buffer) {
+        log_e("No encode buffer available");
+        return false;
+    }
+    serializeJson(doc, buffer, bufferPool.size());
+
+    bool published = mqtt_client.publish(mqtt_topic, buffer);
+
+    if (!published) {
+        Serial.println("Failed to publish MQTT message");
+    }
+
+    return published;
+}
+#endif
+
+#if defined(PIPELINE_TRACE)
+// Latency report - per stage: number of samples, mean, percentiles and max. in ns
+void reportTrace(const PipelineTrace &trace, PubSubClient& mqtt_client, const char* mqtt_topic) {
+    StaticJsonDocument<1024> doc;
+
+    Serial.printf("Stage      Count    Mean/us   P50/us   P90/us   P99/us   Max/us\n");
+    for (int i = 0; i < TRACE_STAGES; i++) {
+        trace_stage_t stage = (trace_stage_t)i;
+        const trace_stats_t &s = trace.stage(stage);
+        Serial.printf("%-8s %7u %10.1f %8.1f %8.1f %8.1f %8.1f\n", PipelineTrace::name(stage), (unsigned)s.count,
+                      trace.mean(stage) * 1e-3, trace.percentile(stage, 50) * 1e-3,
+                      trace.percentile(stage, 90) * 1e-3, trace.percentile(stage, 99) * 1e-3,
+                      s.max_ns * 1e-3);
+
+        JsonObject obj = doc.createNestedObject(PipelineTrace::name(stage));
+        obj["count"] = s.count;
+        obj["mean_ns"] = trace.mean(stage);
+        obj["p50_ns"] = trace.percentile(stage, 50);
+        obj["p90_ns"] = trace.percentile(stage, 90);
+        obj["p99_ns"] = trace.percentile(stage, 99);
+        obj["max_ns"] = s.max_ns;
+    }
+
+    PoolBlock block(bufferPool);
+    char *buffer = (char *)block.get();
+    if (!buffer) {
+        log_e("No encode buffer available");
+        return;
+    }
+    serializeJson(doc, buffer, bufferPool.size());
+    if (!mqtt_client.connected() || !mqtt_client.publish(mqtt_topic, buffer)) {
+        log_e("Failed to publish trace to MQTT");
+    }
+}
+#endif
+
+#if defined(LINK_STATS_INTERVAL)
+// Link statistics - one message per sensor, receiver totals to <topic>/receiver
+void reportLinkStats(const SensorTable &table, uint32_t unknown_digest_errors, PubSubClient& mqtt_client, const char* mqtt_topic) {
+    if (!mqtt_client.connected()) {
+        return;
+    }
+    PoolBlock block(bufferPool);
+    char *buffer = (char *)block.get();
+    if (!buffer) {
+        log_e("No encode buffer available");
+        return;
+    }
+    int64_t now_us = timebase_mono_us();
+
+    for (uint8_t rank = 0; rank < table.size(); rank++) {
+        const sensor_state_t *state = table.at(rank);
+        const LinkStats &link = state->link;
+        StaticJsonDocument<JSON_BUFFER_SIZE> doc;
+
+        doc["sensor_id"] = state->sensor_id;
+        doc["frames"] = state->frames;
+        doc["received"] = link.received();
+        doc["expected"] = link.expected();
+        doc["lost"] = link.lost();
+        doc["duplicates"] = link.duplicates();
+        doc["digest_errors"] = link.digestErrors();
+        doc["period_s"] = link.period() * 1e-3f;
+        doc["rssi_mean"] = link.rssi();
+        doc["rssi_sd"] = sqrtf(link.rssiVariance());
+        doc["rssi_min"] = link.rssiMinimum();
+        doc["rssi_max"] = link.rssiMaximum();
+        doc["age_s"] = (uint32_t)((now_us - link.lastSeen()) / 1000000LL);
+        serializeJson(doc, buffer, bufferPool.size());
+        if (!mqtt_client.publish(mqtt_topic, buffer)) {
+            log_e("Failed to publish link statistics to MQTT");
+        }
+    }
+
+    // Digest errors of unknown sensors (ID not trustworthy or not seen yet)
+    char topic[64];
+    snprintf(topic, sizeof(topic), "%s/receiver", mqtt_topic);
+    snprintf(buffer, bufferPool.size(), "{\"sensors\":%u,\"digest_errors\":%u}",
+             table.size(), (unsigned)unknown_digest_errors);
+    if (!mqtt_client.publish(topic, buffer)) {
+        log_e("Failed to publish link statistics to MQTT");
+    }
+}
+#endif
+
 // Add MQTT Configuration
 const char* ssid = WIFI_SSID;
 const char* password = WIFI_PASSWORD;
 const char* mqtt_server = MQTT_SERVER; // Computer's IP
 const int mqtt_port = MQTT_PORT;
 const char* mqtt_topic = "weather/raw";
+const char* mqtt_summary_topic = "weather/summary";
+const char* mqtt_trace_topic = "weather/trace";
+const char* mqtt_link_topic = "weather/link";
 
 WiFiClient espClient;
 PubSubClient mqtt_client(espClient);
@@ -128,6 +357,7 @@ void setup_wifi() {
 
 void setup_mqtt() {
     mqtt_client.setServer(mqtt_server, mqtt_port);
+    mqtt_client.setBufferSize(MQTT_BUFFER_SIZE);
     while (!mqtt_client.connected()) {
         Serial.println("Connecting to MQTT...");
         if (mqtt_client.connect("MDF", MQTT_USER, MQTT_PASSWORD)) {
@@ -147,25 +377,87 @@ const int   daylightOffset_sec = 0;      //
 
 // Flag to indicate that a packet was received
 volatile bool receivedFlag = false;
+// Monotonic time of packet reception (captured in ISR)
+volatile int64_t receivedMonoUs = 0;
+
+// Conversion of monotonic timestamps to UTC
+Timebase timebase;
+// NTP sample provided by SNTP callback, applied to timebase in loop()
+// (written by the SNTP task - the 64-bit pair is only accessed while holding ntpMux)
+portMUX_TYPE ntpMux = portMUX_INITIALIZER_UNLOCKED;
+bool ntpPending = false;
+int64_t ntpMonoUs;
+int64_t ntpUtcUs;
 SX1276 radio = new Module(PIN_RECEIVER_CS, PIN_RECEIVER_IRQ, PIN_RECEIVER_RST, PIN_RECEIVER_GPIO);
 weather_data_t ws;
-sensor_t sensor;
+// Per-sensor state
+SensorTable sensorTable;
+// Frames with digest error which could not be attributed to a known sensor
+uint32_t unknownDigestErrors = 0;
+// Recent readings per sensor
+ColumnStore columnStore;
+// Latest reading per sensor - written here, read lock-free by other tasks
+SnapshotTable snapshots;
+// Rain statistics per sensor
+GaugeManager gauges;
+#if defined(RAINGAUGE_USE_PREFS)
+// Rain accumulator baselines per sensor in Preferences
+PrefsBlobStorage rainAccPrefs("BWS-RA");
+RainAccTable rainAccTable(rainAccPrefs);
+#endif
+#if defined(SEGMENT_LOG)
+// Readings log in flash
+SegmentLog segmentLog(SEGMENT_LOG_DIR);
+#endif
+#if defined(HTTP_SERVER)
+// Local HTTP server - served from loop(), i.e. in the task which owns the data
+HttpResponder httpResponder(&snapshots, &columnStore, &sensorTable);
+HttpServer httpServer(httpResponder);
+#endif
 // timeout time
 const uint32_t timeout = 10000;
 
 // C-style interrupt handler
-void setReceivedFlag(void) {
-    receivedFlag = true;
-}
+#if defined(ESP8266) || defined(ESP32)
+  ICACHE_RAM_ATTR
+#endif
 void setFlag(void)
 {
-    // We got a packet, set the flag
+    // We got a packet, take the timestamp and set the flag
+    receivedMonoUs = timebase_mono_us();
+    #if defined(PIPELINE_TRACE)
+    receivedCycles = trace_cycles();
+    #endif
     receivedFlag = true;
 }
 
-float previous_rain = 0.0; // we initialize a rain variable that is updated as new data arrives.
-// The data arrives as the accumulated rain and we want the rain difference.
-struct tm previous_time; // we compare the delta t for the rain intensity.
+// SNTP time synchronization callback - provides a new anchor for the timebase
+void timeSyncCallback(struct timeval *tv)
+{
+    int64_t mono_us = timebase_mono_us();
+    int64_t utc_us = (int64_t)tv->tv_sec * 1000000LL + tv->tv_usec;
+
+    portENTER_CRITICAL(&ntpMux);
+    ntpMonoUs = mono_us;
+    ntpUtcUs = utc_us;
+    ntpPending = true;
+    portEXIT_CRITICAL(&ntpMux);
+}
+
+// Monotonic time at startup - reference for delta_t of a sensor's first reading
+int64_t startup_mono_us = 0;
+
+// Write pending rain gauge state before restart
+void shutdownHandler(void)
+{
+    gauges.flush();
+    #if defined(RAINGAUGE_USE_PREFS)
+    rainAccTable.flush();
+    #endif
+    #if defined(SEGMENT_LOG)
+    segmentLog.end();
+    #endif
+}
 
 void setup() 
 {
@@ -215,13 +507,30 @@ void setup()
         while (true)
             delay(10);
     }
+    sntp_set_time_sync_notification_cb(timeSyncCallback);
+    sntp_set_sync_interval(TIMEBASE_ANCHOR_INTERVAL_MS);
     configTime(gmtOffset_sec, daylightOffset_sec, ntpServer);
-    // Wait for time to be set
-    if (!getLocalTime(&previous_time)) {
+    // Wait for time to be set (the timebase is anchored by the SNTP callback)
+    struct tm time_info;
+    if (!getLocalTime(&time_info)) {
         Serial.println("Failed to obtain time");
-        return;
+    } else {
+        Serial.println(&time_info, "%A, %B %d %Y %H:%M:%S");
+    }
+    startup_mono_us = timebase_mono_us();
+    #if defined(SEGMENT_LOG)
+    if (!LittleFS.begin(true) || !segmentLog.begin()) {
+        log_e("Readings log not available");
+    } else {
+        log_d("Readings log: %u segments, %u pending", segmentLog.segments(), segmentLog.pending());
     }
-    Serial.println(&previous_time, "%A, %B %d %Y %H:%M:%S");
+    #endif
+    #if defined(HTTP_SERVER)
+    if (!httpServer.begin(HTTP_PORT)) {
+        log_e("HTTP server not available");
+    }
+    #endif
+    esp_register_shutdown_handler(shutdownHandler);
 
     log_d("%s Setup complete - awaiting incoming messages...", RECEIVER_CHIP);
     float rssi = radio.getRSSI();
@@ -249,16 +558,68 @@ void loop()
     }
     mqtt_client.loop();
 
+    // Apply new NTP sample to timebase
+    portENTER_CRITICAL(&ntpMux);
+    bool ntp_pending = ntpPending;
+    int64_t ntp_mono_us = ntpMonoUs;
+    int64_t ntp_utc_us = ntpUtcUs;
+    ntpPending = false;
+    portEXIT_CRITICAL(&ntpMux);
+    if (ntp_pending) {
+        timebase.anchor(ntp_mono_us, ntp_utc_us);
+        log_d("Timebase anchored, rate correction: %d ppb", timebase.rate());
+    }
+
+    #if defined(PIPELINE_TRACE)
+    // Periodic latency report
+    static int64_t trace_report_us = 0;
+    if (timebase_mono_us() - trace_report_us >= TRACE_REPORT_INTERVAL * 1000000LL) {
+        trace_report_us = timebase_mono_us();
+        reportTrace(pipelineTrace, mqtt_client, mqtt_trace_topic);
+    }
+    #endif
+
+    #if defined(LINK_STATS_INTERVAL)
+    // Periodic link statistics report
+    static int64_t link_report_us = 0;
+    if (timebase_mono_us() - link_report_us >= LINK_STATS_INTERVAL * 1000000LL) {
+        link_report_us = timebase_mono_us();
+        reportLinkStats(sensorTable, unknownDigestErrors, mqtt_client, mqtt_link_topic);
+    }
+    #endif
+
+    #if defined(AGG_PUBLISH_SUMMARY)
+    // Close the intervals of sensors which stopped sending (otherwise closed by the next frame)
+    static int64_t agg_poll_us = 0;
+    if (timebase.valid() && (timebase_mono_us() - agg_poll_us >= AGG_INTERVAL * 1000000LL)) {
+        agg_poll_us = timebase_mono_us();
+        time_t now = timebase.toUtc(agg_poll_us);
+        for (uint8_t rank = 0; rank < sensorTable.size(); rank++) {
+            sensor_state_t *s = sensorTable.at(rank);
+            agg_interval_t summary;
+            if (s->agg.poll(now, &summary) && !publishSummary(s->sensor_id, summary, mqtt_client, mqtt_summary_topic)) {
+                log_e("Failed to publish summary to MQTT");
+            }
+        }
+    }
+    #endif
+
     // Tries to receive radio message (non-blocking) and to decode it.
     // Timeout occurs after a small multiple of expected time-on-air.
-    uint8_t recvData[MSG_BUF_SIZE];
+    PoolBlock frame(framePool);
+    uint8_t *recvData = (uint8_t *)frame.get();
     DecodeStatus decode_res = DECODE_INVALID;
-        // Receive data
-        if (receivedFlag)
+        // Receive data (if no frame buffer is available, retry with the next loop)
+        if (receivedFlag && recvData)
         {
             receivedFlag = false;
+            int64_t rx_mono_us = receivedMonoUs;
 
             int state = radio.readData(recvData, MSG_BUF_SIZE);
+            #if defined(PIPELINE_TRACE)
+            pipelineTrace.begin(receivedCycles);
+            pipelineTrace.mark(TRACE_READ);
+            #endif
             float rssi = radio.getRSSI();
             state = radio.startReceive();
             Serial.printf("RSSI: [%6.1fdBm]\n", rssi);
@@ -270,7 +631,10 @@ void loop()
                 {
                     log_d("%s R [%02X] RSSI: %0.1f", RECEIVER_CHIP, recvData[0], rssi);
 
-                    decode_res = decoderPayload(&recvData[1], sizeof(recvData) - 1, &ws);
+                    decode_res = decoderPayload(&recvData[1], MSG_BUF_SIZE - 1, &ws);
+                    #if defined(PIPELINE_TRACE)
+                    pipelineTrace.mark(TRACE_DECODE);
+                    #endif
                     if (decode_res == DECODE_OK)
                     {
                         // Print decoded data
@@ -284,33 +648,66 @@ void loop()
                         batt = batt_low;
                     }
 
+                    // Per-sensor state - the rain data arrives as the accumulated rain
+                    // and we want the rain difference; delta t is used for the rain intensity
+                    bool created;
+                    sensor_state_t *state = sensorTable.lookup(ws.sensor_id, &created);
+                    if (created) {
+                        #if defined(RAINGAUGE_USE_PREFS)
+                        rainAccTable.restore(ws.sensor_id, state->rain);
+                        #endif
+                        state->rain_published = state->rain.total();
+                        state->last_mono_us = startup_mono_us;
+                    }
+                    state->frames++;
+                    if (state->link.update(rx_mono_us, rssi, LinkStats::hash(&recvData[1], MSG_BUF_SIZE - 1))) {
+                        // Repeated transmission - counted only, not stored, aggregated or published
+                        log_d("Duplicate frame");
+                        return;
+                    }
+
                     //further processing of the data.
                     // calculate the time difference between the current and the previous data
-                    struct tm current_time;
-                    if (!getLocalTime(&current_time)) {
+                    if (!timebase.valid()) {
                         Serial.println("Failed to obtain time");
                         return;
                     }
                     else {
-                        Serial.println(&current_time, "%A, %B %d %Y %H:%M:%S");
-                        ws.timestamp = current_time;
-                        ws.delta_t = difftime(mktime(&current_time), mktime(&previous_time));
+                        time_t current_time = timebase.toUtc(rx_mono_us);
+                        gmtime_r(&current_time, &ws.timestamp);
+                        Serial.println(&ws.timestamp, "%A, %B %d %Y %H:%M:%S");
+                        ws.delta_t = (rx_mono_us - state->last_mono_us) * 1.0e-6f;
                     }
+                    #if defined(PIPELINE_TRACE)
+                    pipelineTrace.mark(TRACE_TIME);
+                    #endif
                     
-                    // calculate the rain difference
-                    if (previous_rain <= 0.0) { // the first time we receive data
+                    // calculate the rain difference since the last published reading
+                    // (counter wrap and sensor reset are handled by the accumulator)
+                    bool rain_baseline = state->rain.valid();
+                    int32_t rain_inc = state->rain.update((uint32_t)lroundf(ws.rain_mm * 10), ws.startup);
+                    #if defined(RAINGAUGE_USE_PREFS)
+                    rainAccTable.update(ws.sensor_id, state->rain, (uint32_t)timebase.toUtc(rx_mono_us));
+                    #endif
+                    if (!rain_baseline) { // the first time we receive data
                         ws.delta_rain = -99.9;
                     }
                     else {
-                        if  (ws.rain_mm < previous_rain) { // the rain gauge has been reset
-                            previous_rain = 0.0;
-                            ws.delta_rain = ws.rain_mm;
-                        }
-                        else {
-                            ws.delta_rain = ws.rain_mm - previous_rain;
-                            previous_rain = ws.rain_mm;
-                        }
+                        ws.delta_rain = (state->rain.total() - state->rain_published) * 0.1f;
                     }
+                    // rain intensity from the time between rain gauge tips
+                    ws.rain_rate = state->rain_rate.update(timebase.toUtc(rx_mono_us),
+                                                           (rain_inc > 0) ? rain_inc : 0);
+                    snapshots.write(ws);
+                    packReading(&ws, &state->last);
+                    columnStore.append(state->last);
+                    #if defined(SEGMENT_LOG)
+                    segmentLog.append(state->last);
+                    #endif
+                    agg_interval_t summary;
+                    bool summary_closed = state->agg.update((time_t)state->last.epoch, ws,
+                                                            (rain_inc >= 0) ? rain_inc * 0.1f : -1.0f,
+                                                            &summary);
                 
                     Serial.printf("Id: [%8X] Typ: [%X] Ch: [%d] St: [%d] Bat: [%-3s] RSSI: [%6.1fdBm] \n",
                         static_cast<int> (ws.sensor_id),
@@ -363,14 +760,34 @@ void loop()
                     }
                     Serial.printf("\n");
 
+                    #if defined(AGG_PUBLISH_SUMMARY)
+                    if (summary_closed && !publishSummary(ws.sensor_id, summary, mqtt_client, mqtt_summary_topic)) {
+                        log_e("Failed to publish summary to MQTT");
+                    }
+                    #else
+                    (void)summary_closed;
+                    #endif
+
+                    #if defined(PIPELINE_TRACE)
+                    pipelineTrace.mark(TRACE_PROCESS);
+                    #endif
+                    #if !defined(AGG_SUMMARY_ONLY)
                     // Publish to MQTT and check result
-                    // Publish to MQTT and check result
-                    bool published = publishWeatherData(&ws, mqtt_client, mqtt_topic);
+                    RainGauge *rain = gauges.update(ws, (time_t)state->last.epoch);
+                    bool published = publishWeatherData(&ws, rain, mqtt_client, mqtt_topic);
+                    #else
+                    // Reading only stored locally (and summarized) - delta_t/delta_rain refer to it
+                    bool published = true;
+                    #endif
+                    #if defined(PIPELINE_TRACE)
+                    pipelineTrace.end();
+                    #endif
                     
                     if (published) {
-                        log_d("Data published successfully to MQTT");
-                        previous_time = current_time;
-                        previous_rain = ws.rain_mm;
+                        log_d("Reading published");
+                        state->last_mono_us = rx_mono_us;
+                        state->rain_published = state->rain.total();
+                        state->published++;
                     } else {
                         log_e("Failed to publish data to MQTT");
                         // Optionally retry or handle error
@@ -381,6 +798,15 @@ void loop()
                     else
                     {
                         log_d("Decode failed: [%d] \n", decode_res);
+                        if (decode_res == DECODE_DIG_ERR) {
+                            // Only attributed to a sensor which has already been received
+                            sensor_state_t *s = sensorTable.find(decoderSensorId(&recvData[1], MSG_BUF_SIZE - 1));
+                            if (s) {
+                                s->link.digestError();
+                            } else {
+                                unknownDigestErrors++;
+                            }
+                        }
                     }
                 } // if (recvData[0] == 0xD4)
 
@@ -397,5 +823,12 @@ void loop()
             }
         }
 
+    #if defined(HTTP_SERVER)
+    // Serve HTTP clients while waiting
+    if (httpServer.poll(1000) < 0) {
+        delay(1000);
+    }
+    #else
     delay(1000);
+    #endif
 } // loop()
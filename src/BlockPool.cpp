@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BlockPool.cpp
+//
+// Fixed-block memory pool with lock-free O(1) allocation
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "BlockPool.h"
+
+#if defined(ESP32)
+    #include <esp_attr.h>
+    // Callable from ISRs while the flash cache is disabled
+    #define POOL_ATTR IRAM_ATTR
+#else
+    #define POOL_ATTR
+#endif
+
+// Head value from tag and index - the tag is incremented with every change
+#define HEAD(old, index) ((((old) & 0xFFFF0000UL) + 0x10000UL) | (index))
+
+
+void
+BlockPool::reset(void)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        links[i].store((i + 1 < count) ? i + 1 : BLOCK_POOL_NIL, std::memory_order_relaxed);
+    }
+    used.store(0, std::memory_order_relaxed);
+    highWater.store(0, std::memory_order_relaxed);
+    failures.store(0, std::memory_order_relaxed);
+    head.store((count > 0) ? 0 : BLOCK_POOL_NIL, std::memory_order_release);
+}
+
+
+POOL_ATTR void *
+BlockPool::alloc(void)
+{
+    uint32_t old = head.load(std::memory_order_acquire);
+    uint16_t index;
+
+    for (;;) {
+        index = old & 0xFFFF;
+        if (index == BLOCK_POOL_NIL) {
+            failures.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        // The link may be stale if another context took the block meanwhile - then the
+        // tag has changed and the CAS fails
+        uint16_t next = links[index].load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(old, HEAD(old, next), std::memory_order_acquire,
+                                       std::memory_order_acquire)) {
+            break;
+        }
+    }
+
+    uint16_t n = used.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint16_t hw = highWater.load(std::memory_order_relaxed);
+    while ((n > hw) && !highWater.compare_exchange_weak(hw, n, std::memory_order_relaxed)) {
+    }
+    return mem + index * blockSize;
+}
+
+
+POOL_ATTR void
+BlockPool::release(void *block)
+{
+    if (!block || !owns(block)) {
+        return;
+    }
+    uint16_t index = ((uint8_t *)block - mem) / blockSize;
+    uint32_t old = head.load(std::memory_order_relaxed);
+
+    // Count before the block becomes available - inUse() never exceeds the capacity
+    used.fetch_sub(1, std::memory_order_relaxed);
+    do {
+        links[index].store(old & 0xFFFF, std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(old, HEAD(old, index), std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
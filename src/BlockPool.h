@@ -0,0 +1,224 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BlockPool.h
+//
+// Fixed-block memory pool with lock-free O(1) allocation
+//
+// The free blocks form a singly linked list (Treiber stack) of 16-bit block indices. The list
+// head combines the index of the first free block with a 16-bit tag which is incremented by
+// every change, so a compare-and-swap cannot succeed with a stale head (ABA problem).
+// alloc() and release() only use atomic loads/stores and CAS - no locks, no heap - and can be
+// called from any task and from ISR context.
+//
+// The number of blocks in use is tracked along with its maximum (high-water mark) and the
+// number of failed allocations, to size the pools from field data.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * Block index of the list end
+ */
+#define BLOCK_POOL_NIL 0xFFFF
+
+
+/**
+ * \class BlockPool
+ *
+ * \brief Pool of fixed-size blocks in caller provided storage (see StaticBlockPool)
+ */
+class BlockPool {
+private:
+    uint8_t  *mem;                          //!< block storage
+    size_t   blockSize;                     //!< block size in bytes
+    uint16_t count;                         //!< number of blocks
+    std::atomic<uint16_t> *links;           //!< next free block per block
+    std::atomic<uint32_t> head;             //!< tag (bits 31..16), first free block (bits 15..0)
+    std::atomic<uint16_t> used;             //!< number of blocks in use
+    std::atomic<uint16_t> highWater;        //!< max. number of blocks in use
+    std::atomic<uint32_t> failures;         //!< number of failed allocations
+
+public:
+    /**
+     * \brief Constructor
+     *
+     * reset() must be called before use.
+     *
+     * \param mem       block storage (count * size bytes)
+     * \param size      block size in bytes (multiple of the required alignment)
+     * \param count     number of blocks (< BLOCK_POOL_NIL)
+     * \param links     list storage (count entries)
+     */
+    BlockPool(void *mem, size_t size, uint16_t count, std::atomic<uint16_t> *links)
+        : mem((uint8_t *)mem), blockSize(size), count(count), links(links)
+    {
+    };
+
+    /**
+     * \brief Release all blocks and clear statistics
+     *
+     * Must not be called concurrently with alloc()/release().
+     */
+    void reset(void);
+
+    /**
+     * \brief Allocate block
+     *
+     * \returns pointer to block or nullptr if the pool is exhausted
+     */
+    void *alloc(void);
+
+    /**
+     * \brief Release block
+     *
+     * \param block     block allocated from this pool (nullptr is ignored)
+     */
+    void release(void *block);
+
+    /**
+     * \brief Check if a pointer refers to a block of this pool
+     */
+    bool owns(const void *p) const
+    {
+        return ((const uint8_t *)p >= mem) && ((const uint8_t *)p < mem + count * blockSize);
+    };
+
+    /**
+     * \brief Block size in bytes
+     */
+    size_t size(void) const
+    {
+        return blockSize;
+    };
+
+    /**
+     * \brief Number of blocks
+     */
+    uint16_t capacity(void) const
+    {
+        return count;
+    };
+
+    /**
+     * \brief Number of blocks in use
+     */
+    uint16_t inUse(void) const
+    {
+        return used.load(std::memory_order_relaxed);
+    };
+
+    /**
+     * \brief Max. number of blocks in use since reset()
+     */
+    uint16_t maxUsed(void) const
+    {
+        return highWater.load(std::memory_order_relaxed);
+    };
+
+    /**
+     * \brief Number of failed allocations since reset()
+     */
+    uint32_t failed(void) const
+    {
+        return failures.load(std::memory_order_relaxed);
+    };
+};
+
+
+/**
+ * \class StaticBlockPool
+ *
+ * \brief BlockPool with static storage for COUNT blocks of SIZE bytes
+ */
+template <size_t SIZE, uint16_t COUNT>
+class StaticBlockPool : public BlockPool {
+    static_assert((COUNT > 0) && (COUNT < BLOCK_POOL_NIL), "Invalid number of blocks");
+
+    // Block size rounded up to the max. fundamental alignment
+    static const size_t BLOCK = (SIZE + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+
+    alignas(max_align_t) uint8_t storage[COUNT * BLOCK];   //!< block storage
+    std::atomic<uint16_t> next[COUNT];                     //!< list storage
+
+public:
+    StaticBlockPool() : BlockPool(storage, BLOCK, COUNT, next)
+    {
+        reset();
+    };
+};
+
+
+/**
+ * \class PoolBlock
+ *
+ * \brief Block allocated for the lifetime of a scope - released on all return paths
+ */
+class PoolBlock {
+private:
+    BlockPool &pool;    //!< pool
+    void      *block;   //!< block, nullptr if allocation failed
+
+public:
+    PoolBlock(BlockPool &pool) : pool(pool), block(pool.alloc())
+    {
+    };
+
+    ~PoolBlock()
+    {
+        pool.release(block);
+    };
+
+    PoolBlock(const PoolBlock &) = delete;
+    PoolBlock &operator=(const PoolBlock &) = delete;
+
+    /**
+     * \brief Block, nullptr if the pool was exhausted
+     */
+    void *get(void) const
+    {
+        return block;
+    };
+};
+
+#endif
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CalendarTracker.cpp
+//
+// Local calendar day, week and month tracking with precomputed period boundaries
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CalendarTracker.h"
+#include "PackedReading.h"
+
+
+// Local midnight of tm's date shifted by days/months
+static time_t midnight(const struct tm *t, int days, int months)
+{
+    struct tm m = *t;
+
+    m.tm_mday += days;
+    m.tm_mon  += months;
+    m.tm_hour  = 0;
+    m.tm_min   = 0;
+    m.tm_sec   = 0;
+    m.tm_isdst = -1;
+    return mktime(&m);
+}
+
+
+void
+CalendarTracker::recalc(time_t timestamp)
+{
+    struct tm t;
+
+    localtime_r(&timestamp, &t);
+    dayNo   = (int32_t)(utcToEpoch(&t) / 86400);
+    weekNo  = (dayNo + 3) / 7; // 1970-01-01 was a Thursday
+    monthNo = (t.tm_year + 1900) * 12 + t.tm_mon;
+
+    dayBegin = midnight(&t, 0, 0);
+    dayEnd   = midnight(&t, 1, 0);
+    weekEnd  = midnight(&t, 7 - (t.tm_wday + 6) % 7, 0);
+    t.tm_mday = 1;
+    monthEnd = midnight(&t, 0, 1);
+
+    // Midnight may not exist (DST transition at 00:00) - mktime() normalizes it,
+    // but the timestamp must be within the current day
+    if (dayBegin > timestamp)
+        dayBegin = timestamp;
+}
+
+
+uint8_t
+CalendarTracker::change(time_t timestamp)
+{
+    if (!valid) {
+        recalc(timestamp);
+        valid = true;
+        return CALENDAR_DAY | CALENDAR_WEEK | CALENDAR_MONTH;
+    }
+
+    int32_t day   = dayNo;
+    int32_t week  = weekNo;
+    int32_t month = monthNo;
+
+    recalc(timestamp);
+
+    uint8_t flags = 0;
+    if (dayNo != day)
+        flags |= CALENDAR_DAY;
+    if (weekNo != week)
+        flags |= CALENDAR_WEEK;
+    if (monthNo != month)
+        flags |= CALENDAR_MONTH;
+    return flags;
+}
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CalendarTracker.h
+//
+// Local calendar day, week and month tracking with precomputed period boundaries
+//
+// The local day, week (starting on Monday) and month numbers and the epoch times of the next
+// day, week and month boundaries are computed with localtime_r()/mktime() once per day.
+// Every other update is just a range check of the timestamp against the current day.
+// The boundaries come from mktime(), so days are 23 or 25 hours long at DST transitions.
+// A timestamp before the start of the current day (time going backwards) triggers a
+// recalculation like any other day change.
+//
+// The boundaries depend on the time zone - call reset() after changing TZ.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef CALENDAR_TRACKER_H
+#define CALENDAR_TRACKER_H
+
+#include <stdint.h>
+#include <time.h>
+
+// Flags returned by CalendarTracker::update()
+#define CALENDAR_DAY    0x01    //!< day changed
+#define CALENDAR_WEEK   0x02    //!< week changed
+#define CALENDAR_MONTH  0x04    //!< month changed
+
+
+/**
+ * \class CalendarTracker
+ *
+ * \brief Local calendar period numbers with O(1) updates within a day
+ */
+class CalendarTracker {
+private:
+    time_t  dayBegin;   //!< start of current day
+    time_t  dayEnd;     //!< start of next day
+    time_t  weekEnd;    //!< start of next week
+    time_t  monthEnd;   //!< start of next month
+    int32_t dayNo;      //!< local day number (days since 1970-01-01)
+    int32_t weekNo;     //!< local week number (weeks since 1969-12-29)
+    int32_t monthNo;    //!< local month number (year * 12 + month)
+    bool    valid;      //!< period data valid
+
+    void recalc(time_t timestamp);
+
+public:
+    /**
+     * Constructor
+     */
+    CalendarTracker()
+    {
+        reset();
+    };
+
+    /**
+     * Discard period data (e.g. after changing the time zone)
+     */
+    void reset(void)
+    {
+        valid = false;
+    };
+
+    /**
+     * \brief Update periods with timestamp
+     *
+     * \param timestamp     timestamp
+     *
+     * \returns CALENDAR_DAY/CALENDAR_WEEK/CALENDAR_MONTH flags of periods changed
+     *          (all flags for the first update after reset)
+     */
+    uint8_t update(time_t timestamp)
+    {
+        if (valid && (timestamp < dayEnd) && (timestamp >= dayBegin))
+            return 0;
+        return change(timestamp);
+    };
+
+    /**
+     * \brief Recalculate periods (slow path of update())
+     */
+    uint8_t change(time_t timestamp);
+
+    /**
+     * \brief Local day number (days since 1970-01-01)
+     */
+    int32_t day(void) const
+    {
+        return dayNo;
+    };
+
+    /**
+     * \brief Local week number (weeks starting on Monday since 1969-12-29)
+     */
+    int32_t week(void) const
+    {
+        return weekNo;
+    };
+
+    /**
+     * \brief Local month number (year * 12 + month, month: 0...11)
+     */
+    int32_t month(void) const
+    {
+        return monthNo;
+    };
+
+    /**
+     * \brief Start of next day (epoch)
+     */
+    time_t nextDay(void) const
+    {
+        return dayEnd;
+    };
+
+    /**
+     * \brief Start of next week (epoch)
+     */
+    time_t nextWeek(void) const
+    {
+        return weekEnd;
+    };
+
+    /**
+     * \brief Start of next month (epoch)
+     */
+    time_t nextMonth(void) const
+    {
+        return monthEnd;
+    };
+};
+
+#endif
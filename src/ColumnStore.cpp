@@ -0,0 +1,435 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ColumnStore.cpp
+//
+// Columnar in-memory time-series store for decoded readings
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <string.h>
+#include "ColumnStore.h"
+
+#define NIL 0xFF
+
+// Valid flag per column
+static const uint16_t colMask[COL_COUNT] = {
+    PACKED_TEMP_OK, PACKED_HUMIDITY_OK, PACKED_WIND_OK, PACKED_WIND_OK,
+    PACKED_WIND_OK, PACKED_RAIN_OK, PACKED_LIGHT_OK, PACKED_UV_OK
+};
+
+// Resolution per column (same factors as in decoderPayload())
+static const float colScale[COL_COUNT] = {
+    0.1f, 1.0f, 0.1f, 0.1f, 1.0f, 0.1f, 1.0f, 0.1f
+};
+
+// Running reduction in fixed-point units
+typedef struct Accu {
+    int32_t  lo;
+    int32_t  hi;
+    int64_t  sum;
+    uint32_t count;
+    int32_t  first;
+    int32_t  last;
+    uint32_t first_ts;
+    uint32_t last_ts;
+} accu_t;
+
+
+/*
+ * Reduce v[begin...end-1] into accu
+ *
+ * If all rows of the block are valid for the column, the loop has no branches
+ * and can be vectorized by the compiler; otherwise rows are checked against mask.
+ */
+template <typename T>
+static void reduce(const T *v, const uint32_t *ts, const uint16_t *flags, uint16_t mask, bool dense,
+                   int begin, int end, accu_t &a)
+{
+    if (dense) {
+        int32_t lo = a.lo;
+        int32_t hi = a.hi;
+        int64_t sum = 0;
+        for (int i = begin; i < end; i++) {
+            int32_t x = v[i];
+            lo = (x < lo) ? x : lo;
+            hi = (x > hi) ? x : hi;
+            sum += x;
+        }
+        if (a.count == 0) {
+            a.first = v[begin];
+            a.first_ts = ts[begin];
+        }
+        a.lo = lo;
+        a.hi = hi;
+        a.sum += sum;
+        a.count += end - begin;
+        a.last = v[end - 1];
+        a.last_ts = ts[end - 1];
+        return;
+    }
+
+    for (int i = begin; i < end; i++) {
+        if ((flags[i] & mask) == 0)
+            continue;
+        int32_t x = v[i];
+        if (a.count == 0) {
+            a.first = x;
+            a.first_ts = ts[i];
+        }
+        a.lo = (x < a.lo) ? x : a.lo;
+        a.hi = (x > a.hi) ? x : a.hi;
+        a.sum += x;
+        a.count++;
+        a.last = x;
+        a.last_ts = ts[i];
+    }
+}
+
+
+void
+ColumnStore::clear(void)
+{
+    memset(series, 0, sizeof(series));
+    for (int i = 0; i < COLUMN_STORE_BLOCKS; i++) {
+        pool[i].next = (i < COLUMN_STORE_BLOCKS - 1) ? i + 1 : NIL;
+        pool[i].count = 0;
+    }
+    freeList = 0;
+    dropped = 0;
+}
+
+
+ColumnStore::series_t *
+ColumnStore::findSeries(uint32_t id)
+{
+    for (int i = 0; i < COLUMN_STORE_SERIES; i++) {
+        if (series[i].used && (series[i].sensor_id == id)) {
+            return &series[i];
+        }
+    }
+    return nullptr;
+}
+
+
+const ColumnStore::series_t *
+ColumnStore::findSeries(uint32_t id) const
+{
+    return const_cast<ColumnStore *>(this)->findSeries(id);
+}
+
+
+void
+ColumnStore::releaseSeries(series_t *s)
+{
+    if (s->blocks) {
+        pool[s->tail].next = freeList;
+        freeList = s->head;
+    }
+    memset(s, 0, sizeof(series_t));
+}
+
+
+ColumnStore::series_t *
+ColumnStore::allocSeries(uint32_t id)
+{
+    series_t *s = nullptr;
+
+    for (int i = 0; i < COLUMN_STORE_SERIES; i++) {
+        if (!series[i].used) {
+            s = &series[i];
+            break;
+        }
+        // Otherwise replace the series which has not been updated for the longest time
+        if (!s || (series[i].blocks == 0) ||
+            ((s->blocks != 0) && (pool[series[i].tail].ts[pool[series[i].tail].count - 1] <
+                                  pool[s->tail].ts[pool[s->tail].count - 1]))) {
+            s = &series[i];
+        }
+    }
+    if (s->used) {
+        log_d("ColumnStore: replacing series %08X", s->sensor_id);
+        releaseSeries(s);
+    }
+    s->sensor_id = id;
+    s->head = NIL;
+    s->tail = NIL;
+    s->used = true;
+    return s;
+}
+
+
+uint8_t
+ColumnStore::allocBlock(void)
+{
+    uint8_t n;
+
+    if (freeList != NIL) {
+        n = freeList;
+        freeList = pool[n].next;
+    } else {
+        // Recycle the oldest block of the series with the most blocks
+        series_t *v = nullptr;
+        for (int i = 0; i < COLUMN_STORE_SERIES; i++) {
+            if (series[i].used && (!v || (series[i].blocks > v->blocks))) {
+                v = &series[i];
+            }
+        }
+        n = v->head;
+        v->head = pool[n].next;
+        if (--v->blocks == 0) {
+            memset(v, 0, sizeof(series_t));
+        }
+    }
+    memset(pool[n].missing, 0, sizeof(pool[n].missing));
+    pool[n].count = 0;
+    pool[n].next = NIL;
+    return n;
+}
+
+
+bool
+ColumnStore::append(const packed_reading_t &p)
+{
+    series_t *s = findSeries(p.sensor_id);
+
+    if (!s) {
+        s = allocSeries(p.sensor_id);
+    } else {
+        const column_block_t &t = pool[s->tail];
+        if (t.count && (p.epoch < t.ts[t.count - 1])) {
+            dropped++;
+            return false;
+        }
+    }
+
+    if ((s->blocks == 0) || (pool[s->tail].count == COLUMN_STORE_BLOCK_SIZE)) {
+        // A full pool recycles the oldest block of the longest chain; the current tail
+        // is full, so the own chain keeps at least the new block
+        uint8_t n = allocBlock();
+        if (!s->used) {
+            // Own single block has been recycled
+            s->sensor_id = p.sensor_id;
+            s->used = true;
+        }
+        if (s->blocks == 0) {
+            s->head = n;
+        } else {
+            pool[s->tail].next = n;
+        }
+        s->tail = n;
+        s->blocks++;
+    }
+    s->s_type = p.s_type;
+    s->chan = p.chan;
+
+    column_block_t &b = pool[s->tail];
+    uint8_t i = b.count++;
+    b.ts[i]            = p.epoch;
+    b.temp_dc[i]       = p.temp_dc;
+    b.humidity[i]      = p.humidity;
+    b.wind_avg_dms[i]  = p.wind_avg_dms;
+    b.wind_gust_dms[i] = p.wind_gust_dms;
+    b.wind_dir_deg[i]  = p.wind_dir_deg;
+    b.rain_dmm[i]      = p.rain_dmm;
+    b.light_lux[i]     = p.light_lux;
+    b.uv_d[i]          = p.uv_d;
+    b.flags[i]         = p.flags;
+    for (int c = 0; c < COL_COUNT; c++) {
+        if ((p.flags & colMask[c]) == 0) {
+            b.missing[c]++;
+        }
+    }
+    return true;
+}
+
+
+void
+ColumnStore::range(const column_block_t &b, uint32_t from, uint32_t to, int &begin, int &end) const
+{
+    // Binary search - first row with ts >= from
+    int lo = 0;
+    int hi = b.count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (b.ts[mid] < from)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    begin = lo;
+
+    // First row with ts > to
+    hi = b.count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (b.ts[mid] <= to)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    end = lo;
+}
+
+
+bool
+ColumnStore::stats(uint32_t id, column_t col, uint32_t from, uint32_t to, column_stats_t &res) const
+{
+    const series_t *s = findSeries(id);
+    accu_t a = {INT32_MAX, INT32_MIN, 0, 0, 0, 0, 0, 0};
+
+    memset(&res, 0, sizeof(column_stats_t));
+    if (!s || (col >= COL_COUNT)) {
+        return false;
+    }
+
+    for (uint8_t n = s->head; n != NIL; n = pool[n].next) {
+        const column_block_t &b = pool[n];
+        if (b.ts[b.count - 1] < from)
+            continue;
+        if (b.ts[0] > to)
+            break;
+
+        int begin = 0;
+        int end = b.count;
+        if ((b.ts[0] < from) || (b.ts[b.count - 1] > to)) {
+            range(b, from, to, begin, end);
+        }
+        if (begin >= end)
+            continue;
+
+        uint16_t mask = colMask[col];
+        bool dense = (b.missing[col] == 0);
+        switch (col) {
+            case COL_TEMP:
+                reduce(b.temp_dc, b.ts, b.flags, mask, dense, begin, end, a);
+                break;
+            case COL_HUMIDITY:
+                reduce(b.humidity, b.ts, b.flags, mask, dense, begin, end, a);
+                break;
+            case COL_WIND_AVG:
+                reduce(b.wind_avg_dms, b.ts, b.flags, mask, dense, begin, end, a);
+                break;
+            case COL_WIND_GUST:
+                reduce(b.wind_gust_dms, b.ts, b.flags, mask, dense, begin, end, a);
+                break;
+            case COL_WIND_DIR:
+                reduce(b.wind_dir_deg, b.ts, b.flags, mask, dense, begin, end, a);
+                break;
+            case COL_RAIN:
+                reduce(b.rain_dmm, b.ts, b.flags, mask, dense, begin, end, a);
+                break;
+            case COL_LIGHT:
+                reduce(b.light_lux, b.ts, b.flags, mask, dense, begin, end, a);
+                break;
+            case COL_UV:
+                reduce(b.uv_d, b.ts, b.flags, mask, dense, begin, end, a);
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (a.count == 0) {
+        return false;
+    }
+    float scale = colScale[col];
+    res.count    = a.count;
+    res.min      = a.lo * scale;
+    res.max      = a.hi * scale;
+    res.mean     = (float)((double)a.sum * scale / a.count);
+    res.first    = a.first * scale;
+    res.last     = a.last * scale;
+    res.first_ts = a.first_ts;
+    res.last_ts  = a.last_ts;
+    return true;
+}
+
+
+size_t
+ColumnStore::read(uint32_t id, uint32_t from, uint32_t to, packed_reading_t *out, size_t max) const
+{
+    const series_t *s = findSeries(id);
+    size_t rows = 0;
+
+    if (!s) {
+        return 0;
+    }
+
+    for (uint8_t n = s->head; (n != NIL) && (rows < max); n = pool[n].next) {
+        const column_block_t &b = pool[n];
+        int begin;
+        int end;
+        range(b, from, to, begin, end);
+        for (int i = begin; (i < end) && (rows < max); i++) {
+            packed_reading_t &p = out[rows++];
+            memset(&p, 0, sizeof(packed_reading_t));
+            p.epoch         = b.ts[i];
+            p.sensor_id     = id;
+            p.temp_dc       = b.temp_dc[i];
+            p.humidity      = b.humidity[i];
+            p.s_type        = s->s_type;
+            p.chan          = s->chan;
+            p.wind_dir_deg  = b.wind_dir_deg[i];
+            p.wind_gust_dms = b.wind_gust_dms[i];
+            p.wind_avg_dms  = b.wind_avg_dms[i];
+            p.rain_dmm      = b.rain_dmm[i];
+            p.uv_d          = b.uv_d[i];
+            p.light_lux     = b.light_lux[i];
+            p.flags         = b.flags[i];
+        }
+        if ((end < b.count) && (b.ts[end] > to))
+            break;
+    }
+    return rows;
+}
+
+
+uint32_t
+ColumnStore::rows(uint32_t id) const
+{
+    const series_t *s = findSeries(id);
+    uint32_t res = 0;
+
+    if (s) {
+        for (uint8_t n = s->head; n != NIL; n = pool[n].next) {
+            res += pool[n].count;
+        }
+    }
+    return res;
+}
@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ColumnStore.h
+//
+// Columnar in-memory time-series store for decoded readings
+//
+// Recent readings are kept per sensor as separate column arrays in fixed-size blocks taken
+// from a static pool. Each sensor's blocks form a chain ordered by time; appending is O(1).
+// Range queries locate the first and last row by binary search on the timestamp column and
+// then reduce the value column with tight loops over contiguous arrays (vectorizable, no
+// per-row timestamp checks). Values are stored in the sensor's native fixed-point resolution
+// (see PackedReading.h).
+//
+// When the pool is exhausted, the oldest block of the sensor with the most blocks is recycled.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef COLUMN_STORE_H
+#define COLUMN_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "WeatherSensorCfg.h"
+#include "PackedReading.h"
+
+// Number of rows per block
+#define COLUMN_STORE_BLOCK_SIZE 64
+
+#if (COLUMN_STORE_BLOCKS < 2) || (COLUMN_STORE_BLOCKS > 254) || (COLUMN_STORE_SERIES < 1) || \
+    (COLUMN_STORE_BLOCK_SIZE > 255)
+    #error "Invalid COLUMN_STORE_BLOCKS/COLUMN_STORE_SERIES/COLUMN_STORE_BLOCK_SIZE"
+#endif
+
+/**
+ * \brief Queryable value columns
+ */
+typedef enum Column {
+    COL_TEMP,           //!< temperature in degC
+    COL_HUMIDITY,       //!< humidity in %
+    COL_WIND_AVG,       //!< wind speed (avg) in m/s
+    COL_WIND_GUST,      //!< wind speed (gusts) in m/s
+    COL_WIND_DIR,       //!< wind direction in deg
+    COL_RAIN,           //!< rain gauge level in mm
+    COL_LIGHT,          //!< light in lux
+    COL_UV,             //!< uv radiation
+    COL_COUNT
+} column_t;
+
+/**
+ * \brief Result of a range query - values in physical units
+ */
+typedef struct ColumnStats {
+    uint32_t count;     //!< number of valid values in range
+    float    min;       //!< minimum
+    float    max;       //!< maximum
+    float    mean;      //!< arithmetic mean
+    float    first;     //!< oldest value in range
+    float    last;      //!< newest value in range
+    uint32_t first_ts;  //!< timestamp of oldest value (UTC, seconds since epoch)
+    uint32_t last_ts;   //!< timestamp of newest value (UTC, seconds since epoch)
+} column_stats_t;
+
+/**
+ * \brief Block of rows - one array per column
+ */
+typedef struct ColumnBlock {
+    uint32_t ts[COLUMN_STORE_BLOCK_SIZE];               //!< timestamp (UTC) in seconds since epoch
+    uint32_t rain_dmm[COLUMN_STORE_BLOCK_SIZE];         //!< rain gauge level in 0.1 mm
+    uint32_t light_lux[COLUMN_STORE_BLOCK_SIZE];        //!< light in lux
+    int16_t  temp_dc[COLUMN_STORE_BLOCK_SIZE];          //!< temperature in 0.1 degC
+    uint16_t wind_avg_dms[COLUMN_STORE_BLOCK_SIZE];     //!< wind speed (avg) in 0.1 m/s
+    uint16_t wind_gust_dms[COLUMN_STORE_BLOCK_SIZE];    //!< wind speed (gusts) in 0.1 m/s
+    uint16_t wind_dir_deg[COLUMN_STORE_BLOCK_SIZE];     //!< wind direction in deg
+    uint16_t uv_d[COLUMN_STORE_BLOCK_SIZE];             //!< uv radiation in 0.1
+    uint16_t flags[COLUMN_STORE_BLOCK_SIZE];            //!< PACKED_* flags
+    uint8_t  humidity[COLUMN_STORE_BLOCK_SIZE];         //!< humidity in %
+    uint8_t  missing[COL_COUNT];                        //!< number of rows without valid value per column
+    uint8_t  count;                                     //!< number of rows in use
+    uint8_t  next;                                      //!< next (newer) block in chain
+} column_block_t;
+
+
+/**
+ * \class ColumnStore
+ *
+ * \brief Per-sensor columnar store of recent readings
+ */
+class ColumnStore {
+private:
+    /**
+     * \brief Chain of blocks of one sensor
+     */
+    typedef struct Series {
+        uint32_t sensor_id;     //!< sensor ID
+        uint8_t  s_type;        //!< sensor type of last reading
+        uint8_t  chan;          //!< channel of last reading
+        uint8_t  head;          //!< oldest block
+        uint8_t  tail;          //!< newest block
+        uint8_t  blocks;        //!< number of blocks in chain
+        bool     used;          //!< series in use
+    } series_t;
+
+    column_block_t pool[COLUMN_STORE_BLOCKS];   //!< block storage
+    series_t series[COLUMN_STORE_SERIES];       //!< series table
+    uint8_t  freeList;                          //!< first free block
+    uint32_t dropped;                           //!< number of rows dropped (out of order)
+
+    series_t *findSeries(uint32_t id);
+    const series_t *findSeries(uint32_t id) const;
+    series_t *allocSeries(uint32_t id);
+    void     releaseSeries(series_t *s);
+    uint8_t  allocBlock(void);
+    void     range(const column_block_t &b, uint32_t from, uint32_t to, int &begin, int &end) const;
+
+public:
+    /**
+     * Constructor
+     */
+    ColumnStore()
+    {
+        clear();
+    };
+
+    /**
+     * Remove all rows
+     */
+    void clear(void);
+
+    /**
+     * \brief Append reading
+     *
+     * Readings must be appended in time order per sensor. If no series is available for
+     * a new sensor, the series with the oldest newest row is discarded.
+     *
+     * \param p         packed reading
+     *
+     * \returns false if the reading is older than the newest row of its sensor (dropped)
+     */
+    bool append(const packed_reading_t &p);
+
+    /**
+     * \brief Statistics of a column over a time range
+     *
+     * Rows without a valid value for the column (see PACKED_*_OK flags) are skipped.
+     *
+     * \param id        sensor ID
+     * \param col       column
+     * \param from      start of range (UTC, seconds since epoch, inclusive)
+     * \param to        end of range (UTC, seconds since epoch, inclusive)
+     * \param stats     result
+     *
+     * \returns true if at least one valid value was found
+     */
+    bool stats(uint32_t id, column_t col, uint32_t from, uint32_t to, column_stats_t &stats) const;
+
+    /**
+     * \brief Read rows of a time range
+     *
+     * \param id        sensor ID
+     * \param from      start of range (UTC, seconds since epoch, inclusive)
+     * \param to        end of range (UTC, seconds since epoch, inclusive)
+     * \param out       destination buffer
+     * \param max       size of destination buffer (rows)
+     *
+     * \returns number of rows copied (oldest first)
+     */
+    size_t read(uint32_t id, uint32_t from, uint32_t to, packed_reading_t *out, size_t max) const;
+
+    /**
+     * \brief Number of rows stored for a sensor
+     */
+    uint32_t rows(uint32_t id) const;
+
+    /**
+     * \brief Number of rows dropped since clear()
+     */
+    uint32_t droppedRows(void) const
+    {
+        return dropped;
+    };
+};
+
+#endif
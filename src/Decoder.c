@@ -117,4 +117,12 @@ DecodeStatus decoderPayload(uint8_t const *msg, uint8_t msgSize,
     ws->uv = uv_index;
 
     return DECODE_OK;
-   }
\ No newline at end of file
+   }
+
+uint32_t decoderSensorId(uint8_t const *msg, uint8_t msgSize)
+{
+    if (msgSize < 4)
+        return 0;
+    // Same position and de-whitening as in decoderPayload()
+    return ((uint32_t)(msg[2] ^ 0xaa) << 8) | (msg[3] ^ 0xaa);
+}
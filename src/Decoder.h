@@ -32,6 +32,14 @@ typedef enum DecodeStatus {
 DecodeStatus decoderPayload(uint8_t const *msg, uint8_t msgSize,
    weather_data_t *ws);
 
+/**
+ * @brief Sensor ID of a payload without any checks (e.g. to attribute digest errors)
+ * @param msg Input message buffer containing sensor data
+ * @param msgSize Length of the message buffer
+ * @return Unverified sensor ID
+ */
+uint32_t decoderSensorId(uint8_t const *msg, uint8_t msgSize);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,360 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// GaugeManager.cpp
+//
+// Rain gauge and lightning statistics for multiple sensors, keyed by sensor ID
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Added Lightning
+// 20261019 Added StormTracker per lightning sensor
+// 20261019 Fixed reset() being undone by loading the persisted state
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <math.h>
+#include "GaugeManager.h"
+
+
+GaugeManager::GaugeManager()
+#if defined(GAUGE_MANAGER_USE_PREFS)
+    : prefs("BWS-GM"),
+      persist(prefs, GAUGE_MANAGER_VERSION)
+#elif defined(GAUGE_MANAGER_PERSIST)
+    : persist(prefs, GAUGE_MANAGER_VERSION)
+#endif
+{
+    attachState();
+#if defined(GAUGE_MANAGER_PERSIST)
+    loaded = false;
+#endif
+    clear();
+}
+
+
+#if defined(GAUGE_MANAGER_PERSIST)
+GaugeManager::GaugeManager(BlobStorage &backend)
+#if defined(GAUGE_MANAGER_USE_PREFS)
+    : prefs("BWS-GM"),
+      persist(backend, GAUGE_MANAGER_VERSION)
+#else
+    : persist(backend, GAUGE_MANAGER_VERSION)
+#endif
+{
+    attachState();
+    loaded = false;
+    clear();
+}
+#endif
+
+
+void
+GaugeManager::attachState(void)
+{
+    for (int i = 0; i < GAUGE_MANAGER_SIZE; i++) {
+        rain[i].attach(&state.rain[i]);
+    }
+    for (int i = 0; i < GAUGE_MANAGER_LIGHTNING; i++) {
+        lightning[i].attach(&state.lightning[i]);
+    }
+}
+
+
+void
+GaugeManager::reset(void)
+{
+#if defined(GAUGE_MANAGER_PERSIST)
+    // Continue the sequence of the persisted slots, so the cleared state is the newest one
+    load();
+    clear();
+    persist.changed(0);
+    persist.flush(&state, sizeof(state));
+#else
+    clear();
+#endif
+}
+
+
+void
+GaugeManager::clear(void)
+{
+    for (int i = 0; i < GAUGE_MANAGER_SIZE; i++) {
+        state.sensor_id[i] = 0;
+        rain[i].reset();
+    }
+    for (int i = 0; i < GAUGE_MANAGER_LIGHTNING; i++) {
+        state.lightning_id[i] = 0;
+        lightning[i].reset();
+        storms[i].reset();
+    }
+}
+
+
+int
+GaugeManager::find(const uint32_t *ids, int n, uint32_t id)
+{
+    for (int i = 0; i < n; i++) {
+        if (ids[i] == id)
+            return i;
+    }
+    return -1;
+}
+
+
+void
+GaugeManager::load(void)
+{
+#if defined(GAUGE_MANAGER_PERSIST)
+    if (loaded)
+        return;
+    if (persist.load(&state, sizeof(state))) {
+        attachState();
+    } else {
+        clear();
+    }
+    loaded = true;
+#endif
+}
+
+
+void
+GaugeManager::save(uint32_t now, uint32_t weight)
+{
+#if defined(GAUGE_MANAGER_PERSIST)
+    persist.changed(now, weight);
+    persist.poll(&state, sizeof(state), now);
+#else
+    (void)now;
+    (void)weight;
+#endif
+}
+
+
+RainGauge *
+GaugeManager::update(const weather_data_t &ws, time_t timestamp)
+{
+    if (!ws.rain_ok || (ws.sensor_id == 0))
+        return nullptr;
+
+    load();
+
+    int i = find(state.sensor_id, GAUGE_MANAGER_SIZE, ws.sensor_id);
+    if (i < 0) {
+        // Allocate free entry or replace the sensor updated least recently
+        i = find(state.sensor_id, GAUGE_MANAGER_SIZE, 0);
+        if (i < 0) {
+            i = 0;
+            for (int k = 1; k < GAUGE_MANAGER_SIZE; k++) {
+                if (state.rain[k].lastUpdate < state.rain[i].lastUpdate)
+                    i = k;
+            }
+            log_w("Sensor %08X replaced by %08X", (unsigned)state.sensor_id[i], (unsigned)ws.sensor_id);
+        }
+        state.sensor_id[i] = ws.sensor_id;
+        rain[i].reset();
+    }
+
+    float prev = state.rain[i].rainPrev;
+    bool first = (state.rain[i].lastUpdate == 0);
+    rain[i].update(timestamp, ws.rain_mm, ws.startup);
+
+    // New sensors are written immediately, otherwise weighted by rain in 0.1 mm
+    save((uint32_t)timestamp,
+         first ? PERSIST_DELTA : (uint32_t)lroundf(fabsf(state.rain[i].rainPrev - prev) * 10));
+    return &rain[i];
+}
+
+
+Lightning *
+GaugeManager::updateLightning(uint32_t id, time_t timestamp, int16_t count, uint8_t distance, bool startup,
+                              uint8_t *alerts)
+{
+    if (alerts)
+        *alerts = 0;
+    if (id == 0)
+        return nullptr;
+
+    load();
+
+    int i = find(state.lightning_id, GAUGE_MANAGER_LIGHTNING, id);
+    if (i < 0) {
+        i = find(state.lightning_id, GAUGE_MANAGER_LIGHTNING, 0);
+        if (i < 0) {
+            i = 0;
+            for (int k = 1; k < GAUGE_MANAGER_LIGHTNING; k++) {
+                if (state.lightning[k].lastUpdate < state.lightning[i].lastUpdate)
+                    i = k;
+            }
+            log_w("Sensor %08X replaced by %08X", (unsigned)state.lightning_id[i], (unsigned)id);
+        }
+        state.lightning_id[i] = id;
+        lightning[i].reset();
+        storms[i].reset();
+    }
+
+    bool first = (state.lightning[i].lastUpdate == 0);
+    lightning[i].update(timestamp, count, distance, startup);
+
+    // New sensors are written immediately, otherwise weighted by number of events
+    int events = lightning[i].lastCycle();
+    uint8_t flags = storms[i].update(timestamp, events, distance);
+    if (alerts)
+        *alerts = flags;
+    save((uint32_t)timestamp, first ? PERSIST_DELTA : (events > 0) ? events : 0);
+    return &lightning[i];
+}
+
+
+RainGauge *
+GaugeManager::rainGauge(uint32_t id)
+{
+    int i = (id != 0) ? find(state.sensor_id, GAUGE_MANAGER_SIZE, id) : -1;
+
+    return (i < 0) ? nullptr : &rain[i];
+}
+
+
+Lightning *
+GaugeManager::lightningSensor(uint32_t id)
+{
+    int i = (id != 0) ? find(state.lightning_id, GAUGE_MANAGER_LIGHTNING, id) : -1;
+
+    return (i < 0) ? nullptr : &lightning[i];
+}
+
+
+StormTracker *
+GaugeManager::storm(uint32_t id)
+{
+    int i = (id != 0) ? find(state.lightning_id, GAUGE_MANAGER_LIGHTNING, id) : -1;
+
+    return (i < 0) ? nullptr : &storms[i];
+}
+
+
+float
+GaugeManager::pastHour(uint32_t id, bool *valid, int *quality)
+{
+    RainGauge *rg = rainGauge(id);
+
+    if (!rg) {
+        if (valid)
+            *valid = false;
+        if (quality)
+            *quality = 0;
+        return 0;
+    }
+    return rg->pastHour(valid, quality);
+}
+
+
+float
+GaugeManager::window(uint32_t id, uint32_t minutes, bool *valid)
+{
+    RainGauge *rg = rainGauge(id);
+
+    if (!rg) {
+        if (valid)
+            *valid = false;
+        return 0;
+    }
+    return rg->window(minutes, valid);
+}
+
+
+float
+GaugeManager::currentDay(uint32_t id)
+{
+    RainGauge *rg = rainGauge(id);
+
+    return rg ? rg->currentDay() : -1;
+}
+
+
+float
+GaugeManager::currentWeek(uint32_t id)
+{
+    RainGauge *rg = rainGauge(id);
+
+    return rg ? rg->currentWeek() : -1;
+}
+
+
+float
+GaugeManager::currentMonth(uint32_t id)
+{
+    RainGauge *rg = rainGauge(id);
+
+    return rg ? rg->currentMonth() : -1;
+}
+
+
+int
+GaugeManager::lightningPastHour(uint32_t id, bool *valid, int *quality)
+{
+    Lightning *lgt = lightningSensor(id);
+
+    if (!lgt) {
+        if (valid)
+            *valid = false;
+        if (quality)
+            *quality = 0;
+        return 0;
+    }
+    return lgt->pastHour(valid, quality);
+}
+
+
+uint8_t
+GaugeManager::size(void) const
+{
+    uint8_t n = 0;
+
+    for (int i = 0; i < GAUGE_MANAGER_SIZE; i++) {
+        if (state.sensor_id[i] != 0)
+            n++;
+    }
+    return n;
+}
+
+
+void
+GaugeManager::flush(void)
+{
+#if defined(GAUGE_MANAGER_PERSIST)
+    persist.flush(&state, sizeof(state));
+#endif
+}
@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// GaugeManager.h
+//
+// Rain gauge and lightning statistics for multiple sensors, keyed by sensor ID
+//
+// Fixed pools of RainGauge and Lightning instances; decoded frames are routed to the instance
+// of their sensor ID, which is allocated on first use (if the pool is full, the sensor updated
+// least recently is replaced). The instances are attached to state kept in one blob, which is
+// persisted with PersistentBlob (RAINGAUGE_USE_PREFS/LIGHTNING_USE_PREFS) as a whole. The state is
+// loaded by the first update after startup; reset() writes the cleared state immediately.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Added Lightning
+// 20261019 Added StormTracker per lightning sensor
+// 20261019 reset() writes cleared state, added constructor with BlobStorage
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef GAUGE_MANAGER_H
+#define GAUGE_MANAGER_H
+
+#include <stdint.h>
+#include <time.h>
+#include "WeatherSensorCfg.h"
+#include "WeatherSensor.h"
+#include "RainGauge.h"
+#include "Lightning.h"
+#include "StormTracker.h"
+
+#if defined(RAINGAUGE_USE_PREFS) || defined(LIGHTNING_USE_PREFS)
+    #define GAUGE_MANAGER_USE_PREFS
+#endif
+
+#if defined(GAUGE_MANAGER_USE_PREFS) || defined(INSIDE_UNITTEST)
+    // State persisted by PersistentBlob (unit tests: storage provided by the test)
+    #define GAUGE_MANAGER_PERSIST
+    #include "PersistentBlob.h"
+#endif
+
+/**
+ * Format version of the state blob in Preferences
+ */
+#define GAUGE_MANAGER_VERSION 2
+
+/**
+ * \brief State of all rain gauges and lightning sensors - persisted as one blob
+ */
+typedef struct GaugeState {
+    uint32_t sensor_id[GAUGE_MANAGER_SIZE];     //!< rain gauge sensor ID (0: unused)
+    uint32_t lightning_id[GAUGE_MANAGER_LIGHTNING]; //!< lightning sensor ID (0: unused)
+    nvData_t rain[GAUGE_MANAGER_SIZE];          //!< rain gauge state
+    nvLightning_t lightning[GAUGE_MANAGER_LIGHTNING]; //!< lightning sensor state
+} gauge_state_t;
+
+
+/**
+ * \class GaugeManager
+ *
+ * \brief Pools of RainGauge and Lightning instances keyed by sensor ID
+ */
+class GaugeManager {
+private:
+    gauge_state_t state;                        //!< state of all sensors
+    RainGauge     rain[GAUGE_MANAGER_SIZE];     //!< rain gauges (attached to state)
+    Lightning     lightning[GAUGE_MANAGER_LIGHTNING]; //!< lightning sensors (attached to state)
+    StormTracker  storms[GAUGE_MANAGER_LIGHTNING];    //!< storm trackers (RAM only)
+#if defined(GAUGE_MANAGER_USE_PREFS)
+    PrefsBlobStorage prefs;                     //!< Preferences storage
+#elif defined(GAUGE_MANAGER_PERSIST)
+    NullBlobStorage  prefs;                     //!< no storage
+#endif
+#if defined(GAUGE_MANAGER_PERSIST)
+    PersistentBlob   persist;                   //!< coalesced writes of state
+    bool             loaded;                    //!< state loaded from storage (or reset) since startup
+#endif
+
+    static int find(const uint32_t *ids, int n, uint32_t id);
+    void attachState(void);
+    void clear(void);
+    void load(void);
+    void save(uint32_t now, uint32_t weight);
+
+public:
+    /**
+     * Constructor
+     */
+    GaugeManager();
+
+#if defined(GAUGE_MANAGER_PERSIST)
+    /**
+     * Constructor with storage backend for the state (e.g. for tests)
+     *
+     * \param backend   storage backend
+     */
+    GaugeManager(BlobStorage &backend);
+#endif
+
+    /**
+     * \brief Remove all sensors
+     *
+     * The cleared state is written immediately (otherwise the next update would load
+     * the state from before the reset).
+     */
+    void reset(void);
+
+    /**
+     * \brief Route decoded frame to the rain gauge of its sensor
+     *
+     * Frames without valid rain data are ignored.
+     *
+     * \param ws            decoded weather data
+     * \param timestamp     timestamp (UTC)
+     *
+     * \returns pointer to rain gauge or nullptr if ignored
+     */
+    RainGauge *update(const weather_data_t &ws, time_t timestamp);
+
+    /**
+     * \brief Route lightning sensor data to the Lightning instance of its sensor
+     *
+     * \param id            sensor ID
+     * \param timestamp     timestamp (UTC)
+     * \param count         strike counter from sensor
+     * \param distance      distance of last strike in km
+     * \param startup       sensor startup flag
+     * \param alerts        (optional) storm tracker flags, see StormTracker::update()
+     *
+     * \returns pointer to Lightning instance or nullptr if ignored (id 0)
+     */
+    Lightning *updateLightning(uint32_t id, time_t timestamp, int16_t count, uint8_t distance,
+                               bool startup = false, uint8_t *alerts = nullptr);
+
+    /**
+     * \brief Rain gauge of sensor
+     *
+     * \param id    sensor ID
+     *
+     * \returns pointer to rain gauge or nullptr if sensor is unknown
+     */
+    RainGauge *rainGauge(uint32_t id);
+
+    /**
+     * \brief Lightning instance of sensor
+     *
+     * \param id    sensor ID
+     *
+     * \returns pointer to Lightning instance or nullptr if sensor is unknown
+     */
+    Lightning *lightningSensor(uint32_t id);
+
+    /**
+     * \brief Storm tracker of lightning sensor
+     *
+     * \param id    sensor ID
+     *
+     * \returns pointer to storm tracker or nullptr if sensor is unknown
+     */
+    StormTracker *storm(uint32_t id);
+
+    /**
+     * \brief Rainfall during past 60 minutes
+     *
+     * \param id        sensor ID
+     * \param valid     (optional) see RainGauge::pastHour(), false if sensor is unknown
+     * \param quality   (optional) see RainGauge::pastHour()
+     *
+     * \returns rainfall in mm (0 if sensor is unknown)
+     */
+    float pastHour(uint32_t id, bool *valid = nullptr, int *quality = nullptr);
+
+    /**
+     * \brief Rainfall during past window
+     *
+     * \param id        sensor ID
+     * \param minutes   window length in minutes
+     * \param valid     (optional) see RainGauge::window(), false if sensor is unknown
+     *
+     * \returns rainfall in mm (0 if sensor is unknown)
+     */
+    float window(uint32_t id, uint32_t minutes, bool *valid = nullptr);
+
+    /**
+     * \brief Rainfall of current calendar day
+     *
+     * \returns rainfall in mm or -1 if sensor is unknown
+     */
+    float currentDay(uint32_t id);
+
+    /**
+     * \brief Rainfall of current week (starting on Monday)
+     *
+     * \returns rainfall in mm or -1 if sensor is unknown
+     */
+    float currentWeek(uint32_t id);
+
+    /**
+     * \brief Rainfall of current calendar month
+     *
+     * \returns rainfall in mm or -1 if sensor is unknown
+     */
+    float currentMonth(uint32_t id);
+
+    /**
+     * \brief Lightning events during past 60 minutes
+     *
+     * \param id        sensor ID
+     * \param valid     (optional) see Lightning::pastHour(), false if sensor is unknown
+     * \param quality   (optional) see Lightning::pastHour()
+     *
+     * \returns number of events (0 if sensor is unknown)
+     */
+    int lightningPastHour(uint32_t id, bool *valid = nullptr, int *quality = nullptr);
+
+    /**
+     * \brief Number of rain gauges
+     */
+    uint8_t size(void) const;
+
+    /**
+     * \brief Write pending state changes to Preferences (e.g. before restart or deep sleep)
+     */
+    void flush(void);
+};
+
+#endif
@@ -0,0 +1,550 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HttpResponder.cpp
+//
+// HTTP responses for the local web interface - current values, recent history and metrics
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Added link statistics to /metrics
+// 20261019 Per-sensor metrics grouped by family with TYPE lines
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "HttpResponder.h"
+
+// Response phases
+#define PHASE_HEADER 0
+#define PHASE_OPEN   1
+#define PHASE_BODY   2
+#define PHASE_CLOSE  3
+#define PHASE_DONE   4
+
+
+// Append formatted text - returns false if the buffer is too small (len is not updated)
+static bool put(char *buf, size_t size, size_t &len, const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    int n = vsnprintf(buf + len, size - len, fmt, args);
+    va_end(args);
+    if ((n < 0) || ((size_t)n >= size - len)) {
+        return false;
+    }
+    len += n;
+    return true;
+}
+
+
+// Parse unsigned number (decimal or 0x... hexadecimal)
+static bool parseNum(const char *s, uint32_t &val)
+{
+    char *end;
+
+    if ((*s < '0') || (*s > '9')) {
+        return false;
+    }
+    unsigned long v = strtoul(s, &end, 0);
+    if ((*end != '\0') || (v > UINT32_MAX)) {
+        return false;
+    }
+    val = (uint32_t)v;
+    return true;
+}
+
+
+static const char *reason(uint16_t status)
+{
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        default:  return "Internal Server Error";
+    }
+}
+
+
+void
+HttpResponder::reset(void)
+{
+    memset(&counters, 0, sizeof(counters));
+}
+
+
+void
+HttpResponder::begin(const char *req, size_t len, http_cursor_t &c)
+{
+    char line[HTTP_REQUEST_LINE_SIZE];
+    size_t n = 0;
+
+    memset(&c, 0, sizeof(c));
+    c.route = HTTP_ROUTE_ERROR;
+    c.phase = PHASE_HEADER;
+    c.status = 400;
+    counters.requests++;
+
+    while ((n < len) && (req[n] != '\r') && (req[n] != '\n')) {
+        n++;
+    }
+    if (n >= sizeof(line)) {
+        counters.errors++;
+        return;
+    }
+    memcpy(line, req, n);
+    line[n] = '\0';
+
+    // Request line: <method> <target> <version>
+    char *target = strchr(line, ' ');
+    if (!target) {
+        counters.errors++;
+        return;
+    }
+    *target++ = '\0';
+    char *version = strchr(target, ' ');
+    if (version) {
+        *version = '\0';
+    }
+    if (strcmp(line, "GET") != 0) {
+        c.status = 405;
+        counters.errors++;
+        return;
+    }
+    char *query = strchr(target, '?');
+    if (query) {
+        *query++ = '\0';
+    }
+
+    c.status = 200;
+    if (strcmp(target, "/latest") == 0) {
+        c.route = HTTP_ROUTE_LATEST;
+    } else if (strcmp(target, "/metrics") == 0) {
+        c.route = HTTP_ROUTE_METRICS;
+    } else if (strcmp(target, "/history") == 0) {
+        bool valid = true;
+        bool sensor = false;
+        c.from = 0;
+        c.to = UINT32_MAX;
+        while (query && *query) {
+            char *param = query;
+            query = strchr(query, '&');
+            if (query) {
+                *query++ = '\0';
+            }
+            char *val = strchr(param, '=');
+            if (!val) {
+                valid = false;
+                break;
+            }
+            *val++ = '\0';
+            if (strcmp(param, "sensor") == 0) {
+                valid &= parseNum(val, c.id);
+                sensor = true;
+            } else if (strcmp(param, "from") == 0) {
+                valid &= parseNum(val, c.from);
+            } else if (strcmp(param, "to") == 0) {
+                valid &= parseNum(val, c.to);
+            }
+        }
+        if (valid && sensor && (c.from <= c.to)) {
+            c.route = HTTP_ROUTE_HISTORY;
+        } else {
+            c.status = 400;
+        }
+    } else {
+        c.status = 404;
+    }
+    if (c.route == HTTP_ROUTE_ERROR) {
+        counters.errors++;
+    }
+}
+
+
+bool
+HttpResponder::header(http_cursor_t &c, char *buf, size_t size, size_t &len) const
+{
+    const char *type = (c.route == HTTP_ROUTE_METRICS) ? "text/plain; version=0.0.4" : "application/json";
+
+    return put(buf, size, len,
+               "HTTP/1.1 %u %s\r\n"
+               "Content-Type: %s\r\n"
+               "Cache-Control: no-store\r\n"
+               "Connection: close\r\n"
+               "\r\n",
+               c.status, reason(c.status), type);
+}
+
+
+bool
+HttpResponder::opening(http_cursor_t &c, char *buf, size_t size, size_t &len) const
+{
+    if (c.route == HTTP_ROUTE_LATEST) {
+        return put(buf, size, len, "[");
+    }
+    if (c.route == HTTP_ROUTE_HISTORY) {
+        return put(buf, size, len, "{\"sensor_id\":%u,\"rows\":[", (unsigned)c.id);
+    }
+    if (c.route != HTTP_ROUTE_METRICS) {
+        return put(buf, size, len, "{\"error\":\"%s\"}\n", reason(c.status));
+    }
+
+    // Server counters
+    size_t start = len;
+    bool ok = put(buf, size, len,
+                  "# TYPE weather_http_requests_total counter\n"
+                  "weather_http_requests_total %u\n"
+                  "# TYPE weather_http_errors_total counter\n"
+                  "weather_http_errors_total %u\n"
+                  "# TYPE weather_http_connections_total counter\n"
+                  "weather_http_connections_total %u\n"
+                  "# TYPE weather_http_timeouts_total counter\n"
+                  "weather_http_timeouts_total %u\n"
+                  "# TYPE weather_http_active gauge\n"
+                  "weather_http_active %u\n",
+                  (unsigned)counters.requests, (unsigned)counters.errors, (unsigned)counters.connections,
+                  (unsigned)counters.timeouts, counters.active);
+    if (!ok) {
+        len = start;
+    }
+    return ok;
+}
+
+
+bool
+HttpResponder::closing(http_cursor_t &c, char *buf, size_t size, size_t &len) const
+{
+    if (c.route == HTTP_ROUTE_LATEST) {
+        return put(buf, size, len, "]\n");
+    }
+    if (c.route == HTTP_ROUTE_HISTORY) {
+        return put(buf, size, len, "]}\n");
+    }
+    if (c.route != HTTP_ROUTE_METRICS) {
+        return true;
+    }
+
+    // Table counters
+    size_t start = len;
+    bool ok = true;
+    if (sensors) {
+        ok = put(buf, size, len,
+                 "# TYPE weather_sensors gauge\n"
+                 "weather_sensors %u\n"
+                 "# TYPE weather_sensor_evictions_total counter\n"
+                 "weather_sensor_evictions_total %u\n",
+                 sensors->size(), (unsigned)sensors->evicted());
+    }
+    if (ok && store) {
+        ok = put(buf, size, len,
+                 "# TYPE weather_store_dropped_total counter\n"
+                 "weather_store_dropped_total %u\n",
+                 (unsigned)store->droppedRows());
+    }
+    if (ok && snapshots) {
+        ok = put(buf, size, len,
+                 "# TYPE weather_snapshot_retries_total counter\n"
+                 "weather_snapshot_retries_total %u\n",
+                 (unsigned)snapshots->retries());
+    }
+    if (!ok) {
+        len = start;
+    }
+    return ok;
+}
+
+
+bool
+HttpResponder::latest(http_cursor_t &c, char *buf, size_t size, size_t &len) const
+{
+    uint32_t ids[SNAPSHOT_TABLE_SIZE];
+    uint8_t n = snapshots ? snapshots->sensors(ids, SNAPSHOT_TABLE_SIZE) : 0;
+
+    for (; c.index < n; c.index++) {
+        weather_data_t ws;
+        if (!snapshots->read(ids[c.index], &ws)) {
+            continue;
+        }
+        char ts[24];
+        strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%SZ", &ws.timestamp);
+
+        size_t start = len;
+        bool ok = put(buf, size, len, "%s{\"sensor_id\":%u,\"timestamp\":\"%s\"",
+                      (c.items > 0) ? "," : "", (unsigned)ws.sensor_id, ts);
+        if (ok && ws.temp_ok) {
+            ok = put(buf, size, len, ",\"temperature\":%.1f", ws.temp_c);
+        }
+        if (ok && ws.humidity_ok) {
+            ok = put(buf, size, len, ",\"humidity\":%u", ws.humidity);
+        }
+        if (ok && ws.wind_ok) {
+            ok = put(buf, size, len, ",\"wind_speed\":%.1f,\"wind_gust\":%.1f,\"wind_direction\":%.1f",
+                     ws.wind_avg_meter_sec, ws.wind_gust_meter_sec, ws.wind_direction_deg);
+        }
+        if (ok && ws.rain_ok) {
+            ok = put(buf, size, len, ",\"rain\":%.1f,\"rain_rate\":%.1f", ws.rain_mm, ws.rain_rate);
+        }
+        if (ok && ws.light_ok) {
+            ok = put(buf, size, len, ",\"light_lux\":%.0f", ws.light_lux);
+        }
+        if (ok && ws.uv_ok) {
+            ok = put(buf, size, len, ",\"uv\":%.1f", ws.uv);
+        }
+        if (ok) {
+            ok = put(buf, size, len, ",\"battery_ok\":%s}", ws.battery_ok ? "true" : "false");
+        }
+        if (!ok) {
+            len = start;
+            return false;
+        }
+        c.items++;
+    }
+    return true;
+}
+
+
+bool
+HttpResponder::history(http_cursor_t &c, char *buf, size_t size, size_t &len) const
+{
+    packed_reading_t rows[HTTP_HISTORY_BATCH];
+
+    for (;;) {
+        size_t n = store ? store->read(c.id, c.from, c.to, rows, HTTP_HISTORY_BATCH) : 0;
+        if ((c.skip >= n) && (n == HTTP_HISTORY_BATCH)) {
+            // More rows with the same timestamp than fit into a batch - skip the rest
+            if (c.from == c.to) {
+                break;
+            }
+            c.from++;
+            c.skip = 0;
+            continue;
+        }
+        for (size_t i = c.skip; i < n; i++) {
+            const packed_reading_t &p = rows[i];
+            time_t t = p.epoch;
+            struct tm tm;
+            char ts[24];
+            gmtime_r(&t, &tm);
+            strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%SZ", &tm);
+
+            size_t start = len;
+            bool ok = put(buf, size, len, "%s{\"timestamp\":\"%s\"", (c.items > 0) ? "," : "", ts);
+            if (ok && (p.flags & PACKED_TEMP_OK)) {
+                ok = put(buf, size, len, ",\"temperature\":%.1f", p.temp_dc * 0.1f);
+            }
+            if (ok && (p.flags & PACKED_HUMIDITY_OK)) {
+                ok = put(buf, size, len, ",\"humidity\":%u", p.humidity);
+            }
+            if (ok && (p.flags & PACKED_WIND_OK)) {
+                ok = put(buf, size, len, ",\"wind_speed\":%.1f,\"wind_gust\":%.1f,\"wind_direction\":%u",
+                         p.wind_avg_dms * 0.1f, p.wind_gust_dms * 0.1f, (unsigned)p.wind_dir_deg);
+            }
+            if (ok && (p.flags & PACKED_RAIN_OK)) {
+                ok = put(buf, size, len, ",\"rain\":%.1f", p.rain_dmm * 0.1f);
+            }
+            if (ok && (p.flags & PACKED_LIGHT_OK)) {
+                ok = put(buf, size, len, ",\"light_lux\":%u", (unsigned)p.light_lux);
+            }
+            if (ok && (p.flags & PACKED_UV_OK)) {
+                ok = put(buf, size, len, ",\"uv\":%.1f", p.uv_d * 0.1f);
+            }
+            if (ok) {
+                ok = put(buf, size, len, "}");
+            }
+            if (!ok) {
+                len = start;
+                return false;
+            }
+            c.items++;
+            // Continue after this row - rows with equal timestamps are counted
+            if (p.epoch == c.from) {
+                c.skip++;
+            } else {
+                c.from = p.epoch;
+                c.skip = 1;
+            }
+        }
+        if (n < HTTP_HISTORY_BATCH) {
+            break;
+        }
+    }
+    return true;
+}
+
+
+// Per-sensor metric families - each family is sent as one group (TYPE line and all sensors)
+enum {
+    METRIC_FRAMES,
+    METRIC_PUBLISHED,
+    METRIC_LINK_RECEIVED,
+    METRIC_LINK_EXPECTED,
+    METRIC_LINK_DUPLICATES,
+    METRIC_LINK_DIGEST_ERRORS,
+    METRIC_LINK_PERIOD,
+    METRIC_RSSI,
+    METRIC_RSSI_STDDEV,
+    METRIC_STORE_ROWS,
+    METRIC_FAMILIES
+};
+
+static const struct {
+    const char *name;
+    const char *type;
+} families[METRIC_FAMILIES] = {
+    {"weather_frames_total",             "counter"},
+    {"weather_published_total",          "counter"},
+    {"weather_link_received_total",      "counter"},
+    {"weather_link_expected_total",      "counter"},
+    {"weather_link_duplicates_total",    "counter"},
+    {"weather_link_digest_errors_total", "counter"},
+    {"weather_link_period_seconds",      "gauge"},
+    {"weather_rssi_dbm",                 "gauge"},
+    {"weather_rssi_stddev_db",           "gauge"},
+    {"weather_store_rows",               "gauge"}
+};
+
+
+bool
+HttpResponder::sample(uint8_t family, const sensor_state_t &s, char *buf, size_t size, size_t &len) const
+{
+    const LinkStats &link = s.link;
+    size_t start = len;
+    bool ok = put(buf, size, len, "%s{sensor=\"%u\"} ", families[family].name, (unsigned)s.sensor_id);
+
+    if (ok) {
+        switch (family) {
+            case METRIC_FRAMES:
+                ok = put(buf, size, len, "%u\n", (unsigned)s.frames);
+                break;
+            case METRIC_PUBLISHED:
+                ok = put(buf, size, len, "%u\n", (unsigned)s.published);
+                break;
+            case METRIC_LINK_RECEIVED:
+                ok = put(buf, size, len, "%u\n", (unsigned)link.received());
+                break;
+            case METRIC_LINK_EXPECTED:
+                ok = put(buf, size, len, "%u\n", (unsigned)link.expected());
+                break;
+            case METRIC_LINK_DUPLICATES:
+                ok = put(buf, size, len, "%u\n", (unsigned)link.duplicates());
+                break;
+            case METRIC_LINK_DIGEST_ERRORS:
+                ok = put(buf, size, len, "%u\n", (unsigned)link.digestErrors());
+                break;
+            case METRIC_LINK_PERIOD:
+                ok = put(buf, size, len, "%.3f\n", link.period() * 1e-3);
+                break;
+            case METRIC_RSSI:
+                ok = put(buf, size, len, "%.1f\n", link.rssi());
+                break;
+            case METRIC_RSSI_STDDEV:
+                ok = put(buf, size, len, "%.2f\n", sqrtf(link.rssiVariance()));
+                break;
+            default:
+                ok = put(buf, size, len, "%u\n", (unsigned)store->rows(s.sensor_id));
+                break;
+        }
+    }
+    if (!ok) {
+        len = start;
+    }
+    return ok;
+}
+
+
+bool
+HttpResponder::metrics(http_cursor_t &c, char *buf, size_t size, size_t &len) const
+{
+    uint8_t n = sensors ? sensors->size() : 0;
+
+    for (; (n > 0) && (c.family < METRIC_FAMILIES); c.family++, c.index = 0) {
+        if ((c.family == METRIC_STORE_ROWS) && !store) {
+            continue;
+        }
+        if (c.index == 0) {
+            if (!put(buf, size, len, "# TYPE %s %s\n", families[c.family].name, families[c.family].type)) {
+                return false;
+            }
+            c.index = 1;
+        }
+        for (; c.index <= n; c.index++) {
+            const sensor_state_t *s = sensors->at(c.index - 1);
+            if (!s) {
+                break;
+            }
+            if (!sample(c.family, *s, buf, size, len)) {
+                return false;
+            }
+            c.items++;
+        }
+    }
+    return true;
+}
+
+
+size_t
+HttpResponder::fill(http_cursor_t &c, char *buf, size_t size) const
+{
+    size_t len = 0;
+
+    while (c.phase != PHASE_DONE) {
+        bool complete = true;
+        if (c.phase == PHASE_HEADER) {
+            complete = header(c, buf, size, len);
+        } else if (c.phase == PHASE_OPEN) {
+            complete = opening(c, buf, size, len);
+        } else if (c.phase == PHASE_CLOSE) {
+            complete = closing(c, buf, size, len);
+        } else if (c.route == HTTP_ROUTE_LATEST) {
+            complete = latest(c, buf, size, len);
+        } else if (c.route == HTTP_ROUTE_HISTORY) {
+            complete = history(c, buf, size, len);
+        } else if (c.route == HTTP_ROUTE_METRICS) {
+            complete = metrics(c, buf, size, len);
+        }
+        if (!complete) {
+            // Buffer full - the remaining items are produced by the next call
+            break;
+        }
+        c.phase++;
+    }
+    return len;
+}
@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HttpResponder.h
+//
+// HTTP responses for the local web interface - current values, recent history and metrics
+//
+// Endpoints:
+// - /latest                               latest reading of each sensor (SnapshotTable)
+// - /history?sensor=<id>&from=<t>&to=<t>  readings of one sensor in a time range (ColumnStore),
+//                                         from/to in seconds since epoch (UTC), both optional
+// - /metrics                              counters in Prometheus text format
+//
+// The responder is independent of the transport (see HttpServer). A response is produced
+// piecewise into a caller provided buffer: begin() parses the request and fill() is called
+// repeatedly whenever the buffer has been sent, until it returns 0. The position within the
+// response is kept in a small cursor, so responses of any length need neither heap memory nor
+// a buffer of their size. The body is terminated by closing the connection.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Per-sensor metrics grouped by family
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef HTTP_RESPONDER_H
+#define HTTP_RESPONDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "WeatherSensorCfg.h"
+#include "SnapshotTable.h"
+#include "ColumnStore.h"
+#include "SensorTable.h"
+
+/**
+ * Number of rows read from the ColumnStore at once
+ */
+#define HTTP_HISTORY_BATCH 8
+
+/**
+ * Maximum size of a response item (header, sensor, row) - minimum buffer size for fill()
+ */
+#define HTTP_ITEM_SIZE 1024
+
+/**
+ * Maximum length of the request line
+ */
+#define HTTP_REQUEST_LINE_SIZE 128
+
+/**
+ * \brief Request routes
+ */
+typedef enum HttpRoute {
+    HTTP_ROUTE_ERROR,       //!< error response (see status)
+    HTTP_ROUTE_LATEST,      //!< /latest
+    HTTP_ROUTE_HISTORY,     //!< /history
+    HTTP_ROUTE_METRICS      //!< /metrics
+} http_route_t;
+
+/**
+ * \brief Position within a response
+ */
+typedef struct HttpCursor {
+    uint8_t  route;         //!< http_route_t
+    uint8_t  phase;         //!< header, opening, items, closing, done
+    uint16_t status;        //!< HTTP status code
+    uint32_t id;            //!< sensor ID (history)
+    uint32_t from;          //!< start of remaining time range (history)
+    uint32_t to;            //!< end of time range (history)
+    uint16_t skip;          //!< rows at timestamp 'from' already sent (history)
+    uint16_t index;         //!< next sensor (latest), 0: TYPE line/1 + next sensor (metrics)
+    uint8_t  family;        //!< next metric family (metrics)
+    uint32_t items;         //!< number of items sent
+} http_cursor_t;
+
+/**
+ * \brief Server statistics
+ */
+typedef struct HttpStats {
+    uint32_t requests;      //!< number of requests
+    uint32_t errors;        //!< number of error responses
+    uint32_t connections;   //!< number of connections accepted
+    uint32_t timeouts;      //!< number of connections closed by timeout
+    uint8_t  active;        //!< number of open connections
+} http_stats_t;
+
+
+/**
+ * \class HttpResponder
+ *
+ * \brief Request routing and piecewise response generation
+ */
+class HttpResponder {
+private:
+    const SnapshotTable *snapshots;     //!< latest readings
+    const ColumnStore   *store;         //!< recent history
+    const SensorTable   *sensors;       //!< per-sensor statistics
+    http_stats_t        counters;       //!< server statistics
+
+    bool header(http_cursor_t &c, char *buf, size_t size, size_t &len) const;
+    bool opening(http_cursor_t &c, char *buf, size_t size, size_t &len) const;
+    bool closing(http_cursor_t &c, char *buf, size_t size, size_t &len) const;
+    bool latest(http_cursor_t &c, char *buf, size_t size, size_t &len) const;
+    bool history(http_cursor_t &c, char *buf, size_t size, size_t &len) const;
+    bool metrics(http_cursor_t &c, char *buf, size_t size, size_t &len) const;
+    bool sample(uint8_t family, const sensor_state_t &s, char *buf, size_t size, size_t &len) const;
+
+public:
+    /**
+     * \brief Constructor
+     *
+     * Data sources may be nullptr - the corresponding data are omitted.
+     *
+     * \param snapshots     latest readings
+     * \param store         recent history
+     * \param sensors       per-sensor statistics
+     */
+    HttpResponder(const SnapshotTable *snapshots, const ColumnStore *store, const SensorTable *sensors)
+        : snapshots(snapshots), store(store), sensors(sensors)
+    {
+        reset();
+    };
+
+    /**
+     * Reset statistics
+     */
+    void reset(void);
+
+    /**
+     * \brief Parse request
+     *
+     * Only the request line is evaluated.
+     *
+     * \param req       request (at least the request line), need not be terminated
+     * \param len       length of request
+     * \param c         cursor, initialized for the response
+     */
+    void begin(const char *req, size_t len, http_cursor_t &c);
+
+    /**
+     * \brief Produce next part of the response
+     *
+     * \param c         cursor
+     * \param buf       destination buffer
+     * \param size      size of destination buffer (at least HTTP_ITEM_SIZE)
+     *
+     * \returns number of bytes written, 0 if the response is complete
+     */
+    size_t fill(http_cursor_t &c, char *buf, size_t size) const;
+
+    /**
+     * \brief Server statistics - updated by the transport
+     */
+    http_stats_t &stats(void)
+    {
+        return counters;
+    };
+};
+
+#endif
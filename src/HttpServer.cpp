@@ -0,0 +1,273 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HttpServer.cpp
+//
+// Minimal HTTP/1.1 server on BSD sockets for HttpResponder
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(ESP32)
+    #include <lwip/sockets.h>
+#else
+    #include <sys/socket.h>
+    #include <sys/select.h>
+    #include <netinet/in.h>
+#endif
+#include "HttpServer.h"
+#include "Timebase.h"
+
+#ifndef MSG_NOSIGNAL
+    #define MSG_NOSIGNAL 0
+#endif
+
+
+bool
+HttpServer::begin(uint16_t port)
+{
+    struct sockaddr_in addr;
+    socklen_t addrLen = sizeof(addr);
+    int one = 1;
+
+    end();
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if ((bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) ||
+        (listen(fd, HTTP_MAX_CLIENTS * 4) < 0) ||
+        (fcntl(fd, F_SETFL, O_NONBLOCK) < 0) ||
+        (getsockname(fd, (struct sockaddr *)&addr, &addrLen) < 0)) {
+        ::close(fd);
+        return false;
+    }
+    listenFd = fd;
+    listenPort = ntohs(addr.sin_port);
+    return true;
+}
+
+
+void
+HttpServer::end(void)
+{
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        if (clients[i].fd >= 0) {
+            release(clients[i]);
+        }
+    }
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        listenFd = -1;
+    }
+    listenPort = 0;
+}
+
+
+void
+HttpServer::release(client_t &cl)
+{
+    ::close(cl.fd);
+    cl.fd = -1;
+    responder.stats().active--;
+}
+
+
+void
+HttpServer::acceptClients(int64_t now)
+{
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        client_t &cl = clients[i];
+        if (cl.fd >= 0) {
+            continue;
+        }
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        if (fcntl(fd, F_SETFL, O_NONBLOCK) < 0) {
+            ::close(fd);
+            continue;
+        }
+        cl.fd = fd;
+        cl.responding = false;
+        cl.reqLen = 0;
+        cl.outLen = 0;
+        cl.outPos = 0;
+        cl.active_us = now;
+        responder.stats().connections++;
+        responder.stats().active++;
+    }
+}
+
+
+void
+HttpServer::receiveRequest(client_t &cl, int64_t now)
+{
+    ssize_t n = recv(cl.fd, cl.req + cl.reqLen, HTTP_REQUEST_SIZE - cl.reqLen, 0);
+
+    if (n < 0) {
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+            release(cl);
+        }
+        return;
+    }
+    if (n == 0) {
+        // Closed by client before the request was complete
+        release(cl);
+        return;
+    }
+    cl.active_us = now;
+
+    // Search for the end of the header, starting before the new data
+    size_t start = (cl.reqLen > 3) ? cl.reqLen - 3 : 0;
+    cl.reqLen += n;
+    bool complete = (cl.reqLen == HTTP_REQUEST_SIZE);
+    for (size_t i = start; !complete && (i + 1 < cl.reqLen); i++) {
+        if (cl.req[i] == '\n') {
+            complete = (cl.req[i + 1] == '\n') ||
+                       ((cl.req[i + 1] == '\r') && (i + 2 < cl.reqLen) && (cl.req[i + 2] == '\n'));
+        }
+    }
+    if (!complete) {
+        return;
+    }
+
+    // Request header complete (or too large - responded with an error) - the body is ignored
+    responder.begin(cl.req, cl.reqLen, cl.cursor);
+    cl.responding = true;
+    cl.outLen = 0;
+    cl.outPos = 0;
+    sendResponse(cl, now);
+}
+
+
+void
+HttpServer::sendResponse(client_t &cl, int64_t now)
+{
+    for (;;) {
+        if (cl.outPos == cl.outLen) {
+            cl.outLen = responder.fill(cl.cursor, cl.out, HTTP_RESPONSE_SIZE);
+            cl.outPos = 0;
+            if (cl.outLen == 0) {
+                // Response complete - end of body is signalled by closing the connection
+                release(cl);
+                return;
+            }
+        }
+        ssize_t n = ::send(cl.fd, cl.out + cl.outPos, cl.outLen - cl.outPos, MSG_NOSIGNAL);
+        if (n < 0) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+                release(cl);
+            }
+            return;
+        }
+        cl.outPos += n;
+        cl.active_us = now;
+    }
+}
+
+
+int
+HttpServer::poll(uint32_t timeout_ms)
+{
+    fd_set rd;
+    fd_set wr;
+    int64_t now = timebase_mono_us();
+    int maxFd = listenFd;
+    bool slotFree = false;
+
+    if (listenFd < 0) {
+        return -1;
+    }
+    FD_ZERO(&rd);
+    FD_ZERO(&wr);
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        client_t &cl = clients[i];
+        if ((cl.fd >= 0) && (now - cl.active_us > HTTP_TIMEOUT_MS * 1000LL)) {
+            responder.stats().timeouts++;
+            release(cl);
+        }
+        if (cl.fd < 0) {
+            slotFree = true;
+            continue;
+        }
+        FD_SET(cl.fd, cl.responding ? &wr : &rd);
+        if (cl.fd > maxFd) {
+            maxFd = cl.fd;
+        }
+    }
+    // Without a free slot, new connections wait in the backlog
+    if (slotFree) {
+        FD_SET(listenFd, &rd);
+    }
+
+    struct timeval tv;
+    tv.tv_sec = timeout_ms / 1000;
+    tv.tv_usec = (timeout_ms % 1000) * 1000;
+    if (select(maxFd + 1, &rd, &wr, nullptr, &tv) <= 0) {
+        return 0;
+    }
+
+    int served = 0;
+    now = timebase_mono_us();
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        client_t &cl = clients[i];
+        if (cl.fd < 0) {
+            continue;
+        }
+        if (!cl.responding && FD_ISSET(cl.fd, &rd)) {
+            receiveRequest(cl, now);
+            served++;
+        } else if (cl.responding && FD_ISSET(cl.fd, &wr)) {
+            sendResponse(cl, now);
+            served++;
+        }
+    }
+    if (FD_ISSET(listenFd, &rd)) {
+        acceptClients(now);
+    }
+    return served;
+}
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HttpServer.h
+//
+// Minimal HTTP/1.1 server on BSD sockets for HttpResponder
+//
+// All sockets are non-blocking and served from poll() (select()), so the server runs in the
+// task which owns the data (loop()) and a slow client cannot stall it. Each client slot has a
+// fixed request and response buffer; no memory is allocated per connection or request.
+// When all slots are in use, new connections wait in the listen backlog.
+//
+// The socket API is provided by lwIP on ESP32 and by the OS on Linux, where the server is
+// built for the unit/load tests.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "WeatherSensorCfg.h"
+#include "HttpResponder.h"
+
+#if (HTTP_MAX_CLIENTS < 1) || (HTTP_RESPONSE_SIZE < HTTP_ITEM_SIZE) || (HTTP_REQUEST_SIZE > 65535) || \
+    (HTTP_RESPONSE_SIZE > 65535)
+    #error "Invalid HTTP_MAX_CLIENTS/HTTP_REQUEST_SIZE/HTTP_RESPONSE_SIZE"
+#endif
+
+
+/**
+ * \class HttpServer
+ *
+ * \brief Non-blocking HTTP server with a fixed number of client slots
+ */
+class HttpServer {
+private:
+    /**
+     * \brief Client slot
+     */
+    typedef struct Client {
+        int           fd;                           //!< socket, -1: slot free
+        bool          responding;                   //!< request complete, sending response
+        uint16_t      reqLen;                       //!< bytes received
+        uint16_t      outLen;                       //!< bytes in response buffer
+        uint16_t      outPos;                       //!< bytes of response buffer sent
+        int64_t       active_us;                    //!< time of last activity
+        http_cursor_t cursor;                       //!< response position
+        char          req[HTTP_REQUEST_SIZE];       //!< request buffer
+        char          out[HTTP_RESPONSE_SIZE];      //!< response buffer
+    } client_t;
+
+    HttpResponder &responder;                       //!< response generator
+    int      listenFd;                              //!< listening socket, -1: not started
+    uint16_t listenPort;                            //!< port
+    client_t clients[HTTP_MAX_CLIENTS];             //!< client slots
+
+    void acceptClients(int64_t now);
+    void receiveRequest(client_t &cl, int64_t now);
+    void sendResponse(client_t &cl, int64_t now);
+    void release(client_t &cl);
+
+public:
+    /**
+     * \brief Constructor
+     *
+     * \param responder     response generator
+     */
+    HttpServer(HttpResponder &responder) : responder(responder), listenFd(-1), listenPort(0)
+    {
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            clients[i].fd = -1;
+        }
+    };
+
+    ~HttpServer()
+    {
+        end();
+    };
+
+    /**
+     * \brief Start listening
+     *
+     * \param port      TCP port, 0: any free port (see port())
+     *
+     * \returns true on success
+     */
+    bool begin(uint16_t port);
+
+    /**
+     * Close all connections and stop listening
+     */
+    void end(void);
+
+    /**
+     * \brief Serve clients
+     *
+     * Waits for socket events for at most timeout_ms and handles them.
+     *
+     * \param timeout_ms    max. waiting time in ms
+     *
+     * \returns number of clients served, -1 if the server has not been started
+     */
+    int poll(uint32_t timeout_ms);
+
+    /**
+     * \brief Port the server is listening on
+     */
+    uint16_t port(void) const
+    {
+        return listenPort;
+    };
+};
+
+#endif
@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// IntervalAggregator.cpp
+//
+// Streaming per-sensor aggregation of weather data into fixed-length interval summaries
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Wind direction as vector mean (WindAggregator)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string.h>
+#include "IntervalAggregator.h"
+
+
+void
+IntervalAggregator::reset(void)
+{
+    memset(&cur, 0, sizeof(cur));
+}
+
+
+void
+IntervalAggregator::add(agg_channel_t ch, float val)
+{
+    agg_stat_t &s = cur.stat[ch];
+
+    if (s.count == 0) {
+        s.min = val;
+        s.max = val;
+    } else {
+        if (val < s.min)
+            s.min = val;
+        if (val > s.max)
+            s.max = val;
+    }
+    if (s.count < UINT16_MAX)
+        s.count++;
+    s.sum += val;
+    s.last = val;
+}
+
+
+bool
+IntervalAggregator::update(time_t timestamp, const weather_data_t &ws, float rain_delta,
+                           agg_interval_t *closed)
+{
+    uint32_t ts = (uint32_t)timestamp;
+    uint32_t start = ts - (ts % AGG_INTERVAL);
+    bool res = false;
+
+    if (cur.start != 0) {
+        if (start < cur.start)
+            return false;
+        if (start != cur.start) {
+            if (closed)
+                *closed = cur;
+            res = true;
+            reset();
+        }
+    }
+    cur.start = start;
+    if (cur.frames < UINT16_MAX)
+        cur.frames++;
+
+    if (ws.temp_ok)
+        add(AGG_TEMP, ws.temp_c);
+    if (ws.humidity_ok)
+        add(AGG_HUMIDITY, ws.humidity);
+    if (ws.wind_ok) {
+        add(AGG_WIND_SPEED, ws.wind_avg_meter_sec);
+        add(AGG_WIND_GUST, ws.wind_gust_meter_sec);
+        cur.wind.update(ws.wind_direction_deg, ws.wind_avg_meter_sec, ws.wind_gust_meter_sec);
+    }
+    if (ws.light_ok)
+        add(AGG_LIGHT, ws.light_lux);
+    if (ws.rain_ok && (rain_delta >= 0))
+        add(AGG_RAIN, rain_delta);
+
+    return res;
+}
+
+
+bool
+IntervalAggregator::poll(time_t now, agg_interval_t *closed)
+{
+    if ((cur.start == 0) || ((uint32_t)now < cur.start + AGG_INTERVAL))
+        return false;
+
+    if (closed)
+        *closed = cur;
+    reset();
+    return true;
+}
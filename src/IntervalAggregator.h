@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// IntervalAggregator.h
+//
+// Streaming per-sensor aggregation of weather data into fixed-length interval summaries
+//
+// Each interval of AGG_INTERVAL seconds (aligned to multiples of AGG_INTERVAL since the epoch)
+// keeps count, sum, minimum, maximum and last value of each measurement. Updates are O(1);
+// an interval is closed when an update crosses its end boundary and its summary is returned
+// to the caller (e.g. for publishing instead of the raw data). Intervals without any data
+// produce no summary.
+//
+// The summary corresponds to resample_data() in server/data_processor.py: mean of
+// temperature, humidity, wind speed and light, sum of rain increments. The wind direction
+// is not averaged arithmetically but as a vector (see WindAggregator).
+//
+// The object has no constructor and is valid when zero-initialized (e.g. in SensorTable).
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Wind direction as vector mean (WindAggregator)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _INTERVAL_AGGREGATOR_H
+#define _INTERVAL_AGGREGATOR_H
+
+#include <stdint.h>
+#include <time.h>
+#include "WeatherSensorCfg.h"
+#include "WeatherSensor.h"
+#include "WindAggregator.h"
+
+#if !defined(AGG_INTERVAL)
+    #define AGG_INTERVAL 300
+#endif
+
+/**
+ * \brief Aggregated measurements
+ */
+typedef enum AggChannel {
+    AGG_TEMP = 0,                       //!< temperature in degC
+    AGG_HUMIDITY,                       //!< humidity in %
+    AGG_WIND_SPEED,                     //!< wind speed (avg) in m/s
+    AGG_WIND_GUST,                      //!< wind speed (gusts) in m/s
+    AGG_LIGHT,                          //!< light in lux
+    AGG_RAIN,                           //!< rain increment in mm
+    AGG_CHANNELS
+} agg_channel_t;
+
+/**
+ * \brief Accumulator of one measurement
+ */
+typedef struct AggStat {
+    uint16_t count;                     //!< number of values
+    float    sum;                       //!< sum of values
+    float    min;                       //!< minimum
+    float    max;                       //!< maximum
+    float    last;                      //!< last value
+} agg_stat_t;
+
+/**
+ * \brief Interval summary
+ */
+typedef struct AggInterval {
+    uint32_t   start;                   //!< interval start (UTC, 0: no interval)
+    uint16_t   frames;                  //!< number of frames in interval
+    agg_stat_t stat[AGG_CHANNELS];      //!< accumulators
+    WindAggregator wind;                //!< wind direction, gusts and wind rose
+} agg_interval_t;
+
+
+/**
+ * \brief Check if measurement is available in interval
+ */
+inline bool aggValid(const agg_interval_t &iv, agg_channel_t ch)
+{
+    return iv.stat[ch].count > 0;
+}
+
+/**
+ * \brief Mean value of measurement in interval (0 if not available)
+ */
+inline float aggMean(const agg_interval_t &iv, agg_channel_t ch)
+{
+    return (iv.stat[ch].count > 0) ? iv.stat[ch].sum / iv.stat[ch].count : 0;
+}
+
+
+/**
+ * \class IntervalAggregator
+ *
+ * \brief Per-sensor interval accumulators with summaries on boundary crossing
+ */
+class IntervalAggregator {
+private:
+    agg_interval_t cur;                 //!< current interval
+
+    void add(agg_channel_t ch, float val);
+
+public:
+    /**
+     * Discard current interval
+     */
+    void reset(void);
+
+    /**
+     * \brief Add decoded frame
+     *
+     * Only measurements flagged as o.k. are added. Timestamps before the current interval
+     * are ignored.
+     *
+     * \param timestamp     timestamp (UTC)
+     * \param ws            decoded weather data
+     * \param rain_delta    rain increment since the previous frame in mm (negative: none)
+     * \param closed        summary of the closed interval (if returning true)
+     *
+     * \returns true if the frame closed the current interval
+     */
+    bool update(time_t timestamp, const weather_data_t &ws, float rain_delta, agg_interval_t *closed);
+
+    /**
+     * \brief Close current interval if its end has passed (e.g. if a sensor stopped sending)
+     *
+     * \param now           current time (UTC)
+     * \param closed        summary of the closed interval (if returning true)
+     *
+     * \returns true if the interval was closed
+     */
+    bool poll(time_t now, agg_interval_t *closed);
+
+    /**
+     * \brief Current (open) interval
+     */
+    const agg_interval_t &current(void) const
+    {
+        return cur;
+    };
+};
+
+#endif
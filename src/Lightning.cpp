@@ -0,0 +1,263 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Lightning.cpp
+//
+// Calculation of lightning events during the past 60 minutes from the lightning sensor's
+// strike counter
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Fixed reset() being undone by loading the persisted state
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <string.h>
+#include "Lightning.h"
+
+// Slot length in seconds
+#define SLOT_SECS (LIGHTNING_UPD_RATE * 60)
+
+
+void
+Lightning::clear(void)
+{
+    memset(nv, 0, sizeof(*nv));
+    hist_init();
+    windows.reset();
+}
+
+
+void
+Lightning::reset(void)
+{
+#if defined(LIGHTNING_USE_PREFS)
+    if (nv == &ownData) {
+        // Continue the sequence of the persisted slots, so the cleared state is the newest one
+        if (!loaded)
+            persist.load(nv, sizeof(*nv));
+        loaded = true;
+        clear();
+        persist.changed(0);
+        persist.flush(nv, sizeof(*nv));
+        return;
+    }
+#endif
+    clear();
+}
+
+
+void
+Lightning::attach(nvLightning_t *state)
+{
+    nv = state ? state : &ownData;
+    windows.reset();
+}
+
+
+void
+Lightning::hist_init(int16_t count)
+{
+    for (int i = 0; i < LIGHTNING_HIST_SIZE; i++) {
+        putSlot(i, count);
+    }
+    nv->histSum   = (count < 0) ? 0 : getSlot(0) * LIGHTNING_HIST_SIZE;
+    nv->histValid = (count < 0) ? 0 : LIGHTNING_HIST_SIZE;
+}
+
+
+void
+Lightning::putSlot(int idx, int32_t val)
+{
+    if (val < 0) {
+        nv->hist[idx] = LIGHTNING_SLOT_INVALID;
+    } else if (val > LIGHTNING_SLOT_MAX) {
+        log_w("Lightning history slot saturated");
+        nv->hist[idx] = LIGHTNING_SLOT_MAX;
+    } else {
+        nv->hist[idx] = val;
+    }
+}
+
+
+void
+Lightning::update(time_t timestamp, int16_t count, uint8_t distance, bool startup)
+{
+#if defined(LIGHTNING_USE_PREFS)
+    if ((nv == &ownData) && !loaded) {
+        if (!persist.load(nv, sizeof(*nv)))
+            clear();
+        loaded = true;
+    }
+#endif
+
+    if (nv->lastUpdate == 0) {
+        // First update - set baseline
+        hist_init();
+        nv->prevCount = count;
+        nv->startupPrev = startup;
+        nv->cycleEvents = 0;
+        putSlot((timestamp / SLOT_SECS) % LIGHTNING_HIST_SIZE, 0);
+        nv->histValid = 1;
+        nv->lastUpdate = (uint32_t)timestamp;
+        windows.update(timestamp, 0);
+#if defined(LIGHTNING_USE_PREFS)
+        // Baseline is written immediately
+        if (nv == &ownData) {
+            persist.changed(timestamp);
+            persist.flush(nv, sizeof(*nv));
+        }
+#endif
+        return;
+    }
+
+    if (timestamp < nv->lastUpdate) {
+        log_w("Timestamp older than last update - ignored");
+        return;
+    }
+
+    int32_t delta;
+    if (startup && !nv->startupPrev) {
+        // Sensor startup - counter restarted from zero
+        delta = count;
+    } else if (count < nv->prevCount) {
+        // Counter overflow
+        delta = LIGHTNING_COUNTER_MAX - nv->prevCount + count;
+    } else {
+        delta = count - nv->prevCount;
+    }
+    nv->startupPrev = startup;
+    nv->prevCount = count;
+
+    nv->cycleEvents = delta;
+    if (delta > 0) {
+        nv->eventTime = (uint32_t)timestamp;
+        nv->events = delta;
+        nv->eventDistance = distance;
+    }
+    windows.update(timestamp, delta);
+
+    /*
+     * History - see RainGauge::update()
+     */
+    time_t  slot     = timestamp / SLOT_SECS;
+    time_t  slotPrev = nv->lastUpdate / SLOT_SECS;
+    int     idx      = slot % LIGHTNING_HIST_SIZE;
+
+    if (slot == slotPrev) {
+        // Same slot as in previous update - add
+        int32_t val = getSlot(idx);
+        putSlot(idx, (val < 0) ? delta : val + delta);
+        if (val < 0) {
+            nv->histValid++;
+        } else {
+            nv->histSum -= val;
+        }
+        nv->histSum += getSlot(idx);
+    } else if (slot - slotPrev >= LIGHTNING_HIST_SIZE) {
+        // All slots of the past hour are new
+        // If the time span of the events exceeds one hour, they cannot be assigned to a slot
+        int32_t val = delta;
+        if (timestamp - nv->lastUpdate >= LIGHTNING_HIST_SIZE * SLOT_SECS) {
+            log_d("History time frame expired, resetting!");
+            val = -1;
+        }
+        for (int i = 0; i < LIGHTNING_HIST_SIZE; i++) {
+            putSlot(i, -1);
+        }
+        putSlot(idx, val);
+        nv->histSum   = (val < 0) ? 0 : getSlot(idx);
+        nv->histValid = (val < 0) ? 0 : 1;
+    } else {
+        // Advance slot by slot - the slot leaving the past hour is subtracted from the
+        // running sum, the slot entering it is written (skipped slots: invalid)
+        for (time_t k = slotPrev + 1; k <= slot; k++) {
+            int i = k % LIGHTNING_HIST_SIZE;
+            int32_t old = getSlot(i);
+            if (old >= 0) {
+                nv->histSum -= old;
+                nv->histValid--;
+            }
+            putSlot(i, (k == slot) ? delta : -1);
+        }
+        nv->histSum += getSlot(idx);
+        nv->histValid++;
+    }
+
+    nv->lastUpdate = (uint32_t)timestamp;
+
+#if defined(LIGHTNING_USE_PREFS)
+    if (nv == &ownData) {
+        persist.changed(timestamp, delta);
+        persist.poll(nv, sizeof(*nv), timestamp);
+    }
+#endif
+}
+
+
+int
+Lightning::pastHour(bool *valid, int *quality)
+{
+    if (valid) {
+        *valid = nv->histValid >= qualityThreshold;
+    }
+    if (quality) {
+        *quality = nv->histValid;
+    }
+    return nv->histSum;
+}
+
+
+bool
+Lightning::lastEvent(time_t &timestamp, int &events, uint8_t &distance)
+{
+    if (nv->lastUpdate == 0)
+        return false;
+
+    timestamp = nv->eventTime;
+    events = nv->events;
+    distance = nv->eventDistance;
+    return true;
+}
+
+
+int
+Lightning::lastCycle(void)
+{
+    if (nv->lastUpdate == 0)
+        return -1;
+
+    return nv->cycleEvents;
+}
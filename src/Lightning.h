@@ -0,0 +1,256 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Lightning.h
+//
+// Calculation of lightning events during the past 60 minutes from the lightning sensor's
+// strike counter
+//
+// The counter overflows at LIGHTNING_COUNTER_MAX; a sensor startup restarts it from zero.
+// Both are compensated when calculating the number of events since the previous update.
+//
+// Past 60 minutes:
+// The hour is divided into LIGHTNING_HIST_SIZE slots of LIGHTNING_UPD_RATE minutes,
+// numbered by timestamp / slot length. Each update adds its events to the slot of its
+// timestamp; slots skipped since the previous update are marked invalid. The sum of the
+// valid slots within the past hour and their number are maintained incrementally when slots
+// enter or leave the hour, so pastHour() is O(1).
+//
+// Events during arbitrary windows up to one week are provided by window() from
+// RollingWindows (kept in RAM only).
+//
+// The state (44 bytes) can be kept in RTC RAM. With LIGHTNING_USE_PREFS, it is written to
+// Preferences by PersistentBlob.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 reset() writes cleared state
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _LIGHTNING_H
+#define _LIGHTNING_H
+
+#include <stdint.h>
+#include <time.h>
+#include "WeatherSensorCfg.h"
+#include "RollingWindows.h"
+
+#if defined(LIGHTNING_USE_PREFS)
+    #include "PersistentBlob.h"
+#endif
+
+/**
+ * Lightning sensor counter overflow value
+ */
+#define LIGHTNING_COUNTER_MAX 1600
+
+/**
+ * Slot length for past 60 minutes events (minutes)
+ */
+#define LIGHTNING_UPD_RATE 6
+
+/**
+ * Number of slots for past 60 minutes events
+ */
+#define LIGHTNING_HIST_SIZE 10
+
+/**
+ * Minimum number of valid slots for a valid past 60 minutes events count
+ */
+#define LIGHTNING_QUALITY_THRESHOLD 8
+
+#define LIGHTNING_SLOT_MAX     0xFFFE   //!< max. slot value - larger values saturate
+#define LIGHTNING_SLOT_INVALID 0xFFFF   //!< no valid value
+
+/**
+ * Format version of the state in Preferences
+ */
+#define LIGHTNING_NV_VERSION 1
+
+
+/**
+ * \brief Lightning state - can be kept in RTC RAM or saved in non-volatile memory
+ */
+typedef struct LightningData {
+    uint32_t lastUpdate;                        //!< timestamp of last update (0: no update yet)
+    uint32_t eventTime;                         //!< timestamp of last update with events
+    int32_t  histSum;                           //!< sum of valid slots in past hour
+    uint16_t prevCount;                         //!< counter value of last update
+    uint16_t events;                            //!< events in last update with events
+    uint16_t cycleEvents;                       //!< events in last update
+    uint16_t hist[LIGHTNING_HIST_SIZE];         //!< events per slot
+    uint8_t  eventDistance;                     //!< distance in km of last update with events
+    uint8_t  histValid;                         //!< number of valid slots in past hour
+    bool     startupPrev;                       //!< startup flag of last update
+} nvLightning_t;
+
+
+/**
+ * \class Lightning
+ *
+ * \brief Calculation of lightning events during the past 60 minutes
+ */
+class Lightning {
+private:
+    nvLightning_t ownData;      //!< lightning state (unless attached to external state)
+    nvLightning_t *nv;          //!< lightning state in use
+    uint8_t  qualityThreshold;  //!< minimum number of valid slots for valid pastHour()
+    RollingWindows windows;     //!< events for window()
+#if defined(LIGHTNING_USE_PREFS)
+    PrefsBlobStorage prefs;     //!< Preferences storage
+    PersistentBlob persist;     //!< coalesced writes of own state
+    bool     loaded;            //!< own state loaded from Preferences (or reset) since startup
+#endif
+
+    void clear(void);
+    void putSlot(int idx, int32_t val);
+
+    int32_t getSlot(int idx) const
+    {
+        return (nv->hist[idx] == LIGHTNING_SLOT_INVALID) ? -1 : nv->hist[idx];
+    };
+
+public:
+    /**
+     * Constructor
+     *
+     * \param quality_threshold minimum number of valid slots for valid past 60 minutes events
+     */
+    Lightning(const uint8_t quality_threshold = LIGHTNING_QUALITY_THRESHOLD) :
+        qualityThreshold(quality_threshold)
+#if defined(LIGHTNING_USE_PREFS)
+        , prefs("BWS-LGT"),
+        persist(prefs, LIGHTNING_NV_VERSION)
+#endif
+    {
+        nv = &ownData;
+#if defined(LIGHTNING_USE_PREFS)
+        loaded = false;
+#endif
+        clear();
+    };
+
+    /**
+     * \brief Use external state (e.g. owned by GaugeManager)
+     *
+     * The owner of external state is responsible for its persistence.
+     * The state is not modified - call reset() for a new sensor.
+     *
+     * \param state     external state or nullptr for own state
+     */
+    void attach(nvLightning_t *state);
+
+    /**
+     * \brief Reset all lightning data
+     *
+     * With LIGHTNING_USE_PREFS, the cleared own state is written immediately.
+     */
+    void reset(void);
+
+    /**
+     * \brief Initialize history buffer
+     *
+     * \param count     initial value of all slots (-1: invalid)
+     */
+    void hist_init(int16_t count = -1);
+
+    /**
+     * \brief Update lightning data
+     *
+     * Updates with a timestamp older than the previous one are ignored.
+     *
+     * \param timestamp     timestamp
+     * \param count         strike counter from sensor
+     * \param distance      distance of last strike in km
+     * \param startup       sensor startup flag
+     */
+    void update(time_t timestamp, int16_t count, uint8_t distance, bool startup = false);
+
+    /**
+     * \brief Number of events during past 60 minutes
+     *
+     * \param valid     (optional) set to true if number of valid slots >= quality threshold
+     * \param quality   (optional) number of valid slots
+     *
+     * \returns number of events
+     */
+    int pastHour(bool *valid = nullptr, int *quality = nullptr);
+
+    /**
+     * \brief Number of events during past window (O(1))
+     *
+     * \param minutes   window length in minutes (max. ROLLING_MAX_WINDOW / 60)
+     * \param valid     (optional) see RainGauge::window()
+     *
+     * \returns number of events up to last update
+     */
+    int window(uint32_t minutes, bool *valid = nullptr)
+    {
+        return windows.sum(minutes * 60, valid);
+    };
+
+    /**
+     * \brief Last update with events
+     *
+     * \param timestamp     timestamp of last update with events
+     * \param events        number of events in that update
+     * \param distance      distance in km
+     *
+     * \returns false if no update has been done yet
+     */
+    bool lastEvent(time_t &timestamp, int &events, uint8_t &distance);
+
+    /**
+     * \brief Number of events in last update
+     *
+     * \returns number of events or -1 if no update has been done yet
+     */
+    int lastCycle(void);
+
+    /**
+     * \brief Write pending state changes to Preferences (e.g. before restart or deep sleep)
+     *
+     * Without LIGHTNING_USE_PREFS or with external state, nothing is done.
+     */
+    void flush(void)
+    {
+#if defined(LIGHTNING_USE_PREFS)
+        if (nv == &ownData)
+            persist.flush(nv, sizeof(*nv));
+#endif
+    };
+};
+
+#endif
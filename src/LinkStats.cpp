@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// LinkStats.cpp
+//
+// Per-sensor radio link statistics - RSSI, frame loss, duplicates and digest errors
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string.h>
+#include "LinkStats.h"
+
+
+void
+LinkStats::reset(void)
+{
+    memset(this, 0, sizeof(LinkStats));
+}
+
+
+uint32_t
+LinkStats::hash(const uint8_t *data, size_t len)
+{
+    uint32_t h = 2166136261UL;
+
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+
+bool
+LinkStats::update(int64_t mono_us, float rssi, uint32_t hash)
+{
+    if (nReceived == 0) {
+        nReceived = 1;
+        nExpected = 1;
+        lastUs = mono_us;
+        lastHash = hash;
+        rssiMean = rssi;
+        rssiM2 = 0;
+        rssiMin = rssi;
+        rssiMax = rssi;
+        return false;
+    }
+
+    int64_t dt_ms = (mono_us - lastUs) / 1000;
+    if ((hash == lastHash) && (dt_ms < LINK_DUP_WINDOW_MS)) {
+        nDuplicates++;
+        return true;
+    }
+    uint32_t dt = (dt_ms > 0) ? ((dt_ms < UINT32_MAX) ? (uint32_t)dt_ms : UINT32_MAX) : 0;
+    lastUs = mono_us;
+    lastHash = hash;
+
+    // Expected frames and transmit period
+    if ((dt >= LINK_MIN_PERIOD_MS) && ((periodMs == 0) || (dt < periodMs - periodMs / LINK_PERIOD_TOLERANCE))) {
+        // First estimate, or the previous one spanned lost frames - these are counted now
+        if (periodMs != 0) {
+            nExpected += (periodMs + dt / 2) / dt - 1;
+        }
+        periodMs = dt;
+        nExpected++;
+    } else if (periodMs == 0) {
+        nExpected++;
+    } else {
+        uint32_t k = (dt + periodMs / 2) / periodMs;
+        if (k == 0) {
+            k = 1;
+        }
+        int64_t dev = (int64_t)dt - (int64_t)k * periodMs;
+        if (((dev < 0) ? -dev : dev) < periodMs / LINK_PERIOD_TOLERANCE) {
+            int32_t err = (int32_t)(dt / k) - (int32_t)periodMs;
+            periodMs += err / LINK_PERIOD_SMOOTHING;
+        }
+        nExpected += k;
+    }
+    nReceived++;
+
+    // RSSI - Welford's algorithm
+    float delta = rssi - rssiMean;
+    rssiMean += delta / nReceived;
+    rssiM2 += delta * (rssi - rssiMean);
+    if (rssi < rssiMin) {
+        rssiMin = rssi;
+    }
+    if (rssi > rssiMax) {
+        rssiMax = rssi;
+    }
+    return false;
+}
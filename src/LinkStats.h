@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// LinkStats.h
+//
+// Per-sensor radio link statistics - RSSI, frame loss, duplicates and digest errors
+//
+// - RSSI mean and variance are updated with Welford's algorithm (numerically stable, O(1)).
+// - The transmit period is learned from the intervals between frames: the first interval is
+//   taken as estimate, a shorter one replaces it (the previous one contained lost frames, which
+//   are added to the expected frames) and intervals close to a multiple k of the estimate
+//   refine it with an exponential moving average of interval / k.
+// - Each interval accounts for k expected frames, so the number of lost frames is the
+//   difference between expected and received frames.
+// - A frame with the same payload as the previous one within LINK_DUP_WINDOW_MS is a
+//   duplicate (e.g. repeated transmission) and not counted as received.
+//
+// The state is valid when zero-initialized, so it can be kept in SensorTable entries.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef LINK_STATS_H
+#define LINK_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Frames with the same payload within this time (ms) are duplicates
+ */
+#define LINK_DUP_WINDOW_MS 2000
+
+/**
+ * Shorter intervals (ms) are not used for learning the transmit period
+ */
+#define LINK_MIN_PERIOD_MS 4000
+
+/**
+ * An interval matches k periods if it deviates by less than period / LINK_PERIOD_TOLERANCE
+ */
+#define LINK_PERIOD_TOLERANCE 5
+
+/**
+ * Weight of a new interval in the period estimate (1 / LINK_PERIOD_SMOOTHING)
+ */
+#define LINK_PERIOD_SMOOTHING 8
+
+
+/**
+ * \class LinkStats
+ *
+ * \brief Streaming link statistics of one sensor
+ */
+class LinkStats {
+private:
+    int64_t  lastUs;        //!< monotonic time of last frame in us
+    uint32_t lastHash;      //!< payload hash of last frame
+    uint32_t periodMs;      //!< learned transmit period in ms (0: unknown)
+    uint32_t nReceived;     //!< number of frames received (without duplicates)
+    uint32_t nExpected;     //!< number of frames expected from the learned period
+    uint32_t nDuplicates;   //!< number of duplicate frames
+    uint32_t nDigest;       //!< number of frames with digest error
+    float    rssiMean;      //!< RSSI mean in dBm
+    float    rssiM2;        //!< sum of squared RSSI deviations (Welford)
+    float    rssiMin;       //!< RSSI minimum in dBm
+    float    rssiMax;       //!< RSSI maximum in dBm
+
+public:
+    /**
+     * Discard statistics
+     */
+    void reset(void);
+
+    /**
+     * \brief Update with a valid frame
+     *
+     * \param mono_us   monotonic time of reception in us
+     * \param rssi      RSSI in dBm
+     * \param hash      payload hash (see hash())
+     *
+     * \returns true if the frame is a duplicate
+     */
+    bool update(int64_t mono_us, float rssi, uint32_t hash);
+
+    /**
+     * \brief Count frame with digest error
+     */
+    void digestError(void)
+    {
+        nDigest++;
+    };
+
+    /**
+     * \brief Payload hash for duplicate detection (FNV-1a)
+     */
+    static uint32_t hash(const uint8_t *data, size_t len);
+
+    /**
+     * \brief Number of frames received (without duplicates)
+     */
+    uint32_t received(void) const
+    {
+        return nReceived;
+    };
+
+    /**
+     * \brief Number of frames expected since the first frame
+     */
+    uint32_t expected(void) const
+    {
+        return nExpected;
+    };
+
+    /**
+     * \brief Number of frames lost
+     */
+    uint32_t lost(void) const
+    {
+        return (nExpected > nReceived) ? nExpected - nReceived : 0;
+    };
+
+    /**
+     * \brief Number of duplicate frames
+     */
+    uint32_t duplicates(void) const
+    {
+        return nDuplicates;
+    };
+
+    /**
+     * \brief Number of frames with digest error
+     */
+    uint32_t digestErrors(void) const
+    {
+        return nDigest;
+    };
+
+    /**
+     * \brief Learned transmit period in ms (0: unknown)
+     */
+    uint32_t period(void) const
+    {
+        return periodMs;
+    };
+
+    /**
+     * \brief Monotonic time of last frame in us (0: none)
+     */
+    int64_t lastSeen(void) const
+    {
+        return lastUs;
+    };
+
+    /**
+     * \brief RSSI mean in dBm
+     */
+    float rssi(void) const
+    {
+        return rssiMean;
+    };
+
+    /**
+     * \brief RSSI minimum in dBm
+     */
+    float rssiMinimum(void) const
+    {
+        return rssiMin;
+    };
+
+    /**
+     * \brief RSSI maximum in dBm
+     */
+    float rssiMaximum(void) const
+    {
+        return rssiMax;
+    };
+
+    /**
+     * \brief RSSI sample variance in dB^2 (0 with less than two frames)
+     */
+    float rssiVariance(void) const
+    {
+        return (nReceived > 1) ? rssiM2 / (nReceived - 1) : 0;
+    };
+};
+
+#endif
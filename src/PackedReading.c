@@ -0,0 +1,123 @@
+#include "PackedReading.h"
+#include <string.h>
+#include <math.h>
+
+// Compile-time check of packed record size
+typedef char packed_reading_size_check[(sizeof(packed_reading_t) == 24) ? 1 : -1];
+
+//
+// Calendar conversions based on Howard Hinnant's days_from_civil()/civil_from_days()
+// http://howardhinnant.github.io/date_algorithms.html
+//
+static int64_t days_from_civil(int64_t y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = (unsigned)(y - era * 400);
+    unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+int64_t utcToEpoch(const struct tm *t)
+{
+    int64_t days = days_from_civil(t->tm_year + 1900LL, t->tm_mon + 1, t->tm_mday);
+    return days * 86400 + t->tm_hour * 3600 + t->tm_min * 60 + t->tm_sec;
+}
+
+void epochToUtc(int64_t epoch, struct tm *t)
+{
+    int64_t days = (epoch >= 0 ? epoch : epoch - 86399) / 86400;
+    int64_t secs = epoch - days * 86400;
+
+    int64_t z = days + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned doe = (unsigned)(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    unsigned d = doy - (153 * mp + 2) / 5 + 1;
+    unsigned m = mp < 10 ? mp + 3 : mp - 9;
+    int64_t y = (int64_t)yoe + era * 400 + (m <= 2);
+
+    memset(t, 0, sizeof(struct tm));
+    t->tm_year = (int)(y - 1900);
+    t->tm_mon  = m - 1;
+    t->tm_mday = d;
+    t->tm_hour = (int)(secs / 3600);
+    t->tm_min  = (int)(secs / 60 % 60);
+    t->tm_sec  = (int)(secs % 60);
+    t->tm_wday = (int)((days % 7 + 11) % 7); // 1970-01-01 was a Thursday
+    t->tm_yday = (int)(days - days_from_civil(y, 1, 1));
+}
+
+// Round to nearest integer and saturate to [lo, hi]
+static int32_t fixed(float val, float scale, int32_t lo, int32_t hi)
+{
+    long res = lroundf(val * scale);
+    if (res < lo)
+        return lo;
+    if (res > hi)
+        return hi;
+    return (int32_t)res;
+}
+
+void packReading(const weather_data_t *ws, packed_reading_t *p)
+{
+    memset(p, 0, sizeof(packed_reading_t));
+
+    p->epoch         = (uint32_t)utcToEpoch(&ws->timestamp);
+    p->sensor_id     = ws->sensor_id;
+    p->temp_dc       = (int16_t)fixed(ws->temp_c, 10.0f, INT16_MIN, INT16_MAX);
+    p->humidity      = ws->humidity;
+    p->s_type        = ws->s_type;
+    p->chan          = ws->chan;
+    p->wind_dir_deg  = fixed(ws->wind_direction_deg, 1.0f, 0, 1023);
+    p->wind_gust_dms = fixed(ws->wind_gust_meter_sec, 10.0f, 0, 1023);
+    p->wind_avg_dms  = fixed(ws->wind_avg_meter_sec, 10.0f, 0, 1023);
+    p->rain_dmm      = fixed(ws->rain_mm, 10.0f, 0, 0xFFFFF);
+    p->uv_d          = fixed(ws->uv, 10.0f, 0, 1023);
+    p->light_lux     = fixed(ws->light_lux, 1.0f, 0, 0xFFFFF);
+
+    p->flags = (ws->temp_ok     ? PACKED_TEMP_OK     : 0) |
+               (ws->humidity_ok ? PACKED_HUMIDITY_OK : 0) |
+               (ws->light_ok    ? PACKED_LIGHT_OK    : 0) |
+               (ws->uv_ok       ? PACKED_UV_OK       : 0) |
+               (ws->wind_ok     ? PACKED_WIND_OK     : 0) |
+               (ws->rain_ok     ? PACKED_RAIN_OK     : 0) |
+               (ws->battery_ok  ? PACKED_BATTERY_OK  : 0) |
+               (ws->valid       ? PACKED_VALID       : 0) |
+               (ws->complete    ? PACKED_COMPLETE    : 0) |
+               (ws->startup     ? PACKED_STARTUP     : 0);
+}
+
+void unpackReading(const packed_reading_t *p, weather_data_t *ws)
+{
+    memset(ws, 0, sizeof(weather_data_t));
+
+    epochToUtc(p->epoch, &ws->timestamp);
+    ws->sensor_id           = p->sensor_id;
+    // Same expressions as in decoderPayload() - yields identical float values
+    ws->temp_c              = p->temp_dc * 0.1f;
+    ws->humidity            = p->humidity;
+    ws->s_type              = p->s_type;
+    ws->chan                = p->chan;
+    ws->wind_direction_deg  = p->wind_dir_deg * 1.0f;
+    ws->wind_gust_meter_sec = p->wind_gust_dms * 0.1f;
+    ws->wind_avg_meter_sec  = p->wind_avg_dms * 0.1f;
+    ws->rain_mm             = p->rain_dmm * 0.1f;
+    ws->uv                  = p->uv_d * 0.1f;
+    ws->light_lux           = p->light_lux;
+    ws->light_klx           = p->light_lux * 0.001f;
+
+    ws->temp_ok     = (p->flags & PACKED_TEMP_OK) != 0;
+    ws->humidity_ok = (p->flags & PACKED_HUMIDITY_OK) != 0;
+    ws->light_ok    = (p->flags & PACKED_LIGHT_OK) != 0;
+    ws->uv_ok       = (p->flags & PACKED_UV_OK) != 0;
+    ws->wind_ok     = (p->flags & PACKED_WIND_OK) != 0;
+    ws->rain_ok     = (p->flags & PACKED_RAIN_OK) != 0;
+    ws->battery_ok  = (p->flags & PACKED_BATTERY_OK) != 0;
+    ws->valid       = (p->flags & PACKED_VALID) != 0;
+    ws->complete    = (p->flags & PACKED_COMPLETE) != 0;
+    ws->startup     = (p->flags & PACKED_STARTUP) != 0;
+}
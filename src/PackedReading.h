@@ -0,0 +1,82 @@
+#ifndef PACKEDREADING_H
+#define PACKEDREADING_H
+
+#include "WeatherSensor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Flags in PackedReading::flags
+ */
+#define PACKED_TEMP_OK      0x001   //!< temperature o.k.
+#define PACKED_HUMIDITY_OK  0x002   //!< humidity o.k.
+#define PACKED_LIGHT_OK     0x004   //!< light o.k.
+#define PACKED_UV_OK        0x008   //!< uv radiation o.k.
+#define PACKED_WIND_OK      0x010   //!< wind speed/direction o.k.
+#define PACKED_RAIN_OK      0x020   //!< rain gauge level o.k.
+#define PACKED_BATTERY_OK   0x040   //!< battery status
+#define PACKED_VALID        0x080   //!< valid data
+#define PACKED_COMPLETE     0x100   //!< complete data
+#define PACKED_STARTUP      0x200   //!< startup flag
+
+/**
+ * @brief Compact representation of WeatherData (24 bytes)
+ *
+ * All values are stored in the sensor's native fixed-point resolution, so the
+ * conversion from/to weather_data_t is lossless for the decoded values.
+ * delta_t and delta_rain are derived per publication and are not stored;
+ * light_klx is restored from light_lux.
+ */
+typedef struct PackedReading {
+    uint32_t epoch;                 //!< timestamp (UTC) in seconds since epoch
+    uint32_t sensor_id;             //!< sensor ID
+    int16_t  temp_dc;               //!< temperature in 0.1 degC
+    uint8_t  humidity;              //!< humidity in %
+    uint8_t  s_type : 4;            //!< sensor type
+    uint8_t  chan   : 4;            //!< channel
+    uint32_t wind_dir_deg   : 10;   //!< wind direction in deg
+    uint32_t wind_gust_dms  : 10;   //!< wind speed (gusts) in 0.1 m/s
+    uint32_t wind_avg_dms   : 10;   //!< wind speed (avg) in 0.1 m/s
+    uint32_t                : 2;
+    uint32_t rain_dmm       : 20;   //!< rain gauge level in 0.1 mm
+    uint32_t uv_d           : 10;   //!< uv radiation in 0.1
+    uint32_t                : 2;
+    uint32_t light_lux      : 20;   //!< light in lux
+    uint32_t flags          : 12;   //!< PACKED_* flags
+} packed_reading_t;
+
+/**
+ * @brief Convert WeatherData to packed representation
+ * @param ws Pointer to WeatherData structure (timestamp in UTC)
+ * @param p Pointer to PackedReading structure
+ */
+void packReading(const weather_data_t *ws, packed_reading_t *p);
+
+/**
+ * @brief Convert packed representation to WeatherData
+ * @param p Pointer to PackedReading structure
+ * @param ws Pointer to WeatherData structure (timestamp in UTC; delta_t and delta_rain are set to 0)
+ */
+void unpackReading(const packed_reading_t *p, weather_data_t *ws);
+
+/**
+ * @brief Convert broken-down UTC time to seconds since epoch (timegm() replacement)
+ * @param t Pointer to struct tm (UTC)
+ * @return seconds since epoch
+ */
+int64_t utcToEpoch(const struct tm *t);
+
+/**
+ * @brief Convert seconds since epoch to broken-down UTC time (gmtime_r() replacement)
+ * @param epoch seconds since epoch
+ * @param t Pointer to struct tm (UTC)
+ */
+void epochToUtc(int64_t epoch, struct tm *t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PACKEDREADING_H */
@@ -0,0 +1,209 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PersistentBlob.cpp
+//
+// Write-coalescing, CRC-protected persistence of a state blob in two alternating slots
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include "PersistentBlob.h"
+
+static const char *headerKeys[2] = {"h0", "h1"};
+static const char *dataKeys[2]   = {"d0", "d1"};
+
+
+uint32_t
+crc32(uint32_t crc, const void *buf, size_t len)
+{
+    // Nibble table - small enough for flash, fast enough for a few hundred bytes
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    const uint8_t *p = (const uint8_t *)buf;
+
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+
+#if defined(RAINGAUGE_USE_PREFS) || defined(LIGHTNING_USE_PREFS)
+size_t
+PrefsBlobStorage::read(const char *key, void *buf, size_t len)
+{
+    Preferences preferences;
+
+    preferences.begin(ns, true);
+    size_t res = preferences.getBytes(key, buf, len);
+    preferences.end();
+    return res;
+}
+
+
+bool
+PrefsBlobStorage::write(const char *key, const void *buf, size_t len)
+{
+    Preferences preferences;
+
+    preferences.begin(ns, false);
+    size_t res = preferences.putBytes(key, buf, len);
+    preferences.end();
+    return res == len;
+}
+#endif
+
+
+uint32_t
+PersistentBlob::headerCrc(const persist_header_t &hdr, const void *data)
+{
+    uint32_t crc = crc32(0, &hdr.seq, sizeof(hdr.seq));
+    crc = crc32(crc, &hdr.version, sizeof(hdr.version));
+    crc = crc32(crc, &hdr.length, sizeof(hdr.length));
+    return crc32(crc, data, hdr.length);
+}
+
+
+bool
+PersistentBlob::readSlot(int slot, persist_header_t &hdr, void *data, size_t len)
+{
+    if (storage.read(headerKeys[slot], &hdr, sizeof(hdr)) != sizeof(hdr))
+        return false;
+    if ((hdr.magic != PERSIST_MAGIC) || (hdr.version != version) || (hdr.length != len))
+        return false;
+    if (storage.read(dataKeys[slot], data, len) != len)
+        return false;
+    return headerCrc(hdr, data) == hdr.crc;
+}
+
+
+bool
+PersistentBlob::load(void *data, size_t len)
+{
+    persist_header_t hdr;
+    bool found = false;
+
+    // Find slot with highest sequence number
+    int newest = -1;
+    uint32_t newestSeq = 0;
+    for (int slot = 0; slot < 2; slot++) {
+        if (storage.read(headerKeys[slot], &hdr, sizeof(hdr)) != sizeof(hdr))
+            continue;
+        if ((hdr.magic != PERSIST_MAGIC) || (hdr.version != version) || (hdr.length != len))
+            continue;
+        if ((newest < 0) || ((int32_t)(hdr.seq - newestSeq) > 0)) {
+            newest = slot;
+            newestSeq = hdr.seq;
+        }
+    }
+    if (newest < 0)
+        return false;
+
+    // Try newest slot first, fall back to the other one (interrupted write)
+    for (int i = 0; i < 2; i++) {
+        int slot = newest ^ i;
+        if (readSlot(slot, hdr, data, len)) {
+            seq = hdr.seq;
+            found = true;
+            break;
+        }
+        log_w("Slot %d invalid", slot);
+    }
+    isDirty = false;
+    weight = 0;
+    return found;
+}
+
+
+void
+PersistentBlob::changed(uint32_t now, uint32_t w)
+{
+    if (!isDirty) {
+        // Time since the last write is counted from the first change
+        if (writes == 0)
+            lastWrite = now;
+        isDirty = true;
+    }
+    weight += w;
+}
+
+
+bool
+PersistentBlob::poll(const void *data, size_t len, uint32_t now)
+{
+    if (!isDirty)
+        return false;
+    if ((weight < delta) && (now - lastWrite < interval))
+        return false;
+    if (!flush(data, len))
+        return false;
+    lastWrite = now;
+    return true;
+}
+
+
+bool
+PersistentBlob::flush(const void *data, size_t len)
+{
+    if (!isDirty)
+        return false;
+
+    persist_header_t hdr;
+    hdr.magic   = PERSIST_MAGIC;
+    hdr.seq     = seq + 1;
+    hdr.version = version;
+    hdr.length  = (uint16_t)len;
+    hdr.crc     = headerCrc(hdr, data);
+
+    // Odd sequence numbers go to slot 1, even ones to slot 0 - the newest slot is never overwritten
+    int slot = hdr.seq & 1;
+    if (!storage.write(dataKeys[slot], data, len) || !storage.write(headerKeys[slot], &hdr, sizeof(hdr))) {
+        log_e("Writing slot %d failed", slot);
+        return false;
+    }
+    seq = hdr.seq;
+    writes++;
+    weight = 0;
+    isDirty = false;
+    return true;
+}
@@ -0,0 +1,256 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PersistentBlob.h
+//
+// Write-coalescing, CRC-protected persistence of a state blob in two alternating slots
+//
+// The owner keeps its state in RAM and reports changes with changed(); poll() writes the
+// state only if it has changed and either PERSIST_INTERVAL seconds have elapsed since the
+// last write or the accumulated change weight has reached PERSIST_DELTA. flush() writes
+// pending changes immediately (e.g. from a shutdown handler).
+//
+// Each write goes to the older of two slots. A slot consists of a data record and a header
+// record (magic, sequence number, version, length, CRC-32 over header fields and data); the
+// header is written last. load() uses the valid slot with the highest sequence number, so an
+// interrupted write is never observed - the previous slot remains valid.
+//
+// The storage is accessed via BlobStorage (key/value records like Preferences).
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Added NullBlobStorage
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef PERSISTENT_BLOB_H
+#define PERSISTENT_BLOB_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "WeatherSensorCfg.h"
+
+#if defined(RAINGAUGE_USE_PREFS) || defined(LIGHTNING_USE_PREFS)
+    #include <Preferences.h>
+#endif
+
+#define PERSIST_MAGIC 0x42575331UL // "BWS1"
+
+/**
+ * \brief Slot header
+ */
+typedef struct PersistHeader {
+    uint32_t magic;     //!< PERSIST_MAGIC
+    uint32_t seq;       //!< sequence number
+    uint16_t version;   //!< data format version
+    uint16_t length;    //!< data length in bytes
+    uint32_t crc;       //!< CRC-32 over seq, version, length and data
+} persist_header_t;
+
+
+/**
+ * \class BlobStorage
+ *
+ * \brief Key/value storage of binary records
+ */
+class BlobStorage {
+public:
+    virtual ~BlobStorage() {};
+
+    /**
+     * \brief Read record
+     *
+     * \returns number of bytes read (0 if not found)
+     */
+    virtual size_t read(const char *key, void *buf, size_t len) = 0;
+
+    /**
+     * \brief Write record
+     *
+     * \returns true if successful
+     */
+    virtual bool write(const char *key, const void *buf, size_t len) = 0;
+};
+
+
+/**
+ * \class NullBlobStorage
+ *
+ * \brief BlobStorage without records - writes are discarded
+ */
+class NullBlobStorage : public BlobStorage {
+public:
+    size_t read(const char *, void *, size_t)
+    {
+        return 0;
+    };
+
+    bool write(const char *, const void *, size_t)
+    {
+        return true;
+    };
+};
+
+
+#if defined(RAINGAUGE_USE_PREFS) || defined(LIGHTNING_USE_PREFS)
+/**
+ * \class PrefsBlobStorage
+ *
+ * \brief BlobStorage in a Preferences namespace
+ */
+class PrefsBlobStorage : public BlobStorage {
+private:
+    const char *ns;     //!< Preferences namespace
+
+public:
+    PrefsBlobStorage(const char *name) : ns(name) {};
+
+    size_t read(const char *key, void *buf, size_t len);
+    bool   write(const char *key, const void *buf, size_t len);
+};
+#endif
+
+
+/**
+ * \brief CRC-32 (IEEE 802.3)
+ *
+ * \param crc   CRC of previous data (0 for start)
+ * \param buf   data
+ * \param len   length of data
+ *
+ * \returns CRC-32
+ */
+uint32_t crc32(uint32_t crc, const void *buf, size_t len);
+
+
+/**
+ * \class PersistentBlob
+ *
+ * \brief Coalesced writes of a state blob to double-buffered slots
+ */
+class PersistentBlob {
+private:
+    BlobStorage &storage;       //!< storage backend
+    uint16_t version;           //!< data format version
+    uint32_t interval;          //!< minimum time between writes in seconds
+    uint32_t delta;             //!< change weight which causes a write
+    uint32_t seq;               //!< sequence number of last write/load
+    uint32_t lastWrite;         //!< time of last write in seconds
+    uint32_t weight;            //!< change weight since last write
+    uint32_t writes;            //!< number of slots written
+    bool     isDirty;           //!< state changed since last write
+
+    static uint32_t headerCrc(const persist_header_t &hdr, const void *data);
+    bool readSlot(int slot, persist_header_t &hdr, void *data, size_t len);
+
+public:
+    /**
+     * Constructor
+     *
+     * \param backend       storage backend
+     * \param data_version  data format version - slots with other versions are ignored
+     * \param min_interval  minimum time between writes in seconds
+     * \param min_delta     change weight which causes a write before min_interval
+     */
+    PersistentBlob(BlobStorage &backend, uint16_t data_version,
+                   uint32_t min_interval = PERSIST_INTERVAL, uint32_t min_delta = PERSIST_DELTA) :
+        storage(backend),
+        version(data_version),
+        interval(min_interval),
+        delta(min_delta)
+    {
+        seq = 0;
+        lastWrite = 0;
+        weight = 0;
+        writes = 0;
+        isDirty = false;
+    };
+
+    /**
+     * \brief Load state from newest valid slot
+     *
+     * \param data      state buffer
+     * \param len       state size in bytes
+     *
+     * \returns true if a valid slot was found (otherwise the contents of data are undefined)
+     */
+    bool load(void *data, size_t len);
+
+    /**
+     * \brief Report state change
+     *
+     * \param now       time in seconds (e.g. timestamp of update)
+     * \param w         change weight (e.g. rain in 0.1 mm)
+     */
+    void changed(uint32_t now, uint32_t w = 0);
+
+    /**
+     * \brief Write state if required
+     *
+     * \param data      state
+     * \param len       state size in bytes
+     * \param now       time in seconds
+     *
+     * \returns true if state was written
+     */
+    bool poll(const void *data, size_t len, uint32_t now);
+
+    /**
+     * \brief Write state if changed (e.g. before restart or deep sleep)
+     *
+     * \param data      state
+     * \param len       state size in bytes
+     *
+     * \returns true if state was written
+     */
+    bool flush(const void *data, size_t len);
+
+    /**
+     * \brief State changed since last write
+     */
+    bool dirty(void) const
+    {
+        return isDirty;
+    };
+
+    /**
+     * \brief Number of slots written
+     */
+    uint32_t written(void) const
+    {
+        return writes;
+    };
+};
+
+#endif
@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PipelineTrace.cpp
+//
+// Latency of the receive pipeline stages per frame, kept in log2 histograms
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string.h>
+#include "PipelineTrace.h"
+
+
+// Cycle counter frequency in MHz
+static uint32_t cycleRate(void)
+{
+#if defined(ESP32) && defined(__XTENSA__)
+    return getCpuFrequencyMhz();
+#elif defined(ESP32)
+    return 1;
+#elif defined(__x86_64__) || defined(__i386__)
+    // Calibrate time stamp counter against the monotonic clock
+    static uint32_t rate;
+    if (rate == 0) {
+        struct timespec t0;
+        struct timespec t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        uint32_t c0 = trace_cycles();
+        int64_t ns;
+        do {
+            clock_gettime(CLOCK_MONOTONIC, &t1);
+            ns = (t1.tv_sec - t0.tv_sec) * 1000000000LL + (t1.tv_nsec - t0.tv_nsec);
+        } while (ns < 10000000LL);
+        uint32_t c1 = trace_cycles();
+        rate = (uint32_t)(((uint64_t)(uint32_t)(c1 - c0) * 1000 + ns / 2) / ns);
+        if (rate == 0) {
+            rate = 1;
+        }
+    }
+    return rate;
+#else
+    return 1000;
+#endif
+}
+
+
+void
+PipelineTrace::reset(void)
+{
+    memset(stats, 0, sizeof(stats));
+    cyclesPerUs = cycleRate();
+    start = 0;
+    last = 0;
+    active = false;
+}
+
+
+void
+PipelineTrace::record(trace_stage_t stage, uint32_t ns)
+{
+    trace_stats_t &s = stats[stage];
+
+    // Bucket: index of the most significant bit
+    int b = 0;
+    for (uint32_t v = ns >> 1; v && (b < TRACE_BUCKETS - 1); v >>= 1) {
+        b++;
+    }
+    s.buckets[b]++;
+    s.count++;
+    s.sum_ns += ns;
+    if (ns > s.max_ns) {
+        s.max_ns = ns;
+    }
+}
+
+
+void
+PipelineTrace::mark(trace_stage_t stage)
+{
+    if (!active) {
+        return;
+    }
+    uint32_t now = trace_cycles();
+    record(stage, toNs(now - last));
+    last = now;
+}
+
+
+void
+PipelineTrace::end(void)
+{
+    if (!active) {
+        return;
+    }
+    record(TRACE_TOTAL, toNs(trace_cycles() - start));
+    active = false;
+}
+
+
+uint32_t
+PipelineTrace::percentile(trace_stage_t stage, uint8_t p) const
+{
+    const trace_stats_t &s = stats[stage];
+
+    if (s.count == 0) {
+        return 0;
+    }
+    // Rank of the percentile (1...count)
+    uint32_t rank = (uint32_t)(((uint64_t)s.count * p + 99) / 100);
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint32_t n = 0;
+    for (int b = 0; b < TRACE_BUCKETS; b++) {
+        n += s.buckets[b];
+        if (n >= rank) {
+            uint32_t upper = (b < 31) ? (2UL << b) - 1 : UINT32_MAX;
+            return (upper < s.max_ns) ? upper : s.max_ns;
+        }
+    }
+    return s.max_ns;
+}
+
+
+uint32_t
+PipelineTrace::mean(trace_stage_t stage) const
+{
+    const trace_stats_t &s = stats[stage];
+
+    return s.count ? (uint32_t)(s.sum_ns / s.count) : 0;
+}
+
+
+const char *
+PipelineTrace::name(trace_stage_t stage)
+{
+    static const char *names[TRACE_STAGES] = {
+        "read", "decode", "time", "process", "json", "publish", "total"
+    };
+
+    return (stage < TRACE_STAGES) ? names[stage] : "?";
+}
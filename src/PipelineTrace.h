@@ -0,0 +1,236 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PipelineTrace.h
+//
+// Latency of the receive pipeline stages per frame, kept in log2 histograms
+//
+// Each frame is timestamped at every stage with a cycle counter: the CPU cycle counter
+// (CCOUNT) on ESP32, the time stamp counter (rdtsc) on x86 hosts, clock_gettime() otherwise.
+// The time since the previous stage is added to the stage's histogram, the time since the
+// receive interrupt to the end-to-end histogram.
+//
+// Bucket b counts latencies of [2^b, 2^(b+1)) ns, i.e. percentiles are resolved to a factor
+// of two - enough to see where the time goes, in fixed memory and with O(1) updates.
+//
+// Note: CCOUNT is a 32-bit counter per CPU core (wraps after ~17.9 s at 240 MHz); the receive
+// interrupt and loop() must run on the same core, which is the case for the Arduino loop task
+// attaching the interrupt in setup().
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef PIPELINE_TRACE_H
+#define PIPELINE_TRACE_H
+
+#include <stdint.h>
+#include "WeatherSensorCfg.h"
+
+#if defined(ESP32)
+    #include <esp_timer.h>
+#else
+    #include <time.h>
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+    #endif
+#endif
+
+/**
+ * Number of histogram buckets (bucket b: [2^b, 2^(b+1)) ns; last bucket: all above)
+ */
+#define TRACE_BUCKETS 32
+
+/**
+ * \brief Pipeline stages - latency since the previous stage
+ */
+typedef enum TraceStage {
+    TRACE_READ,         //!< receive interrupt until radio.readData() done (loop latency)
+    TRACE_DECODE,       //!< decoderPayload()
+    TRACE_TIME,         //!< time acquisition
+    TRACE_PROCESS,      //!< per-sensor processing, storage and console output
+    TRACE_JSON,         //!< JSON document built and serialized
+    TRACE_PUBLISH,      //!< mqtt_client.publish()
+    TRACE_TOTAL,        //!< receive interrupt until published (end-to-end)
+    TRACE_STAGES
+} trace_stage_t;
+
+/**
+ * \brief Latency statistics of a stage
+ */
+typedef struct TraceStats {
+    uint32_t count;                     //!< number of samples
+    uint32_t max_ns;                    //!< maximum in ns
+    uint64_t sum_ns;                    //!< sum in ns
+    uint32_t buckets[TRACE_BUCKETS];    //!< log2 histogram
+} trace_stats_t;
+
+
+/**
+ * \brief Cycle counter
+ *
+ * \returns current value (wraps; only differences are meaningful)
+ */
+static inline uint32_t trace_cycles(void)
+{
+#if defined(ESP32) && defined(__XTENSA__)
+    uint32_t ccount;
+    __asm__ __volatile__("rsr %0, ccount" : "=a"(ccount));
+    return ccount;
+#elif defined(ESP32)
+    return (uint32_t)esp_timer_get_time();
+#elif defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    struct timespec tp;
+    clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (uint32_t)((uint64_t)tp.tv_sec * 1000000000ULL + tp.tv_nsec);
+#endif
+}
+
+
+/**
+ * \class PipelineTrace
+ *
+ * \brief Per-stage latency histograms of the receive pipeline
+ *
+ * Usage (one frame at a time):
+ * - capture trace_cycles() in the receive ISR
+ * - begin() with this value when the frame is processed
+ * - mark() after each stage
+ * - end() after the last stage
+ */
+class PipelineTrace {
+private:
+    trace_stats_t stats[TRACE_STAGES];  //!< statistics per stage
+    uint32_t cyclesPerUs;               //!< cycle counter frequency in MHz
+    uint32_t start;                     //!< cycle counter at receive interrupt
+    uint32_t last;                      //!< cycle counter at previous stage
+    bool     active;                    //!< frame in progress
+
+public:
+    /**
+     * Constructor
+     */
+    PipelineTrace()
+    {
+        reset();
+    };
+
+    /**
+     * \brief Clear statistics
+     *
+     * On x86 hosts, the time stamp counter frequency is calibrated (takes ~10 ms).
+     */
+    void reset(void);
+
+    /**
+     * \brief Start of a frame
+     *
+     * \param isr_cycles    trace_cycles() captured in the receive interrupt
+     */
+    void begin(uint32_t isr_cycles)
+    {
+        start = isr_cycles;
+        last = isr_cycles;
+        active = true;
+    };
+
+    /**
+     * \brief Stage completed - records the time since the previous stage
+     *
+     * Ignored if no frame is in progress.
+     *
+     * \param stage     stage
+     */
+    void mark(trace_stage_t stage);
+
+    /**
+     * \brief End of a frame - records the end-to-end latency
+     *
+     * Frames which are not completed (e.g. decoding failed) are not included in TRACE_TOTAL.
+     */
+    void end(void);
+
+    /**
+     * \brief Add a sample
+     *
+     * \param stage     stage
+     * \param ns        latency in ns
+     */
+    void record(trace_stage_t stage, uint32_t ns);
+
+    /**
+     * \brief Statistics of a stage
+     */
+    const trace_stats_t &stage(trace_stage_t stage) const
+    {
+        return stats[stage];
+    };
+
+    /**
+     * \brief Percentile estimate
+     *
+     * \param stage     stage
+     * \param p         percentile (0...100)
+     *
+     * \returns upper limit of the histogram bucket containing the percentile in ns,
+     *          0 if there are no samples
+     */
+    uint32_t percentile(trace_stage_t stage, uint8_t p) const;
+
+    /**
+     * \brief Mean latency
+     *
+     * \returns mean in ns, 0 if there are no samples
+     */
+    uint32_t mean(trace_stage_t stage) const;
+
+    /**
+     * \brief Stage name (for reports)
+     */
+    static const char *name(trace_stage_t stage);
+
+    /**
+     * \brief Convert cycle counter difference to ns
+     */
+    uint32_t toNs(uint32_t cycles) const
+    {
+        uint64_t ns = (uint64_t)cycles * 1000U / cyclesPerUs;
+        return (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)ns;
+    };
+};
+
+#endif
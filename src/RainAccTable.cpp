@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RainAccTable.cpp
+//
+// Rain accumulator baselines of multiple sensors, persisted as one bounded table blob
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 update() does not modify the accumulator
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <stdio.h>
+#include "RainAccTable.h"
+
+
+int
+RainAccTable::find(uint32_t id) const
+{
+    for (int i = 0; i < RAIN_ACC_TABLE_SIZE; i++) {
+        if (table.sensor_id[i] == id)
+            return i;
+    }
+    return -1;
+}
+
+
+void
+RainAccTable::load(void)
+{
+    if (loaded)
+        return;
+    if (!persist.load(&table, sizeof(table))) {
+        memset(&table, 0, sizeof(table));
+    }
+    loaded = true;
+}
+
+
+void
+RainAccTable::reset(void)
+{
+    // Load first to continue the sequence of the persisted slots
+    load();
+    memset(&table, 0, sizeof(table));
+    persist.changed(0);
+    persist.flush(&table, sizeof(table));
+}
+
+
+bool
+RainAccTable::restore(uint32_t id, RainAccumulator &acc)
+{
+    load();
+
+    int i = (id != 0) ? find(id) : -1;
+    if (i < 0)
+        return false;
+
+    acc.setState(table.state[i]);
+    return true;
+}
+
+
+void
+RainAccTable::update(uint32_t id, const RainAccumulator &acc, uint32_t now)
+{
+    if (id == 0)
+        return;
+
+    load();
+
+    const rain_acc_state_t &s = acc.getState();
+    int i = find(id);
+    bool baseline;
+    if (i < 0) {
+        // Allocate free entry or replace the sensor updated least recently
+        i = find(0);
+        if (i < 0) {
+            i = 0;
+            for (int k = 1; k < RAIN_ACC_TABLE_SIZE; k++) {
+                if (table.updated[k] < table.updated[i])
+                    i = k;
+            }
+            log_w("Rain baseline of %08X replaced by %08X", (unsigned)table.sensor_id[i], (unsigned)id);
+        }
+        table.sensor_id[i] = id;
+        baseline = true;
+    } else {
+        const rain_acc_state_t &prev = table.state[i];
+        baseline = (s.valid != prev.valid) || (s.resets != prev.resets) || (s.wraps != prev.wraps);
+    }
+
+    // Baseline changes are written immediately, otherwise weighted by rain in 0.1 mm
+    uint32_t weight = baseline ? PERSIST_DELTA : (uint32_t)(s.total - table.state[i].total);
+    table.state[i] = s;
+    table.updated[i] = now;
+
+    persist.changed(now, weight);
+    persist.poll(&table, sizeof(table), now);
+}
+
+
+uint8_t
+RainAccTable::size(void) const
+{
+    uint8_t n = 0;
+
+    for (int i = 0; i < RAIN_ACC_TABLE_SIZE; i++) {
+        if (table.sensor_id[i] != 0)
+            n++;
+    }
+    return n;
+}
@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RainAccTable.h
+//
+// Rain accumulator baselines of multiple sensors, persisted as one bounded table blob
+//
+// The states of the sensors' RainAccumulators are kept in a fixed table which is written with
+// PersistentBlob (CRC-protected, double-buffered, coalesced writes) as a whole. Baseline changes
+// (new sensor, sensor reset, counter wrap) are written immediately, rain increments are
+// coalesced. If the table is full, the sensor updated least recently is replaced - sensors get
+// a new random ID after a battery change, so stale entries are recycled instead of piling up.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 update() does not modify the accumulator
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef RAIN_ACC_TABLE_H
+#define RAIN_ACC_TABLE_H
+
+#include <stdint.h>
+#include <string.h>
+#include "WeatherSensorCfg.h"
+#include "RainAccumulator.h"
+#include "PersistentBlob.h"
+
+/**
+ * Format version of the table blob
+ */
+#define RAIN_ACC_TABLE_VERSION 1
+
+/**
+ * \brief Rain accumulator states of all sensors - persisted as one blob
+ */
+typedef struct RainAccTableData {
+    uint32_t sensor_id[RAIN_ACC_TABLE_SIZE];        //!< sensor ID (0: unused)
+    uint32_t updated[RAIN_ACC_TABLE_SIZE];          //!< time of last update
+    rain_acc_state_t state[RAIN_ACC_TABLE_SIZE];    //!< accumulator state
+} rain_acc_table_t;
+
+
+/**
+ * \class RainAccTable
+ *
+ * \brief Persisted table of RainAccumulator states keyed by sensor ID
+ */
+class RainAccTable {
+private:
+    rain_acc_table_t table;     //!< states of all sensors
+    PersistentBlob persist;     //!< coalesced writes of table
+    bool loaded;                //!< table loaded from storage
+
+    int  find(uint32_t id) const;
+    void load(void);
+
+public:
+    /**
+     * Constructor
+     *
+     * \param backend   storage backend
+     */
+    RainAccTable(BlobStorage &backend) :
+        persist(backend, RAIN_ACC_TABLE_VERSION)
+    {
+        loaded = false;
+        memset(&table, 0, sizeof(table));
+    };
+
+    /**
+     * \brief Remove all sensors (written immediately)
+     */
+    void reset(void);
+
+    /**
+     * \brief Restore accumulator state of sensor
+     *
+     * \param id        sensor ID
+     * \param acc       accumulator
+     *
+     * \returns true if state was found
+     */
+    bool restore(uint32_t id, RainAccumulator &acc);
+
+    /**
+     * \brief Store accumulator state of sensor after an update
+     *
+     * \param id        sensor ID
+     * \param acc       accumulator
+     * \param now       time in seconds (e.g. timestamp of reading)
+     */
+    void update(uint32_t id, const RainAccumulator &acc, uint32_t now);
+
+    /**
+     * \brief Write pending changes (e.g. before restart or deep sleep)
+     */
+    void flush(void)
+    {
+        persist.flush(&table, sizeof(table));
+    };
+
+    /**
+     * \brief Number of sensors
+     */
+    uint8_t size(void) const;
+};
+
+#endif
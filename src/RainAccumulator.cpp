@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RainAccumulator.cpp
+//
+// Per-sensor rain accumulator with counter wrap and sensor reset handling
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Removed save()/load() - persisted by RainAccTable
+// 20261019 Removed dirty()/saved() - writes coalesced by RainAccTable
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <string.h>
+#include "RainAccumulator.h"
+
+
+void
+RainAccumulator::reset(void)
+{
+    memset(&state, 0, sizeof(state));
+}
+
+
+void
+RainAccumulator::setState(const rain_acc_state_t &s)
+{
+    state = s;
+}
+
+
+int32_t
+RainAccumulator::update(uint32_t counter, bool startup)
+{
+    uint32_t delta;
+
+    if (counter >= RAIN_COUNTER_LIMIT) {
+        log_w("Rain counter out of range: %u", (unsigned)counter);
+        return 0;
+    }
+
+    if (!state.valid) {
+        state.prev = counter;
+        state.valid = true;
+        return RAIN_DELTA_INVALID;
+    }
+
+    if (counter >= state.prev) {
+        delta = counter - state.prev;
+    } else if (!startup && (state.prev >= RAIN_COUNTER_LIMIT - RAIN_WRAP_WINDOW)) {
+        // Counter wrap at 6-digit limit
+        delta = counter + RAIN_COUNTER_LIMIT - state.prev;
+        state.wraps++;
+        log_d("Rain counter wrap: %u -> %u", (unsigned)state.prev, (unsigned)counter);
+    } else {
+        // Sensor reset (startup flag set, e.g. battery change) or implausible decrease -
+        // counting restarted from zero
+        delta = counter;
+        state.resets++;
+        log_d("Rain counter reset%s: %u -> %u", startup ? " (startup)" : "",
+              (unsigned)state.prev, (unsigned)counter);
+    }
+
+    state.total += delta;
+    state.prev = counter;
+
+    return (int32_t)delta;
+}
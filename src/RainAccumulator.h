@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RainAccumulator.h
+//
+// Per-sensor rain accumulator with counter wrap and sensor reset handling
+//
+// The sensor transmits a 6-digit BCD rain counter in 0.1 mm. The accumulator keeps the
+// previous counter value as baseline and adds the increments to a 64-bit total, so the
+// total never decreases:
+// - counter increased:                      increment = counter - previous
+// - counter decreased, startup flag set:    sensor reset (e.g. battery change) -
+//                                           counting restarted from zero, increment = counter
+// - counter decreased near the 6-digit limit: counter wrap,
+//                                           increment = counter + limit - previous
+// - counter decreased otherwise:            treated as sensor reset (implausible wrap)
+//
+// The state is a plain struct, so it can be kept in RTC RAM or saved as a blob (see
+// RainAccTable). Saving an older (total, baseline) pair is safe: the increments since then
+// are recovered with the next reading.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Removed save()/load() - persisted by RainAccTable
+// 20261019 Removed dirty()/saved() - writes coalesced by RainAccTable
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RAIN_ACCUMULATOR_H
+#define RAIN_ACCUMULATOR_H
+
+#include <stdint.h>
+#include "WeatherSensorCfg.h"
+
+/**
+ * Rain counter limit in 0.1 mm (6 BCD digits)
+ */
+#define RAIN_COUNTER_LIMIT 1000000UL
+
+/**
+ * Counter decrease is only accepted as wrap if the previous value was within
+ * this distance (0.1 mm) of the limit
+ */
+#define RAIN_WRAP_WINDOW 10000UL
+
+/**
+ * Return value of update() for the first reading (no baseline yet)
+ */
+#define RAIN_DELTA_INVALID (-1)
+
+
+/**
+ * \brief Rain accumulator state
+ */
+typedef struct RainAccState {
+    uint64_t total;         //!< accumulated rain since first reading in 0.1 mm
+    uint32_t prev;          //!< baseline - previous counter value in 0.1 mm
+    uint16_t resets;        //!< number of sensor resets detected
+    uint16_t wraps;         //!< number of counter wraps detected
+    bool     valid;         //!< baseline is valid
+} rain_acc_state_t;
+
+
+/**
+ * \class RainAccumulator
+ *
+ * \brief Accumulation of the sensor's rain counter in integer 0.1 mm units
+ */
+class RainAccumulator {
+private:
+    rain_acc_state_t state;
+
+public:
+    /**
+     * Discard baseline and total
+     */
+    void reset(void);
+
+    /**
+     * \brief Update accumulator with new counter value
+     *
+     * \param counter   rain counter in 0.1 mm (0...RAIN_COUNTER_LIMIT-1)
+     * \param startup   sensor startup flag
+     *
+     * \returns increment in 0.1 mm since previous reading or RAIN_DELTA_INVALID for first reading
+     */
+    int32_t update(uint32_t counter, bool startup);
+
+    /**
+     * \brief Accumulated rain
+     *
+     * \returns accumulated rain since first reading in 0.1 mm
+     */
+    uint64_t total(void) const
+    {
+        return state.total;
+    };
+
+    /**
+     * \brief Baseline available
+     *
+     * \returns true if at least one reading has been processed
+     */
+    bool valid(void) const
+    {
+        return state.valid;
+    };
+
+    /**
+     * \brief Access state (e.g. for saving in RTC RAM or non-volatile memory)
+     */
+    const rain_acc_state_t &getState(void) const
+    {
+        return state;
+    };
+
+    /**
+     * \brief Restore state
+     */
+    void setState(const rain_acc_state_t &s);
+};
+
+#endif
@@ -0,0 +1,418 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RainGauge.cpp
+//
+// Calculation of hourly (past 60 minutes), daily, weekly and monthly rainfall
+// from the rain gauge value provided by the weather sensor
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Compact history buffer (12-bit slots in 0.1 mm),
+//          added RAINGAUGE_HIST_SIZE and past()
+// 20261019 Added rolling windows
+// 20261019 Calendar periods from CalendarTracker (no localtime_r() per update)
+// 20261019 Replaced load()/save() by PersistentBlob (coalesced writes)
+// 20261019 State accessed via pointer - added attach() for external state
+// 20261019 Added updateBatch(), update() split into step() and persistence
+// 20261019 Fixed reset() being undone by loading the persisted state
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include "RainGauge.h"
+#include "PackedReading.h"
+
+// Slot length in seconds
+#define SLOT_SECS (RAINGAUGE_UPD_RATE * 60)
+
+// Return values of step() other than the rain delta
+#define RAIN_STEP_FIRST   (-1)  // first update - baselines set
+#define RAIN_STEP_IGNORED (-2)  // timestamp older than last update
+
+
+// Rain in 0.1 mm
+static int32_t deci(float rain)
+{
+    return (int32_t)lround((double)rain * 10.0);
+}
+
+
+void
+RainGauge::clear(void)
+{
+    memset(nv, 0, sizeof(*nv));
+    hist_init();
+    windows.reset();
+    calendar.reset();
+}
+
+
+void
+RainGauge::reset(void)
+{
+#if defined(RAINGAUGE_PERSIST)
+    if (nv == &ownData) {
+        // Continue the sequence of the persisted slots, so the cleared state is the newest one
+        if (!loaded)
+            persist.load(nv, sizeof(*nv));
+        loaded = true;
+        clear();
+        persist.changed(0);
+        persist.flush(nv, sizeof(*nv));
+        return;
+    }
+#endif
+    clear();
+}
+
+
+void
+RainGauge::attach(nvData_t *state)
+{
+    nv = state ? state : &ownData;
+    windows.reset();
+    calendar.reset();
+}
+
+
+void
+RainGauge::hist_init(int16_t rain)
+{
+    for (int i = 0; i < RAINGAUGE_HIST_SIZE; i++) {
+        putSlot(i, rain);
+    }
+    nv->histSum   = (rain < 0) ? 0 : getSlot(0) * 10 * RAIN_HIST_SIZE;
+    nv->histValid = (rain < 0) ? 0 : RAIN_HIST_SIZE;
+}
+
+
+int32_t
+RainGauge::getSlot(int idx) const
+{
+    // Two slots are packed into three bytes
+    const uint8_t *p = &nv->hist[idx * 3 / 2];
+    uint16_t v = (idx & 1) ? ((p[0] >> 4) | (p[1] << 4)) : (p[0] | ((p[1] & 0x0F) << 8));
+
+    return (v == RAIN_SLOT_INVALID) ? -1 : v;
+}
+
+
+void
+RainGauge::putSlot(int idx, int32_t val)
+{
+    uint8_t *p = &nv->hist[idx * 3 / 2];
+    uint16_t v;
+
+    if (val < 0) {
+        v = RAIN_SLOT_INVALID;
+    } else if (val > RAIN_SLOT_MAX) {
+        log_w("Rain history slot saturated");
+        v = RAIN_SLOT_MAX;
+    } else {
+        v = val;
+    }
+
+    if (idx & 1) {
+        p[0] = (p[0] & 0x0F) | ((v & 0x0F) << 4);
+        p[1] = v >> 4;
+    } else {
+        p[0] = v & 0xFF;
+        p[1] = (p[1] & 0xF0) | (v >> 8);
+    }
+}
+
+
+int32_t
+RainGauge::step(time_t timestamp, float rain, bool startup)
+{
+    // Local calendar day, week (starting on Monday) and month
+    calendar.update(timestamp);
+    int32_t day   = calendar.day();
+    int32_t week  = calendar.week();
+    int32_t month = calendar.month();
+
+    if (nv->lastUpdate == 0) {
+        // First update - set baselines
+        hist_init();
+        nv->rainRaw = rain;
+        nv->rainAcc = 0;
+        nv->rainPrev = rain;
+        nv->startupPrev = startup;
+        nv->dayNo = day;
+        nv->weekNo = week;
+        nv->monthNo = month;
+        nv->rainDayBegin = rain;
+        nv->rainWeekBegin = rain;
+        nv->rainMonthBegin = rain;
+        putSlot((timestamp / SLOT_SECS) % RAINGAUGE_HIST_SIZE, 0);
+        nv->histValid = 1;
+        nv->lastUpdate = (uint32_t)timestamp;
+        windows.update(timestamp, 0);
+        return RAIN_STEP_FIRST;
+    }
+
+    if (timestamp < nv->lastUpdate) {
+        log_w("Timestamp older than last update - ignored");
+        return RAIN_STEP_IGNORED;
+    }
+
+    if (startup && !nv->startupPrev) {
+        // Sensor startup - counter restarted from zero
+        nv->rainAcc = nv->rainPrev;
+    } else if (rain < nv->rainRaw) {
+        // Rain gauge overflow
+        nv->rainAcc += raingaugeMax;
+    }
+    nv->startupPrev = startup;
+    nv->rainRaw = rain;
+
+    float rainCurr = nv->rainAcc + rain;
+    int32_t delta = deci(rainCurr) - deci(nv->rainPrev);
+    if (delta < 0) {
+        delta = 0;
+    }
+    nv->rainPrev = rainCurr;
+    windows.update(timestamp, (delta > UINT16_MAX) ? UINT16_MAX : delta);
+
+    /*
+     * History
+     */
+    time_t  slot     = timestamp / SLOT_SECS;
+    time_t  slotPrev = nv->lastUpdate / SLOT_SECS;
+    int     idx      = slot % RAINGAUGE_HIST_SIZE;
+
+    if (slot == slotPrev) {
+        // Same slot as in previous update - add
+        int32_t val = getSlot(idx);
+        putSlot(idx, (val < 0) ? delta : val + delta);
+        if (val < 0) {
+            nv->histValid++;
+        } else {
+            nv->histSum -= val * 10;
+        }
+        nv->histSum += getSlot(idx) * 10;
+    } else if (slot - slotPrev >= RAIN_HIST_SIZE) {
+        // All slots of the past hour are new
+        // If the time span of the rain delta exceeds one hour, it cannot be assigned to a slot
+        int32_t val = delta;
+        if (timestamp - nv->lastUpdate >= RAIN_HIST_SIZE * SLOT_SECS) {
+            log_d("History time frame expired, resetting!");
+            val = -1;
+        }
+        time_t first = (slot - slotPrev > RAINGAUGE_HIST_SIZE) ? slot - RAINGAUGE_HIST_SIZE + 1 : slotPrev + 1;
+        for (time_t k = first; k < slot; k++) {
+            putSlot(k % RAINGAUGE_HIST_SIZE, -1);
+        }
+        putSlot(idx, val);
+        nv->histSum   = (val < 0) ? 0 : getSlot(idx) * 10;
+        nv->histValid = (val < 0) ? 0 : 1;
+    } else {
+        // Advance slot by slot - the slot leaving the past hour is subtracted from the
+        // running sum, the slot entering it is written (skipped slots: invalid)
+        for (time_t k = slotPrev + 1; k <= slot; k++) {
+            int32_t old = getSlot((k - RAIN_HIST_SIZE) % RAINGAUGE_HIST_SIZE);
+            if (old >= 0) {
+                nv->histSum -= old * 10;
+                nv->histValid--;
+            }
+            putSlot(k % RAINGAUGE_HIST_SIZE, (k == slot) ? delta : -1);
+            if (k == slot) {
+                nv->histSum += getSlot(idx) * 10;
+                nv->histValid++;
+            }
+        }
+    }
+
+    /*
+     * Calendar periods - the baseline is the accumulated rain at the first update
+     * in the new period
+     */
+    if (day != nv->dayNo) {
+        nv->dayNo = day;
+        nv->rainDayBegin = rainCurr;
+    }
+    if (week != nv->weekNo) {
+        nv->weekNo = week;
+        nv->rainWeekBegin = rainCurr;
+    }
+    if (month != nv->monthNo) {
+        nv->monthNo = month;
+        nv->rainMonthBegin = rainCurr;
+    }
+
+    nv->lastUpdate = (uint32_t)timestamp;
+    return delta;
+}
+
+
+void
+RainGauge::update(time_t timestamp, float rain, bool startup)
+{
+    rain_sample_t sample = {timestamp, rain, startup};
+
+    updateBatch(&sample, 1);
+}
+
+
+size_t
+RainGauge::updateBatch(const rain_sample_t *samples, size_t count)
+{
+#if defined(RAINGAUGE_PERSIST)
+    if ((nv == &ownData) && !loaded) {
+        if (!persist.load(nv, sizeof(*nv)))
+            clear();
+        loaded = true;
+    }
+    bool     first  = false;
+    uint32_t weight = 0;
+#endif
+
+    size_t applied = 0;
+    for (size_t i = 0; i < count; i++) {
+        int32_t res = step(samples[i].timestamp, samples[i].rain, samples[i].startup);
+        if (res == RAIN_STEP_IGNORED)
+            continue;
+        applied++;
+#if defined(RAINGAUGE_PERSIST)
+        if (res == RAIN_STEP_FIRST) {
+            first = true;
+        } else {
+            weight += res;
+        }
+#endif
+    }
+
+#if defined(RAINGAUGE_PERSIST)
+    // State is persisted once per batch - baselines are written immediately
+    if ((nv == &ownData) && (applied > 0)) {
+        persist.changed(nv->lastUpdate, weight);
+        if (first) {
+            persist.flush(nv, sizeof(*nv));
+        } else {
+            persist.poll(nv, sizeof(*nv), nv->lastUpdate);
+        }
+    }
+#endif
+    return applied;
+}
+
+
+float
+RainGauge::pastHour(bool *valid, int *quality)
+{
+    if (valid) {
+        *valid = nv->histValid >= qualityThreshold;
+    }
+    if (quality) {
+        *quality = nv->histValid;
+    }
+    return nv->histSum * 0.01f;
+}
+
+
+float
+RainGauge::past(int minutes, int *quality)
+{
+    int     n = minutes / RAINGAUGE_UPD_RATE;
+    int32_t sum = 0;
+    int     valid = 0;
+
+    if (n > RAINGAUGE_HIST_SIZE) {
+        n = RAINGAUGE_HIST_SIZE;
+    }
+    if (nv->lastUpdate != 0) {
+        time_t slot = nv->lastUpdate / SLOT_SECS;
+        for (int i = 0; i < n; i++) {
+            int32_t val = getSlot((slot - i) % RAINGAUGE_HIST_SIZE);
+            if (val >= 0) {
+                sum += val;
+                valid++;
+            }
+        }
+    }
+    if (quality) {
+        *quality = valid;
+    }
+    return sum * 0.1f;
+}
+
+
+float
+RainGauge::currentDay(void)
+{
+    if (nv->lastUpdate == 0)
+        return -1;
+
+    return nv->rainPrev - nv->rainDayBegin;
+}
+
+
+float
+RainGauge::currentWeek(void)
+{
+    if (nv->lastUpdate == 0)
+        return -1;
+
+    return nv->rainPrev - nv->rainWeekBegin;
+}
+
+
+float
+RainGauge::currentMonth(void)
+{
+    if (nv->lastUpdate == 0)
+        return -1;
+
+    return nv->rainPrev - nv->rainMonthBegin;
+}
+
+
+void
+RainGauge::printCircularBuffer(void)
+{
+    char buf[8 * 7 + 1];
+    int  pos = 0;
+
+    for (int i = 0; i < RAINGAUGE_HIST_SIZE; i++) {
+        pos += snprintf(&buf[pos], sizeof(buf) - pos, "%7ld", (long)getSlot(i));
+        if ((pos >= 8 * 7) || (i == RAINGAUGE_HIST_SIZE - 1)) {
+            log_d("hist[%3d]:%s", i - (pos / 7) + 1, buf);
+            pos = 0;
+        }
+    }
+    log_d("past hour: sum: %ld valid: %d", (long)nv->histSum, nv->histValid);
+}
@@ -0,0 +1,380 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RainGauge.h
+//
+// Calculation of hourly (past 60 minutes), daily, weekly and monthly rainfall
+// from the rain gauge value provided by the weather sensor
+//
+// The rain gauge value is a float which overflows at raingaugeMax. A sensor startup
+// (e.g. battery change) restarts the counter from zero; both are compensated by an
+// accumulated offset.
+//
+// Past 60 minutes rainfall:
+// The hour is divided into RAIN_HIST_SIZE slots of RAINGAUGE_UPD_RATE minutes, numbered
+// by timestamp / slot length. Each update adds its rain delta to the slot of its timestamp;
+// slots skipped since the previous update are marked invalid. The sum of the valid slots
+// within the past hour and their number are maintained incrementally when slots enter or
+// leave the hour, so pastHour() is O(1) and never rescans the buffer.
+//
+// The circular buffer holds RAINGAUGE_HIST_SIZE (>= RAIN_HIST_SIZE) slots, so longer
+// periods can be queried with past(). To fit into RTC RAM, slots hold 12-bit values
+// in 0.1 mm (two slots in three bytes); values above 409.4 mm per slot saturate.
+//
+// Rainfall during arbitrary windows up to one week (e.g. 10 minutes or 24 hours for
+// alerting) is provided by window() from RollingWindows. This data is kept in RAM only.
+//
+// Daily, weekly (starting on Monday) and monthly rainfall:
+// The accumulated rain at the first update of a period (local time) is stored as baseline.
+// The period boundaries are provided by CalendarTracker - call reset() after changing TZ.
+//
+// With RAINGAUGE_USE_PREFS, the state is written to Preferences by PersistentBlob: only
+// every PERSIST_INTERVAL seconds or after PERSIST_DELTA of rain, and by flush(). The state is
+// loaded by the first update after startup; reset() writes the cleared state immediately, so
+// an older state is not restored.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Compact history buffer (12-bit slots in 0.1 mm),
+//          added RAINGAUGE_HIST_SIZE and past()
+// 20261019 Added window()
+// 20261019 Calendar periods from CalendarTracker
+// 20261019 Coalesced Preferences writes via PersistentBlob, added flush()
+// 20261019 Added attach() for external state
+// 20261019 Added updateBatch()
+// 20261019 reset() writes cleared state, added constructor with BlobStorage
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _RAINGAUGE_H
+#define _RAINGAUGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include "WeatherSensorCfg.h"
+#include "RollingWindows.h"
+#include "CalendarTracker.h"
+
+#if defined(RAINGAUGE_USE_PREFS) || defined(INSIDE_UNITTEST)
+    // Own state persisted by PersistentBlob (unit tests: storage provided by the test)
+    #define RAINGAUGE_PERSIST
+    #include "PersistentBlob.h"
+#endif
+
+/**
+ * Rain gauge overflow value (mm) - default for constructor
+ */
+#define RAINGAUGE_MAX_VALUE 100000
+
+/**
+ * Slot length for past 60 minutes rainfall (minutes)
+ */
+#define RAINGAUGE_UPD_RATE 6
+
+/**
+ * Number of slots for past 60 minutes rainfall
+ */
+#define RAIN_HIST_SIZE 10
+
+/**
+ * Minimum number of valid slots for a valid past 60 minutes rainfall
+ */
+#define DEFAULT_QUALITY_THRESHOLD 8
+
+/**
+ * Capacity of history buffer (slots) - at least RAIN_HIST_SIZE
+ */
+#if !defined(RAINGAUGE_HIST_SIZE)
+    #define RAINGAUGE_HIST_SIZE RAIN_HIST_SIZE
+#endif
+
+#if (RAINGAUGE_HIST_SIZE < RAIN_HIST_SIZE)
+    #error "Invalid RAINGAUGE_HIST_SIZE"
+#endif
+
+#define RAIN_SLOT_MAX     0xFFE //!< max. slot value (0.1 mm) - larger values saturate
+#define RAIN_SLOT_INVALID 0xFFF //!< no valid value
+
+/**
+ * Format version of nvData in Preferences
+ */
+#define RAINGAUGE_NV_VERSION 1
+
+
+/**
+ * \brief Rain gauge state - can be kept in RTC RAM or saved in non-volatile memory
+ */
+typedef struct RainGaugeData {
+    uint32_t lastUpdate;                        //!< timestamp of last update (0: no update yet)
+    float    rainRaw;                           //!< rain gauge value of last update
+    float    rainAcc;                           //!< offset from overflows and sensor startups
+    float    rainPrev;                          //!< accumulated rain at last update
+    float    rainDayBegin;                      //!< accumulated rain at begin of day
+    float    rainWeekBegin;                     //!< accumulated rain at begin of week
+    float    rainMonthBegin;                    //!< accumulated rain at begin of month
+    int32_t  dayNo;                             //!< current day (local days since epoch)
+    int32_t  weekNo;                            //!< current week
+    int32_t  monthNo;                           //!< current month (year * 12 + month)
+    int32_t  histSum;                           //!< sum of valid slots in past hour in 0.01 mm
+    uint8_t  hist[(RAINGAUGE_HIST_SIZE * 3 + 1) / 2]; //!< rainfall per slot (12 bits) in 0.1 mm
+    uint8_t  histValid;                         //!< number of valid slots in past hour
+    bool     startupPrev;                       //!< startup flag of last update
+} nvData_t;
+
+
+/**
+ * \brief Rain gauge sample for RainGauge::updateBatch()
+ */
+typedef struct RainSample {
+    time_t   timestamp;     //!< timestamp
+    float    rain;          //!< rain gauge value from sensor in mm
+    bool     startup;       //!< sensor startup flag
+} rain_sample_t;
+
+
+/**
+ * \class RainGauge
+ *
+ * \brief Calculation of hourly (past 60 minutes), daily, weekly and monthly rainfall
+ */
+class RainGauge {
+private:
+    nvData_t ownData;           //!< rain gauge state (unless attached to external state)
+    nvData_t *nv;               //!< rain gauge state in use
+    float    raingaugeMax;      //!< rain gauge overflow value
+    uint8_t  qualityThreshold;  //!< minimum number of valid slots for valid pastHour()
+    RollingWindows windows;     //!< rainfall in 0.1 mm for window()
+    CalendarTracker calendar;   //!< local day, week and month
+#if defined(RAINGAUGE_USE_PREFS)
+    PrefsBlobStorage prefs;     //!< Preferences storage
+#elif defined(RAINGAUGE_PERSIST)
+    NullBlobStorage prefs;      //!< no storage
+#endif
+#if defined(RAINGAUGE_PERSIST)
+    PersistentBlob persist;     //!< coalesced writes of own state
+    bool     loaded;            //!< own state loaded from storage (or reset) since startup
+#endif
+
+    void    clear(void);
+    int32_t getSlot(int idx) const;
+    void    putSlot(int idx, int32_t val);
+    int32_t step(time_t timestamp, float rain, bool startup);
+
+public:
+    /**
+     * Constructor
+     *
+     * \param raingauge_max     raingauge value which causes a counter overflow
+     * \param quality_threshold minimum number of valid slots for valid past 60 minutes rainfall
+     */
+    RainGauge(const float raingauge_max = RAINGAUGE_MAX_VALUE,
+              const uint8_t quality_threshold = DEFAULT_QUALITY_THRESHOLD) :
+        raingaugeMax(raingauge_max),
+        qualityThreshold(quality_threshold)
+#if defined(RAINGAUGE_USE_PREFS)
+        , prefs("BWS-RG"),
+        persist(prefs, RAINGAUGE_NV_VERSION)
+#elif defined(RAINGAUGE_PERSIST)
+        , persist(prefs, RAINGAUGE_NV_VERSION)
+#endif
+    {
+        nv = &ownData;
+#if defined(RAINGAUGE_PERSIST)
+        loaded = false;
+#endif
+        clear();
+    };
+
+#if defined(RAINGAUGE_PERSIST)
+    /**
+     * Constructor with storage backend for own state (e.g. for tests)
+     *
+     * \param backend           storage backend
+     * \param raingauge_max     raingauge value which causes a counter overflow
+     * \param quality_threshold minimum number of valid slots for valid past 60 minutes rainfall
+     */
+    RainGauge(BlobStorage &backend,
+              const float raingauge_max = RAINGAUGE_MAX_VALUE,
+              const uint8_t quality_threshold = DEFAULT_QUALITY_THRESHOLD) :
+        raingaugeMax(raingauge_max),
+        qualityThreshold(quality_threshold),
+#if defined(RAINGAUGE_USE_PREFS)
+        prefs("BWS-RG"),
+#endif
+        persist(backend, RAINGAUGE_NV_VERSION)
+    {
+        nv = &ownData;
+        loaded = false;
+        clear();
+    };
+#endif
+
+    /**
+     * \brief Use external state (e.g. owned by GaugeManager)
+     *
+     * The owner of external state is responsible for its persistence.
+     * The state is not modified - call reset() for a new sensor.
+     *
+     * \param state     external state or nullptr for own state
+     */
+    void attach(nvData_t *state);
+
+    /**
+     * \brief Reset all rain data
+     *
+     * The cleared own state is written immediately (otherwise the next update would load
+     * the state from before the reset).
+     */
+    void reset(void);
+
+    /**
+     * \brief Initialize history buffer
+     *
+     * \param rain  initial value of all slots in 0.1 mm (-1: invalid)
+     */
+    void hist_init(int16_t rain = -1);
+
+    /**
+     * \brief Set rain gauge overflow value
+     *
+     * \param raingauge_max     raingauge value which causes a counter overflow
+     */
+    void set_max(float raingauge_max)
+    {
+        raingaugeMax = raingauge_max;
+    };
+
+    /**
+     * \brief Update rain gauge data
+     *
+     * Updates with a timestamp older than the previous one are ignored.
+     *
+     * \param timestamp     timestamp
+     * \param rain          rain gauge value from sensor in mm
+     * \param startup       sensor startup flag
+     */
+    void update(time_t timestamp, float rain, bool startup = false);
+
+    /**
+     * \brief Update rain gauge data with a sequence of samples (e.g. backfill from an archive)
+     *
+     * The result is the same as with update() for each sample, but the state is
+     * persisted only once.
+     *
+     * \param samples       samples sorted by timestamp
+     * \param count         number of samples
+     *
+     * \returns number of samples applied (samples older than the previous one are ignored)
+     */
+    size_t updateBatch(const rain_sample_t *samples, size_t count);
+
+    /**
+     * \brief Write pending state changes to Preferences (e.g. before restart or deep sleep)
+     *
+     * Without RAINGAUGE_USE_PREFS or with external state, nothing is done.
+     */
+    void flush(void)
+    {
+#if defined(RAINGAUGE_PERSIST)
+        if (nv == &ownData)
+            persist.flush(nv, sizeof(*nv));
+#endif
+    };
+
+    /**
+     * \brief Rainfall during past 60 minutes
+     *
+     * \param valid     (optional) set to true if number of valid slots >= quality threshold
+     * \param quality   (optional) number of valid slots
+     *
+     * \returns rainfall in mm
+     */
+    float pastHour(bool *valid = nullptr, int *quality = nullptr);
+
+    /**
+     * \brief Rainfall during past period (O(n), period limited by buffer capacity)
+     *
+     * \param minutes   period in minutes (multiple of RAINGAUGE_UPD_RATE,
+     *                  max. RAINGAUGE_HIST_SIZE * RAINGAUGE_UPD_RATE)
+     * \param quality   (optional) number of valid slots
+     *
+     * \returns rainfall in mm up to last update
+     */
+    float past(int minutes, int *quality = nullptr);
+
+    /**
+     * \brief Rainfall during past window (O(1))
+     *
+     * The window start is rounded to 1 min (up to 1 h), 15 min (up to 1 d) or 3 h.
+     *
+     * \param minutes   window length in minutes (max. ROLLING_MAX_WINDOW / 60)
+     * \param valid     (optional) set to false if the window exceeds the time covered by
+     *                  updates since startup/reset
+     *
+     * \returns rainfall in mm up to last update
+     */
+    float window(uint32_t minutes, bool *valid = nullptr)
+    {
+        return windows.sum(minutes * 60, valid) * 0.1f;
+    };
+
+    /**
+     * \brief Rainfall of current calendar day
+     *
+     * \returns rainfall in mm or -1 if no update has been done yet
+     */
+    float currentDay(void);
+
+    /**
+     * \brief Rainfall of current week (starting on Monday)
+     *
+     * \returns rainfall in mm or -1 if no update has been done yet
+     */
+    float currentWeek(void);
+
+    /**
+     * \brief Rainfall of current calendar month
+     *
+     * \returns rainfall in mm or -1 if no update has been done yet
+     */
+    float currentMonth(void);
+
+    /**
+     * \brief Print history buffer (debug)
+     */
+    void printCircularBuffer(void);
+};
+
+#endif
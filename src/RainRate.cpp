@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RainRate.cpp
+//
+// Streaming rain rate (intensity) estimator for a tipping bucket rain gauge
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <math.h>
+#include "RainRate.h"
+
+
+void
+RainRate::reset(void)
+{
+    rate = 0;
+    lastTip = 0;
+    lastFrame = 0;
+}
+
+
+float
+RainRate::update(time_t timestamp, uint32_t tips)
+{
+    if ((lastTip != 0) && (timestamp - lastTip > RAIN_RATE_DRY)) {
+        // Rain has stopped
+        rate = 0;
+        lastTip = 0;
+    }
+
+    if (tips > 0) {
+        float inst = -1;
+        if (lastTip != 0) {
+            // n tips since previous tip
+            time_t dt = timestamp - lastTip;
+            inst = tips * RAIN_RATE_TIP_MM * 3600.0f / ((dt > 0) ? dt : 1);
+        } else if ((tips > 1) && (lastFrame != 0) && (timestamp > lastFrame)) {
+            // Time of previous tip unknown - n tips give n-1 intervals within the frame
+            inst = (tips - 1) * RAIN_RATE_TIP_MM * 3600.0f / (timestamp - lastFrame);
+        }
+        if (inst >= 0) {
+            float alpha = 1.0f - expf(-(float)tips / RAIN_RATE_TIPS);
+            rate += alpha * (inst - rate);
+        }
+        lastTip = timestamp;
+    }
+    lastFrame = timestamp;
+
+    return current(timestamp);
+}
+
+
+float
+RainRate::current(time_t timestamp) const
+{
+    if (lastTip == 0)
+        return 0;
+
+    time_t elapsed = timestamp - lastTip;
+    if (elapsed > RAIN_RATE_DRY)
+        return 0;
+    if (elapsed <= 0)
+        return rate;
+
+    // The next tip has not arrived yet
+    float bound = RAIN_RATE_TIP_MM * 3600.0f / elapsed;
+    return (rate < bound) ? rate : bound;
+}
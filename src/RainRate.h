@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RainRate.h
+//
+// Streaming rain rate (intensity) estimator for a tipping bucket rain gauge
+//
+// The rain gauge counts in steps of 0.1 mm (tips), so the increment per frame is mostly 0 or 1
+// and cannot be used as rate directly. Instead, the rate is estimated from the time between
+// tips: n tips arriving t seconds after the previous tip give a rate of n * 0.1 mm / t.
+// These interval estimates are smoothed exponentially per tip (weight of an interval decays
+// with exp(-tips / RAIN_RATE_TIPS)), so heavy rain with many tips per frame is detected
+// within a few frames while light rain is not made noisy by the quantisation.
+// Between tips, the rate is limited to one tip over the time elapsed since the last tip -
+// the next tip has not arrived yet - so the estimate decays when the rain stops and drops to
+// zero after RAIN_RATE_DRY seconds without a tip.
+//
+// The object has no constructor and is valid when zero-initialized (e.g. in SensorTable).
+// Each update is O(1).
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef RAIN_RATE_H
+#define RAIN_RATE_H
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * Number of tips after which the weight of an interval estimate has decayed to 1/e
+ */
+#define RAIN_RATE_TIPS 3.0f
+
+/**
+ * Time without tip after which the rain is considered to have stopped (seconds)
+ */
+#define RAIN_RATE_DRY 3600
+
+/**
+ * Rain per tip in mm
+ */
+#define RAIN_RATE_TIP_MM 0.1f
+
+
+/**
+ * \class RainRate
+ *
+ * \brief Rain rate in mm/h from tip events
+ */
+class RainRate {
+private:
+    float  rate;        //!< smoothed rate in mm/h
+    time_t lastTip;     //!< time of last tip (0: none since start or dry period)
+    time_t lastFrame;   //!< time of last update (0: none)
+
+public:
+    /**
+     * Discard state
+     */
+    void reset(void);
+
+    /**
+     * \brief Update with new frame
+     *
+     * \param timestamp     time of frame in seconds
+     * \param tips          rain increment since previous frame in 0.1 mm
+     *
+     * \returns rain rate in mm/h
+     */
+    float update(time_t timestamp, uint32_t tips);
+
+    /**
+     * \brief Rain rate at given time
+     *
+     * \param timestamp     time in seconds (not before last update)
+     *
+     * \returns rain rate in mm/h
+     */
+    float current(time_t timestamp) const;
+};
+
+#endif
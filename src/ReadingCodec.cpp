@@ -0,0 +1,304 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ReadingCodec.cpp
+//
+// Gorilla-style compression of packed reading streams
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string.h>
+#include "ReadingCodec.h"
+
+
+// Zig-zag coding of signed differences
+static inline uint32_t zigzag(int32_t d)
+{
+    return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t z)
+{
+    return (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+}
+
+// Number of significant bits (val > 0)
+static inline int bitLength(uint32_t val)
+{
+    return 32 - __builtin_clz(val);
+}
+
+
+void
+ReadingEncoder::begin(uint8_t *block, size_t len)
+{
+    buf = (len >= CODEC_HEADER_SIZE) ? block : nullptr;
+    size = len;
+    bitPos = 0;
+    overflow = false;
+    n = 0;
+    memset(&prev, 0, sizeof(prev));
+    prevDelta = 0;
+    if (buf) {
+        buf[0] = 0;
+        buf[1] = 0;
+    }
+}
+
+
+void
+ReadingEncoder::putBits(uint32_t val, int bits)
+{
+    while (bits > 0) {
+        size_t byte = CODEC_HEADER_SIZE + bitPos / 8;
+        if (byte >= size) {
+            overflow = true;
+            return;
+        }
+        int avail = 8 - (int)(bitPos % 8);
+        int k = (bits < avail) ? bits : avail;
+        uint8_t mask = (uint8_t)(((1U << k) - 1) << (avail - k));
+        uint8_t chunk = (uint8_t)(((val >> (bits - k)) << (avail - k)) & mask);
+
+        // Clear bits left from a rejected reading
+        buf[byte] = (buf[byte] & ~mask) | chunk;
+        bitPos += k;
+        bits -= k;
+    }
+}
+
+
+void
+ReadingEncoder::putGamma(uint32_t val)
+{
+    int bits = bitLength(val);
+
+    putBits(0, bits - 1);
+    putBits(val, bits);
+}
+
+
+void
+ReadingEncoder::putField(int32_t cur, int32_t last)
+{
+    putGamma(zigzag(cur - last) + 1);
+}
+
+
+bool
+ReadingEncoder::append(const packed_reading_t &p)
+{
+    if (!buf || (n == CODEC_MAX_COUNT))
+        return false;
+
+    size_t start = bitPos;
+    overflow = false;
+
+    // Timestamp - delta-of-delta
+    int64_t delta = (int64_t)p.epoch - prev.epoch;
+    int64_t dod = delta - prevDelta;
+    if (dod == 0) {
+        putBits(0, 1);
+    } else if ((dod >= -63) && (dod <= 64)) {
+        putBits(0x2, 2);
+        putBits((uint32_t)(dod + 63), 7);
+    } else if ((dod >= -255) && (dod <= 256)) {
+        putBits(0x6, 3);
+        putBits((uint32_t)(dod + 255), 9);
+    } else if ((dod >= -2047) && (dod <= 2048)) {
+        putBits(0xE, 4);
+        putBits((uint32_t)(dod + 2047), 12);
+    } else {
+        // Absolute timestamp
+        putBits(0xF, 4);
+        putBits(p.epoch, 32);
+    }
+
+    // Sensor
+    if ((p.sensor_id == prev.sensor_id) && (p.s_type == prev.s_type) && (p.chan == prev.chan)) {
+        putBits(0, 1);
+    } else {
+        putBits(1, 1);
+        putBits(p.sensor_id, 32);
+        putBits(p.s_type, 4);
+        putBits(p.chan, 4);
+    }
+
+    // Flags
+    if (p.flags == prev.flags) {
+        putBits(0, 1);
+    } else {
+        putBits(1, 1);
+        putBits(p.flags, 12);
+    }
+
+    // Fixed-point fields
+    putField(p.temp_dc, prev.temp_dc);
+    putField(p.humidity, prev.humidity);
+    putField(p.wind_dir_deg, prev.wind_dir_deg);
+    putField(p.wind_gust_dms, prev.wind_gust_dms);
+    putField(p.wind_avg_dms, prev.wind_avg_dms);
+    putField(p.rain_dmm, prev.rain_dmm);
+    putField(p.uv_d, prev.uv_d);
+    putField(p.light_lux, prev.light_lux);
+
+    if (overflow) {
+        bitPos = start;
+        return false;
+    }
+
+    prev = p;
+    prevDelta = delta;
+    n++;
+    buf[0] = (uint8_t)n;
+    buf[1] = (uint8_t)(n >> 8);
+    return true;
+}
+
+
+void
+ReadingDecoder::begin(const uint8_t *block, size_t len)
+{
+    buf = (len >= CODEC_HEADER_SIZE) ? block : nullptr;
+    size = len;
+    bitPos = 0;
+    error = false;
+    n = buf ? (uint16_t)(buf[0] | (buf[1] << 8)) : 0;
+    idx = 0;
+    memset(&prev, 0, sizeof(prev));
+    prevDelta = 0;
+}
+
+
+uint32_t
+ReadingDecoder::getBits(int bits)
+{
+    uint32_t val = 0;
+
+    while (bits > 0) {
+        size_t byte = CODEC_HEADER_SIZE + bitPos / 8;
+        if (byte >= size) {
+            error = true;
+            return 0;
+        }
+        int avail = 8 - (int)(bitPos % 8);
+        int k = (bits < avail) ? bits : avail;
+        uint32_t chunk = (buf[byte] >> (avail - k)) & ((1U << k) - 1);
+
+        val = (val << k) | chunk;
+        bitPos += k;
+        bits -= k;
+    }
+    return val;
+}
+
+
+uint32_t
+ReadingDecoder::getGamma(void)
+{
+    int zeros = 0;
+
+    while (getBits(1) == 0) {
+        if (error || (++zeros > 31)) {
+            error = true;
+            return 1;
+        }
+    }
+    return (zeros == 0) ? 1 : (1U << zeros) | getBits(zeros);
+}
+
+
+int32_t
+ReadingDecoder::getField(int32_t last)
+{
+    return last + unzigzag(getGamma() - 1);
+}
+
+
+bool
+ReadingDecoder::next(packed_reading_t &p)
+{
+    if (!buf || error || (idx >= n))
+        return false;
+
+    p = prev;
+
+    // Timestamp
+    int64_t delta;
+    if (getBits(1) == 0) {
+        delta = prevDelta;
+    } else if (getBits(1) == 0) {
+        delta = prevDelta + (int64_t)getBits(7) - 63;
+    } else if (getBits(1) == 0) {
+        delta = prevDelta + (int64_t)getBits(9) - 255;
+    } else if (getBits(1) == 0) {
+        delta = prevDelta + (int64_t)getBits(12) - 2047;
+    } else {
+        delta = (int64_t)getBits(32) - prev.epoch;
+    }
+    p.epoch = (uint32_t)(prev.epoch + delta);
+
+    // Sensor
+    if (getBits(1)) {
+        p.sensor_id = getBits(32);
+        p.s_type = getBits(4);
+        p.chan = getBits(4);
+    }
+
+    // Flags
+    if (getBits(1)) {
+        p.flags = getBits(12);
+    }
+
+    // Fixed-point fields
+    p.temp_dc = (int16_t)getField(prev.temp_dc);
+    p.humidity = (uint8_t)getField(prev.humidity);
+    p.wind_dir_deg = getField(prev.wind_dir_deg);
+    p.wind_gust_dms = getField(prev.wind_gust_dms);
+    p.wind_avg_dms = getField(prev.wind_avg_dms);
+    p.rain_dmm = getField(prev.rain_dmm);
+    p.uv_d = getField(prev.uv_d);
+    p.light_lux = getField(prev.light_lux);
+
+    if (error)
+        return false;
+
+    prev = p;
+    prevDelta = delta;
+    idx++;
+    return true;
+}
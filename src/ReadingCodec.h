@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ReadingCodec.h
+//
+// Gorilla-style compression of packed reading streams
+//
+// A block is a 2-byte reading count (little endian) followed by a bit stream. Each reading
+// is coded relative to the previous one (the first one relative to an all-zero reading):
+//
+// - timestamp: delta-of-delta of the timestamps (sensors transmit with a near-constant
+//   period), bucketed as in Facebook's Gorilla:
+//   '0' (0), '10' + 7 bits, '110' + 9 bits, '1110' + 12 bits, '1111' + 32 bits
+// - sensor ID, type and channel: '0' if unchanged, otherwise '1' + 32 + 4 + 4 bits
+// - flags: '0' if unchanged, otherwise '1' + 12 bits
+// - each fixed-point field: difference to the previous value, zig-zag coded and written as
+//   Elias gamma code of (value + 1) - i.e. '1' if unchanged, 3 bits for +-1, 5 bits
+//   for -4...+3, ...
+//
+// Bits are written MSB first. Encoder and decoder keep only the previous reading and timestamp
+// delta (O(1) working memory); the block buffer is provided by the caller. A reading that does
+// not fit into the remaining space is rejected and the block stays valid.
+//
+// Typical weather sensor series (12 s period, slowly changing values) take about 4 bytes
+// per reading, compared to 24 bytes for packed_reading_t.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _READING_CODEC_H
+#define _READING_CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "PackedReading.h"
+
+/**
+ * Size of block header (reading count) in bytes
+ */
+#define CODEC_HEADER_SIZE 2
+
+/**
+ * Maximum number of readings per block
+ */
+#define CODEC_MAX_COUNT 0xFFFF
+
+
+/**
+ * \class ReadingEncoder
+ *
+ * \brief Streaming encoder of packed readings into a caller-provided block buffer
+ */
+class ReadingEncoder {
+private:
+    uint8_t *buf;                       //!< block buffer
+    size_t   size;                      //!< size of block buffer in bytes
+    size_t   bitPos;                    //!< write position in bits (from start of bit stream)
+    bool     overflow;                  //!< write exceeded buffer
+    uint16_t n;                         //!< number of readings
+    packed_reading_t prev;              //!< previous reading
+    int64_t  prevDelta;                 //!< previous timestamp delta
+
+    void putBits(uint32_t val, int bits);
+    void putGamma(uint32_t val);
+    void putField(int32_t cur, int32_t last);
+
+public:
+    /**
+     * Constructor
+     */
+    ReadingEncoder()
+    {
+        begin(nullptr, 0);
+    };
+
+    /**
+     * \brief Start new block
+     *
+     * \param block     block buffer
+     * \param len       size of block buffer in bytes (at least CODEC_HEADER_SIZE)
+     */
+    void begin(uint8_t *block, size_t len);
+
+    /**
+     * \brief Append reading
+     *
+     * \param p         packed reading
+     *
+     * \returns false if the reading does not fit into the block (block unchanged)
+     */
+    bool append(const packed_reading_t &p);
+
+    /**
+     * \brief Number of readings in block
+     */
+    uint16_t count(void) const
+    {
+        return n;
+    };
+
+    /**
+     * \brief Used size of block in bytes
+     */
+    size_t bytes(void) const
+    {
+        return (buf == nullptr) ? 0 : CODEC_HEADER_SIZE + (bitPos + 7) / 8;
+    };
+};
+
+
+/**
+ * \class ReadingDecoder
+ *
+ * \brief Streaming decoder of a block of packed readings
+ */
+class ReadingDecoder {
+private:
+    const uint8_t *buf;                 //!< block buffer
+    size_t   size;                      //!< size of block in bytes
+    size_t   bitPos;                    //!< read position in bits (from start of bit stream)
+    bool     error;                     //!< read beyond end of block
+    uint16_t n;                         //!< number of readings in block
+    uint16_t idx;                       //!< number of readings decoded
+    packed_reading_t prev;              //!< previous reading
+    int64_t  prevDelta;                 //!< previous timestamp delta
+
+    uint32_t getBits(int bits);
+    uint32_t getGamma(void);
+    int32_t  getField(int32_t last);
+
+public:
+    /**
+     * Constructor
+     */
+    ReadingDecoder()
+    {
+        begin(nullptr, 0);
+    };
+
+    /**
+     * \brief Start decoding of block
+     *
+     * \param block     block buffer
+     * \param len       size of block in bytes
+     */
+    void begin(const uint8_t *block, size_t len);
+
+    /**
+     * \brief Decode next reading
+     *
+     * \param p         decoded reading
+     *
+     * \returns false at end of block or if the block is truncated/corrupt
+     */
+    bool next(packed_reading_t &p);
+
+    /**
+     * \brief Number of readings in block
+     */
+    uint16_t count(void) const
+    {
+        return n;
+    };
+};
+
+#endif
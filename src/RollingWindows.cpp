@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RollingWindows.cpp
+//
+// Sliding-window sums over arbitrary time windows from a single update stream
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "RollingWindows.h"
+
+const uint32_t RollingWindows::secs[ROLLING_LEVELS] = {
+    ROLLING_L0_SECS, ROLLING_L1_SECS, ROLLING_L2_SECS
+};
+
+const uint16_t RollingWindows::buckets[ROLLING_LEVELS] = {
+    ROLLING_L0_BUCKETS, ROLLING_L1_BUCKETS, ROLLING_L2_BUCKETS
+};
+
+
+void
+RollingWindows::reset(void)
+{
+    for (int l = 0; l < ROLLING_LEVELS; l++) {
+        first[l] = 0;
+        last[l] = 0;
+    }
+    total = 0;
+    lastUpdate = 0;
+}
+
+
+void
+RollingWindows::update(time_t timestamp, uint16_t delta)
+{
+    if (lastUpdate == 0) {
+        for (int l = 0; l < ROLLING_LEVELS; l++) {
+            uint32_t b = timestamp / secs[l];
+            first[l] = b;
+            last[l] = b;
+            ring(l)[b % buckets[l]] = total;
+        }
+        lastUpdate = timestamp;
+    }
+
+    if (timestamp > lastUpdate) {
+        for (int l = 0; l < ROLLING_LEVELS; l++) {
+            uint32_t b = timestamp / secs[l];
+            if (b == last[l])
+                continue;
+
+            // Buckets started since the previous update begin with the current total
+            uint32_t k = (b - last[l] > buckets[l]) ? b - buckets[l] + 1 : last[l] + 1;
+            uint16_t *cum = ring(l);
+            for (; k <= b; k++) {
+                cum[k % buckets[l]] = total;
+            }
+            last[l] = b;
+        }
+        lastUpdate = timestamp;
+    }
+
+    total += delta;
+}
+
+
+uint16_t
+RollingWindows::sum(uint32_t seconds, bool *valid) const
+{
+    bool ok = true;
+
+    if (lastUpdate == 0) {
+        if (valid)
+            *valid = false;
+        return 0;
+    }
+
+    if (seconds > ROLLING_MAX_WINDOW) {
+        seconds = ROLLING_MAX_WINDOW;
+        ok = false;
+    }
+
+    // Finest level whose ring covers the window (rounded up by one bucket)
+    int l = 0;
+    while ((l < ROLLING_LEVELS - 1) && (seconds + secs[l] / 2 > (uint32_t)(buckets[l] - 1) * secs[l])) {
+        l++;
+    }
+
+    // Start of window rounded to the nearest bucket boundary
+    uint32_t b0 = (lastUpdate > (time_t)seconds) ? (uint32_t)((lastUpdate - seconds + secs[l] / 2) / secs[l]) : 0;
+    if (b0 < first[l]) {
+        // Window starts before first update
+        b0 = first[l];
+        ok = false;
+    }
+    if (valid)
+        *valid = ok;
+
+    if (b0 > last[l]) {
+        return 0;
+    }
+    return (uint16_t)(total - ring(l)[b0 % buckets[l]]);
+}
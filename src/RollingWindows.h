@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RollingWindows.h
+//
+// Sliding-window sums over arbitrary time windows from a single update stream
+//
+// A monotonic total of all deltas (modulo 2^16) is kept together with a few levels of
+// cumulative buckets: each level stores the total at the start of each of its buckets
+// (e.g. minutes, quarter hours, three hours) in a ring. The sum over a window is the current
+// total minus the total at the window start, taken from the finest level whose ring covers
+// the window. An update touches each level once (plus buckets skipped since the previous
+// update), so its cost does not depend on the number of windows queried; a query is O(1).
+// The window start is rounded to the nearest bucket boundary of the selected level.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ROLLING_WINDOWS_H
+#define ROLLING_WINDOWS_H
+
+#include <stdint.h>
+#include <time.h>
+
+// Bucket levels: bucket length in seconds and number of buckets
+#define ROLLING_LEVELS      3
+#define ROLLING_L0_SECS     60      // 1 min
+#define ROLLING_L0_BUCKETS  64      // > 1 h
+#define ROLLING_L1_SECS     900     // 15 min
+#define ROLLING_L1_BUCKETS  104     // > 1 d
+#define ROLLING_L2_SECS     10800   // 3 h
+#define ROLLING_L2_BUCKETS  64      // > 1 week
+
+/**
+ * Longest window supported (seconds)
+ */
+#define ROLLING_MAX_WINDOW  ((ROLLING_L2_BUCKETS - 1) * ROLLING_L2_SECS)
+
+
+/**
+ * \class RollingWindows
+ *
+ * \brief Sums of deltas over arbitrary past time windows
+ *
+ * The sum over a window must not exceed 65535 (units of delta).
+ */
+class RollingWindows {
+private:
+    uint16_t cum0[ROLLING_L0_BUCKETS];  //!< level 0: total at start of bucket
+    uint16_t cum1[ROLLING_L1_BUCKETS];  //!< level 1: total at start of bucket
+    uint16_t cum2[ROLLING_L2_BUCKETS];  //!< level 2: total at start of bucket
+    uint32_t first[ROLLING_LEVELS];     //!< first bucket recorded per level
+    uint32_t last[ROLLING_LEVELS];      //!< current bucket per level
+    uint16_t total;                     //!< total of all deltas (modulo 2^16)
+    time_t   lastUpdate;                //!< timestamp of last update (0: no update yet)
+
+    static const uint32_t secs[ROLLING_LEVELS];
+    static const uint16_t buckets[ROLLING_LEVELS];
+
+    uint16_t *ring(int level)
+    {
+        return (level == 0) ? cum0 : (level == 1) ? cum1 : cum2;
+    };
+
+    const uint16_t *ring(int level) const
+    {
+        return (level == 0) ? cum0 : (level == 1) ? cum1 : cum2;
+    };
+
+public:
+    /**
+     * Constructor
+     */
+    RollingWindows()
+    {
+        reset();
+    };
+
+    /**
+     * Discard all data
+     */
+    void reset(void);
+
+    /**
+     * \brief Add delta at timestamp
+     *
+     * Updates with a timestamp older than the previous one are added to the current bucket.
+     *
+     * \param timestamp     timestamp
+     * \param delta         increment (e.g. rain in 0.1 mm or number of events)
+     */
+    void update(time_t timestamp, uint16_t delta);
+
+    /**
+     * \brief Sum of deltas in window ending at last update
+     *
+     * \param seconds   window length in seconds (max. ROLLING_MAX_WINDOW)
+     * \param valid     (optional) false if the window exceeds the time covered by updates
+     *                  (sum is then taken since the first update) or ROLLING_MAX_WINDOW
+     *
+     * \returns sum of deltas
+     */
+    uint16_t sum(uint32_t seconds, bool *valid = nullptr) const;
+
+    /**
+     * \brief Timestamp of last update (0: no update yet)
+     */
+    time_t updated(void) const
+    {
+        return lastUpdate;
+    };
+};
+
+#endif
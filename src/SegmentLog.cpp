@@ -0,0 +1,425 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SegmentLog.cpp
+//
+// Append-only log of readings in a file system, split into segments with a time index
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Journal synced after each record, rebuilt after a failed write
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "SegmentLog.h"
+#include "PersistentBlob.h"
+
+
+SegmentLog::SegmentLog(const char *directory)
+{
+    strncpy(dir, directory, sizeof(dir) - 1);
+    dir[sizeof(dir) - 1] = '\0';
+    segs = 0;
+    seq = 0;
+    journal = nullptr;
+    journalValid = true;
+    jnlErrors = 0;
+    ready = false;
+    crcErrors = 0;
+    reads = 0;
+    startSegment();
+}
+
+
+void
+SegmentLog::path(char *buf, uint32_t s, const char *ext) const
+{
+    snprintf(buf, SEGMENT_PATH_SIZE, "%s/%08lX.%s", dir, (unsigned long)s, ext);
+}
+
+
+void
+SegmentLog::startSegment(void)
+{
+    enc.begin(block, sizeof(block));
+    minTs = UINT32_MAX;
+    maxTs = 0;
+}
+
+
+bool
+SegmentLog::begin(void)
+{
+    char name[SEGMENT_PATH_SIZE];
+    bool haveJournal = false;
+    uint32_t jnlSeq = 0;
+
+    end();
+    segs = 0;
+    seq = 0;
+    startSegment();
+
+    if ((mkdir(dir, 0777) != 0) && (errno != EEXIST)) {
+        log_e("Cannot create %s", dir);
+        return false;
+    }
+    DIR *d = opendir(dir);
+    if (!d) {
+        log_e("Cannot open %s", dir);
+        return false;
+    }
+
+    struct dirent *e;
+    while ((e = readdir(d)) != nullptr) {
+        unsigned long s;
+        char ext[4];
+        if ((strlen(e->d_name) != 12) || (sscanf(e->d_name, "%8lx.%3s", &s, ext) != 2))
+            continue;
+
+        if (strcmp(ext, "tmp") == 0) {
+            // Incomplete seal - the journal is still there
+            path(name, s, "tmp");
+            remove(name);
+        } else if (strcmp(ext, "jnl") == 0) {
+            if (haveJournal) {
+                // Only the newest journal can be valid
+                path(name, (s > jnlSeq) ? jnlSeq : s, "jnl");
+                remove(name);
+            }
+            if (!haveJournal || (s > jnlSeq))
+                jnlSeq = s;
+            haveJournal = true;
+        } else if (strcmp(ext, "seg") == 0) {
+            segment_header_t h;
+            path(name, s, "seg");
+            FILE *f = fopen(name, "rb");
+            bool ok = f && (fread(&h, sizeof(h), 1, f) == 1) && (h.magic == SEGMENT_MAGIC) &&
+                      (h.version == SEGMENT_VERSION);
+            if (f)
+                fclose(f);
+            if (!ok) {
+                log_w("Corrupt segment %s deleted", name);
+                crcErrors++;
+                remove(name);
+                continue;
+            }
+            if (segs == SEGMENT_LOG_MAX_SEGMENTS) {
+                // Index full - replace the oldest segment if this one is newer
+                int oldest = 0;
+                for (int i = 1; i < segs; i++) {
+                    if (index[i].seq < index[oldest].seq)
+                        oldest = i;
+                }
+                uint32_t drop = (s < index[oldest].seq) ? s : index[oldest].seq;
+                path(name, drop, "seg");
+                remove(name);
+                if (drop == s)
+                    continue;
+                index[oldest] = index[--segs];
+            }
+            index[segs].seq = s;
+            index[segs].min_ts = h.min_ts;
+            index[segs].max_ts = h.max_ts;
+            index[segs].count = h.count;
+            segs++;
+        }
+    }
+    closedir(d);
+
+    // Sort index by segment number (insertion sort - directory order is mostly sorted)
+    for (int i = 1; i < segs; i++) {
+        segment_index_t tmp = index[i];
+        int k = i - 1;
+        while ((k >= 0) && (index[k].seq > tmp.seq)) {
+            index[k + 1] = index[k];
+            k--;
+        }
+        index[k + 1] = tmp;
+    }
+    seq = (segs > 0) ? index[segs - 1].seq + 1 : 0;
+
+    // Recover active segment from journal
+    if (haveJournal) {
+        path(name, jnlSeq, "jnl");
+        if (jnlSeq < seq) {
+            // Segment was sealed, but the journal not deleted
+            remove(name);
+        } else {
+            seq = jnlSeq;
+            FILE *f = fopen(name, "rb");
+            packed_reading_t p;
+            while (f && (fread(&p, sizeof(p), 1, f) == 1) && enc.append(p)) {
+                if (p.epoch < minTs)
+                    minTs = p.epoch;
+                if (p.epoch > maxTs)
+                    maxTs = p.epoch;
+            }
+            if (f)
+                fclose(f);
+            log_d("Recovered %u readings from %s", enc.count(), name);
+        }
+    }
+
+    ready = true;
+    return true;
+}
+
+
+void
+SegmentLog::end(void)
+{
+    if (journal) {
+        fclose(journal);
+        journal = nullptr;
+    }
+    ready = false;
+}
+
+
+void
+SegmentLog::dropOldest(void)
+{
+    char name[SEGMENT_PATH_SIZE];
+
+    path(name, index[0].seq, "seg");
+    remove(name);
+    memmove(&index[0], &index[1], (segs - 1) * sizeof(segment_index_t));
+    segs--;
+}
+
+
+bool
+SegmentLog::seal(void)
+{
+    char tmp[SEGMENT_PATH_SIZE];
+    char name[SEGMENT_PATH_SIZE];
+    segment_header_t h;
+
+    if (enc.count() == 0)
+        return true;
+
+    h.magic = SEGMENT_MAGIC;
+    h.version = SEGMENT_VERSION;
+    h.count = enc.count();
+    h.min_ts = minTs;
+    h.max_ts = maxTs;
+    h.length = enc.bytes();
+    h.crc = crc32(0, block, h.length);
+
+    path(tmp, seq, "tmp");
+    FILE *f = fopen(tmp, "wb");
+    bool ok = f && (fwrite(&h, sizeof(h), 1, f) == 1) && (fwrite(block, h.length, 1, f) == 1);
+    if (f && (fclose(f) != 0))
+        ok = false;
+    path(name, seq, "seg");
+    if (!ok || (rename(tmp, name) != 0)) {
+        log_e("Cannot write %s", name);
+        remove(tmp);
+        return false;
+    }
+
+    // Segment is durable - journal no longer required
+    if (journal) {
+        fclose(journal);
+        journal = nullptr;
+    }
+    path(name, seq, "jnl");
+    remove(name);
+    journalValid = true;
+
+    if (segs == SEGMENT_LOG_MAX_SEGMENTS)
+        dropOldest();
+    index[segs].seq = seq;
+    index[segs].min_ts = minTs;
+    index[segs].max_ts = maxTs;
+    index[segs].count = h.count;
+    segs++;
+
+    seq++;
+    startSegment();
+    return true;
+}
+
+
+bool
+SegmentLog::append(const packed_reading_t &p)
+{
+    if (!ready)
+        return false;
+
+    if (!enc.append(p)) {
+        // Segment full
+        if (!seal() || !enc.append(p))
+            return false;
+    }
+
+    if (p.epoch < minTs)
+        minTs = p.epoch;
+    if (p.epoch > maxTs)
+        maxTs = p.epoch;
+
+    // The reading is stored - a journal error only affects recovery after a restart
+    if (!writeJournal(p)) {
+        log_e("Cannot write journal");
+        jnlErrors++;
+    }
+    return true;
+}
+
+
+bool
+SegmentLog::writeJournal(const packed_reading_t &p)
+{
+    char name[SEGMENT_PATH_SIZE];
+
+    path(name, seq, "jnl");
+    if (!journalValid) {
+        // A failed write may have left a partial record - rebuild from the active segment
+        // (which already contains p)
+        if (journal) {
+            fclose(journal);
+        }
+        journal = fopen(name, "wb");
+        bool ok = (journal != nullptr);
+        if (ok) {
+            ReadingDecoder dec;
+            packed_reading_t r;
+            dec.begin(block, enc.bytes());
+            while (ok && dec.next(r)) {
+                ok = (fwrite(&r, sizeof(r), 1, journal) == 1);
+            }
+        }
+        journalValid = ok && (fflush(journal) == 0) && (fsync(fileno(journal)) == 0);
+        return journalValid;
+    }
+
+    if (!journal) {
+        journal = fopen(name, "ab");
+    }
+    // fflush() moves the record to the VFS only - fsync() writes it to flash
+    journalValid = journal && (fwrite(&p, sizeof(p), 1, journal) == 1) && (fflush(journal) == 0) &&
+                   (fsync(fileno(journal)) == 0);
+    return journalValid;
+}
+
+
+bool
+SegmentLog::readSegment(const segment_index_t &idx, size_t &len)
+{
+    char name[SEGMENT_PATH_SIZE];
+    segment_header_t h;
+
+    path(name, idx.seq, "seg");
+    FILE *f = fopen(name, "rb");
+    if (!f)
+        return false;
+
+    bool ok = (fread(&h, sizeof(h), 1, f) == 1) && (h.magic == SEGMENT_MAGIC) &&
+              (h.version == SEGMENT_VERSION) && (h.length <= sizeof(readBuf)) &&
+              (fread(readBuf, h.length, 1, f) == 1) && (crc32(0, readBuf, h.length) == h.crc);
+    fclose(f);
+    reads++;
+    if (!ok) {
+        log_w("Corrupt segment %s", name);
+        crcErrors++;
+        return false;
+    }
+    len = h.length;
+    return true;
+}
+
+
+size_t
+SegmentLog::scan(ReadingDecoder &dec, uint32_t id, uint32_t from, uint32_t to,
+                 packed_reading_t *out, size_t max)
+{
+    size_t n = 0;
+    packed_reading_t p;
+
+    while ((n < max) && dec.next(p)) {
+        if (((id == 0) || (p.sensor_id == id)) && (p.epoch >= from) && (p.epoch <= to))
+            out[n++] = p;
+    }
+    return n;
+}
+
+
+size_t
+SegmentLog::query(uint32_t id, uint32_t from, uint32_t to, packed_reading_t *out, size_t max)
+{
+    ReadingDecoder dec;
+    size_t n = 0;
+    size_t len;
+
+    for (int i = 0; (i < segs) && (n < max); i++) {
+        if ((index[i].max_ts < from) || (index[i].min_ts > to))
+            continue;
+        if (!readSegment(index[i], len))
+            continue;
+        dec.begin(readBuf, len);
+        n += scan(dec, id, from, to, &out[n], max - n);
+    }
+
+    if ((n < max) && (enc.count() > 0) && (maxTs >= from) && (minTs <= to)) {
+        dec.begin(block, enc.bytes());
+        n += scan(dec, id, from, to, &out[n], max - n);
+    }
+    return n;
+}
+
+
+size_t
+SegmentLog::retain(uint32_t oldest)
+{
+    char name[SEGMENT_PATH_SIZE];
+    size_t n = 0;
+    int k = 0;
+
+    for (int i = 0; i < segs; i++) {
+        if (index[i].max_ts < oldest) {
+            path(name, index[i].seq, "seg");
+            remove(name);
+            n++;
+        } else {
+            index[k++] = index[i];
+        }
+    }
+    segs = k;
+    return n;
+}
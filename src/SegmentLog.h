@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SegmentLog.h
+//
+// Append-only log of readings in a file system, split into segments with a time index
+//
+// Readings are appended to the active segment, which is encoded in RAM (see ReadingCodec.h)
+// and journaled as raw packed_reading_t records to <seq>.jnl, so it can be rebuilt after
+// a restart. The journal is synced (fsync(), i.e. lfs_file_sync() on ESP32) after each
+// record - fflush() only moves the data to the file system's cache. After a failed journal
+// write, the journal is rebuilt from the active segment by the next append(). When the encoded block is full (SEGMENT_LOG_BLOCK_SIZE), the segment is sealed:
+// written to <seq>.tmp with a header (count, min./max. timestamp, CRC-32 of the data),
+// renamed to <seq>.seg, and the journal is deleted. Each reading is thus written twice -
+// 24 bytes to the journal and about 4 bytes to its segment.
+//
+// The headers of all sealed segments are kept in an index in RAM (rebuilt by begin()).
+// Range queries skip segments by their timestamp range and check the CRC of the segments
+// read. Retention is by deleting whole segments - the oldest ones if the number of segments
+// exceeds SEGMENT_LOG_MAX_SEGMENTS or by retain().
+//
+// The file system is accessed via stdio, i.e. on ESP32 the LittleFS partition mounted to
+// the VFS (e.g. LittleFS.begin() - mounted at /littlefs).
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Journal synced after each record, added journalErrors()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _SEGMENT_LOG_H
+#define _SEGMENT_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "WeatherSensorCfg.h"
+#include "PackedReading.h"
+#include "ReadingCodec.h"
+
+#if !defined(SEGMENT_LOG_BLOCK_SIZE)
+    #define SEGMENT_LOG_BLOCK_SIZE 2048
+#endif
+
+#if !defined(SEGMENT_LOG_MAX_SEGMENTS)
+    #define SEGMENT_LOG_MAX_SEGMENTS 128
+#endif
+
+/**
+ * Magic number of segment header ("BWSG")
+ */
+#define SEGMENT_MAGIC 0x42575347
+
+/**
+ * Segment format version
+ */
+#define SEGMENT_VERSION 1
+
+/**
+ * Max. length of file path
+ */
+#define SEGMENT_PATH_SIZE 64
+
+
+/**
+ * \brief Header of sealed segment file (followed by the encoded block)
+ */
+typedef struct SegmentHeader {
+    uint32_t magic;                     //!< SEGMENT_MAGIC
+    uint16_t version;                   //!< SEGMENT_VERSION
+    uint16_t count;                     //!< number of readings
+    uint32_t min_ts;                    //!< oldest timestamp
+    uint32_t max_ts;                    //!< newest timestamp
+    uint32_t length;                    //!< length of encoded block in bytes
+    uint32_t crc;                       //!< CRC-32 of encoded block
+} segment_header_t;
+
+/**
+ * \brief Index entry of sealed segment
+ */
+typedef struct SegmentIndex {
+    uint32_t seq;                       //!< segment number
+    uint32_t min_ts;                    //!< oldest timestamp
+    uint32_t max_ts;                    //!< newest timestamp
+    uint16_t count;                     //!< number of readings
+} segment_index_t;
+
+
+/**
+ * \class SegmentLog
+ *
+ * \brief Append-only segmented log of packed readings with time index
+ */
+class SegmentLog {
+private:
+    char     dir[SEGMENT_PATH_SIZE - 16];   //!< directory
+    segment_index_t index[SEGMENT_LOG_MAX_SEGMENTS]; //!< sealed segments (oldest first)
+    uint16_t segs;                      //!< number of sealed segments
+    uint32_t seq;                       //!< number of active segment
+    uint8_t  block[SEGMENT_LOG_BLOCK_SIZE]; //!< active segment (encoded)
+    uint8_t  readBuf[SEGMENT_LOG_BLOCK_SIZE]; //!< sealed segment read by query()
+    ReadingEncoder enc;                 //!< encoder of active segment
+    uint32_t minTs;                     //!< oldest timestamp in active segment
+    uint32_t maxTs;                     //!< newest timestamp in active segment
+    FILE    *journal;                   //!< journal of active segment
+    bool     journalValid;              //!< journal matches active segment
+    uint32_t jnlErrors;                 //!< number of failed journal writes
+    bool     ready;                     //!< begin() succeeded
+    uint32_t crcErrors;                 //!< number of corrupt segments found
+    uint32_t reads;                     //!< number of segments read by query()
+
+    void path(char *buf, uint32_t s, const char *ext) const;
+    void startSegment(void);
+    bool seal(void);
+    bool writeJournal(const packed_reading_t &p);
+    void dropOldest(void);
+    bool readSegment(const segment_index_t &idx, size_t &len);
+    static size_t scan(ReadingDecoder &dec, uint32_t id, uint32_t from, uint32_t to,
+                       packed_reading_t *out, size_t max);
+
+public:
+    /**
+     * \brief Constructor
+     *
+     * \param directory     log directory (e.g. SEGMENT_LOG_DIR)
+     */
+    SegmentLog(const char *directory);
+
+    /**
+     * Destructor
+     */
+    ~SegmentLog()
+    {
+        end();
+    };
+
+    /**
+     * \brief Open log - create directory, build index and recover active segment from journal
+     *
+     * \returns false if the directory is not accessible
+     */
+    bool begin(void);
+
+    /**
+     * Close journal (the active segment is recovered by the next begin())
+     */
+    void end(void);
+
+    /**
+     * \brief Append reading
+     *
+     * \param p         packed reading
+     *
+     * If the journal cannot be written, the reading is kept in the active segment
+     * (lost on restart before the segment is sealed) and counted by journalErrors().
+     *
+     * \returns false if the reading could not be stored
+     */
+    bool append(const packed_reading_t &p);
+
+    /**
+     * \brief Read readings of a time range
+     *
+     * Sealed segments are skipped by their timestamp range; corrupt segments are skipped.
+     *
+     * \param id        sensor ID (0: all sensors)
+     * \param from      start of range (UTC, seconds since epoch, inclusive)
+     * \param to        end of range (UTC, seconds since epoch, inclusive)
+     * \param out       destination buffer
+     * \param max       size of destination buffer (readings)
+     *
+     * \returns number of readings copied (in log order)
+     */
+    size_t query(uint32_t id, uint32_t from, uint32_t to, packed_reading_t *out, size_t max);
+
+    /**
+     * \brief Delete sealed segments with readings older than the given time only
+     *
+     * \param oldest    oldest timestamp to keep
+     *
+     * \returns number of segments deleted
+     */
+    size_t retain(uint32_t oldest);
+
+    /**
+     * \brief Number of sealed segments
+     */
+    uint16_t segments(void) const
+    {
+        return segs;
+    };
+
+    /**
+     * \brief Number of readings in active segment
+     */
+    uint16_t pending(void) const
+    {
+        return enc.count();
+    };
+
+    /**
+     * \brief Number of corrupt segments found (CRC or header mismatch)
+     */
+    uint32_t corrupt(void) const
+    {
+        return crcErrors;
+    };
+
+    /**
+     * \brief Number of failed journal writes
+     */
+    uint32_t journalErrors(void) const
+    {
+        return jnlErrors;
+    };
+
+    /**
+     * \brief Number of sealed segments read by query() - for checking index skipping
+     */
+    uint32_t segmentsRead(void) const
+    {
+        return reads;
+    };
+};
+
+#endif
@@ -0,0 +1,244 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SensorTable.cpp
+//
+// Fixed-capacity table of per-sensor state, keyed by sensor ID
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Added non-const at()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "SensorTable.h"
+
+#define NIL 0xFF
+
+
+void
+SensorTable::clear(void)
+{
+    memset(entries, 0, sizeof(entries));
+    memset(index, 0, sizeof(index));
+    mru = NIL;
+    lru = NIL;
+    count = 0;
+    evictions = 0;
+}
+
+
+int
+SensorTable::findSlot(uint32_t id) const
+{
+    uint8_t slot = hash(id);
+
+    for (int i = 0; i < SENSOR_TABLE_SLOTS; i++) {
+        uint8_t e = index[slot];
+        if (e == 0) {
+            return -1;
+        }
+        if (entries[e - 1].sensor_id == id) {
+            return slot;
+        }
+        slot = (slot + 1) & (SENSOR_TABLE_SLOTS - 1);
+    }
+    return -1;
+}
+
+
+void
+SensorTable::unlink(uint8_t e)
+{
+    if (prev[e] != NIL) {
+        next[prev[e]] = next[e];
+    } else {
+        mru = next[e];
+    }
+    if (next[e] != NIL) {
+        prev[next[e]] = prev[e];
+    } else {
+        lru = prev[e];
+    }
+}
+
+
+void
+SensorTable::pushFront(uint8_t e)
+{
+    prev[e] = NIL;
+    next[e] = mru;
+    if (mru != NIL) {
+        prev[mru] = e;
+    }
+    mru = e;
+    if (lru == NIL) {
+        lru = e;
+    }
+}
+
+
+void
+SensorTable::removeSlot(int slot)
+{
+    // Backward shift deletion - keeps probe sequences intact without tombstones
+    uint8_t hole = slot;
+    uint8_t i = slot;
+
+    index[hole] = 0;
+    for (;;) {
+        i = (i + 1) & (SENSOR_TABLE_SLOTS - 1);
+        uint8_t e = index[i];
+        if (e == 0) {
+            break;
+        }
+        uint8_t home = hash(entries[e - 1].sensor_id);
+        // Move entry into the hole if its home slot is not cyclically within (hole, i]
+        bool inRange = (hole <= i) ? ((home > hole) && (home <= i)) : ((home > hole) || (home <= i));
+        if (!inRange) {
+            index[hole] = e;
+            index[i] = 0;
+            hole = i;
+        }
+    }
+}
+
+
+sensor_state_t *
+SensorTable::find(uint32_t id)
+{
+    int slot = findSlot(id);
+
+    if (slot < 0) {
+        return nullptr;
+    }
+    uint8_t e = index[slot] - 1;
+    if (e != mru) {
+        unlink(e);
+        pushFront(e);
+    }
+    return &entries[e];
+}
+
+
+sensor_state_t *
+SensorTable::lookup(uint32_t id, bool *created)
+{
+    sensor_state_t *state = find(id);
+
+    if (created) {
+        *created = (state == nullptr);
+    }
+    if (state) {
+        return state;
+    }
+
+    uint8_t e;
+    if (count < SENSOR_TABLE_SIZE) {
+        // Entries are allocated in order and compacted on removal
+        e = count++;
+    } else {
+        // Evict least recently used entry
+        e = lru;
+        removeSlot(findSlot(entries[e].sensor_id));
+        unlink(e);
+        evictions++;
+    }
+
+    memset(&entries[e], 0, sizeof(sensor_state_t));
+    entries[e].sensor_id = id;
+
+    uint8_t slot = hash(id);
+    while (index[slot] != 0) {
+        slot = (slot + 1) & (SENSOR_TABLE_SLOTS - 1);
+    }
+    index[slot] = e + 1;
+    pushFront(e);
+
+    return &entries[e];
+}
+
+
+bool
+SensorTable::remove(uint32_t id)
+{
+    int slot = findSlot(id);
+
+    if (slot < 0) {
+        return false;
+    }
+    uint8_t e = index[slot] - 1;
+    removeSlot(slot);
+    unlink(e);
+    count--;
+
+    // Move last entry into the gap to keep entries[0...count-1] in use
+    if (e != count) {
+        uint8_t last = count;
+        entries[e] = entries[last];
+        index[findSlot(entries[e].sensor_id)] = e + 1;
+        prev[e] = prev[last];
+        next[e] = next[last];
+        if (prev[e] != NIL) {
+            next[prev[e]] = e;
+        } else {
+            mru = e;
+        }
+        if (next[e] != NIL) {
+            prev[next[e]] = e;
+        } else {
+            lru = e;
+        }
+    }
+    return true;
+}
+
+
+const sensor_state_t *
+SensorTable::at(uint8_t rank) const
+{
+    uint8_t e = mru;
+
+    while ((e != NIL) && rank--) {
+        e = next[e];
+    }
+    return (e != NIL) ? &entries[e] : nullptr;
+}
+
+
+sensor_state_t *
+SensorTable::at(uint8_t rank)
+{
+    return const_cast<sensor_state_t *>(static_cast<const SensorTable *>(this)->at(rank));
+}
@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SensorTable.h
+//
+// Fixed-capacity table of per-sensor state, keyed by sensor ID
+//
+// Open addressing (linear probing, backward shift deletion) over an index array of twice the
+// capacity, with the entries themselves kept in a separate array. A doubly linked list through
+// the entries tracks the usage order; when the table is full, the least recently used entry is
+// evicted. Lookup, insertion and eviction are O(1) (expected).
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Replaced rain_prev by RainAccumulator
+//          Last reading stored as packed_reading_t
+// 20261019 Added rain rate estimator
+// 20261019 Added interval aggregator
+// 20261019 Replaced RSSI statistics by LinkStats
+// 20261019 Added non-const at()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SENSOR_TABLE_H
+#define SENSOR_TABLE_H
+
+#include <stdint.h>
+#include "WeatherSensorCfg.h"
+#include "WeatherSensor.h"
+#include "PackedReading.h"
+#include "RainAccumulator.h"
+#include "RainRate.h"
+#include "IntervalAggregator.h"
+#include "LinkStats.h"
+
+// Number of hash index slots - power of two, at least twice the capacity
+#define SENSOR_TABLE_SLOTS 32
+
+#if (SENSOR_TABLE_SIZE > 127) || (SENSOR_TABLE_SLOTS < 2 * SENSOR_TABLE_SIZE) || \
+    ((SENSOR_TABLE_SLOTS & (SENSOR_TABLE_SLOTS - 1)) != 0)
+    #error "Invalid SENSOR_TABLE_SIZE/SENSOR_TABLE_SLOTS"
+#endif
+
+/**
+ * \brief State kept per sensor
+ */
+typedef struct SensorState {
+    uint32_t       sensor_id;       //!< sensor ID
+    packed_reading_t last;          //!< last reading
+    RainAccumulator rain;           //!< rain gauge baseline and accumulated rain
+    RainRate       rain_rate;       //!< rain rate estimator
+    IntervalAggregator agg;         //!< interval summaries
+    uint64_t       rain_published;  //!< accumulated rain at last published reading in 0.1 mm
+    int64_t        last_mono_us;    //!< monotonic time of last published reading
+    LinkStats      link;            //!< radio link statistics
+    uint32_t       frames;          //!< number of frames received
+    uint32_t       published;       //!< number of readings published
+} sensor_state_t;
+
+
+/**
+ * \class SensorTable
+ *
+ * \brief Fixed-capacity hash table from sensor ID to sensor_state_t with LRU eviction
+ */
+class SensorTable {
+private:
+    sensor_state_t entries[SENSOR_TABLE_SIZE];  //!< entry storage
+    uint8_t index[SENSOR_TABLE_SLOTS];          //!< hash index: entry number + 1, 0: empty
+    uint8_t prev[SENSOR_TABLE_SIZE];            //!< usage list - towards most recently used
+    uint8_t next[SENSOR_TABLE_SIZE];            //!< usage list - towards least recently used
+    uint8_t mru;                                //!< most recently used entry
+    uint8_t lru;                                //!< least recently used entry
+    uint8_t count;                              //!< number of entries in use
+    uint32_t evictions;                         //!< number of entries evicted
+
+    static uint8_t hash(uint32_t id)
+    {
+        // Fibonacci hashing
+        return (uint8_t)((uint32_t)(id * 2654435769U) >> 24) & (SENSOR_TABLE_SLOTS - 1);
+    };
+
+    int  findSlot(uint32_t id) const;
+    void unlink(uint8_t e);
+    void pushFront(uint8_t e);
+    void removeSlot(int slot);
+
+public:
+    /**
+     * Constructor
+     */
+    SensorTable()
+    {
+        clear();
+    };
+
+    /**
+     * Remove all entries
+     */
+    void clear(void);
+
+    /**
+     * \brief Find sensor state
+     *
+     * The entry becomes the most recently used one.
+     *
+     * \param id        sensor ID
+     *
+     * \returns pointer to sensor state or nullptr if not found
+     */
+    sensor_state_t *find(uint32_t id);
+
+    /**
+     * \brief Find sensor state, create it if not found
+     *
+     * If the table is full, the least recently used entry is evicted.
+     * A new entry is zero-initialized except for sensor_id.
+     *
+     * \param id        sensor ID
+     * \param created   (optional) set to true if the entry has been created
+     *
+     * \returns pointer to sensor state
+     */
+    sensor_state_t *lookup(uint32_t id, bool *created = nullptr);
+
+    /**
+     * \brief Remove sensor state
+     *
+     * \param id        sensor ID
+     *
+     * \returns true if the entry was found
+     */
+    bool remove(uint32_t id);
+
+    /**
+     * \brief Number of entries
+     */
+    uint8_t size(void) const
+    {
+        return count;
+    };
+
+    /**
+     * \brief Number of entries evicted since clear()
+     */
+    uint32_t evicted(void) const
+    {
+        return evictions;
+    };
+
+    /**
+     * \brief Access entry by usage rank (0: most recently used) - for iteration
+     *
+     * \param rank      0...size()-1
+     *
+     * \returns pointer to sensor state or nullptr if rank is out of range
+     */
+    const sensor_state_t *at(uint8_t rank) const;
+
+    /**
+     * \brief Access entry by usage rank for modification (the usage order is not changed)
+     *
+     * \param rank      0...size()-1
+     *
+     * \returns pointer to sensor state or nullptr if rank is out of range
+     */
+    sensor_state_t *at(uint8_t rank);
+};
+
+#endif
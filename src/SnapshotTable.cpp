@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SnapshotTable.cpp
+//
+// Latest reading per sensor for concurrent readers (seqlock)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string.h>
+#include "SnapshotTable.h"
+
+
+void
+SnapshotTable::clear(void)
+{
+    for (int i = 0; i < SNAPSHOT_TABLE_SIZE; i++) {
+        slots[i].seq.store(0, std::memory_order_relaxed);
+        slots[i].sensor_id.store(0, std::memory_order_relaxed);
+        for (size_t w = 0; w < SNAPSHOT_WORDS; w++) {
+            slots[i].data[w].store(0, std::memory_order_relaxed);
+        }
+        stamp[i] = 0;
+    }
+    updates = 0;
+    retried.store(0, std::memory_order_relaxed);
+    used.store(0, std::memory_order_release);
+}
+
+
+int
+SnapshotTable::findSlot(uint32_t id) const
+{
+    uint8_t n = used.load(std::memory_order_acquire);
+
+    for (int i = 0; i < n; i++) {
+        if (slots[i].sensor_id.load(std::memory_order_relaxed) == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+void
+SnapshotTable::write(const weather_data_t &data)
+{
+    int i = findSlot(data.sensor_id);
+
+    if (i < 0) {
+        uint8_t n = used.load(std::memory_order_relaxed);
+        if (n < SNAPSHOT_TABLE_SIZE) {
+            i = n;
+        } else {
+            // Reuse least recently updated slot - readers detect the change by sensor_id
+            i = 0;
+            for (int j = 1; j < SNAPSHOT_TABLE_SIZE; j++) {
+                if ((uint32_t)(updates - stamp[j]) > (uint32_t)(updates - stamp[i])) {
+                    i = j;
+                }
+            }
+        }
+    }
+    slot_t &slot = slots[i];
+    uint32_t buf[SNAPSHOT_WORDS] = {0};
+    memcpy(buf, &data, sizeof(weather_data_t));
+
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    // Odd counter must be visible before any of the data
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.sensor_id.store(data.sensor_id, std::memory_order_relaxed);
+    for (size_t w = 0; w < SNAPSHOT_WORDS; w++) {
+        slot.data[w].store(buf[w], std::memory_order_relaxed);
+    }
+    slot.seq.store(seq + 2, std::memory_order_release);
+
+    stamp[i] = ++updates;
+    if (i == used.load(std::memory_order_relaxed)) {
+        // Publish new slot after its first write
+        used.store(i + 1, std::memory_order_release);
+    }
+}
+
+
+bool
+SnapshotTable::read(uint32_t id, weather_data_t *data, uint32_t *version) const
+{
+    int i = findSlot(id);
+
+    if (i < 0) {
+        return false;
+    }
+    const slot_t &slot = slots[i];
+    uint32_t buf[SNAPSHOT_WORDS];
+
+    for (int attempt = 0; attempt < SNAPSHOT_READ_RETRIES; attempt++) {
+        if (attempt > 0) {
+            retried.fetch_add(1, std::memory_order_relaxed);
+        }
+        uint32_t seq1 = slot.seq.load(std::memory_order_acquire);
+        if (seq1 & 1) {
+            continue;
+        }
+        for (size_t w = 0; w < SNAPSHOT_WORDS; w++) {
+            buf[w] = slot.data[w].load(std::memory_order_relaxed);
+        }
+        // Data loads must complete before the counter is checked again
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t seq2 = slot.seq.load(std::memory_order_relaxed);
+        if (seq1 != seq2) {
+            continue;
+        }
+        weather_data_t tmp;
+        memcpy(&tmp, buf, sizeof(weather_data_t));
+        if (tmp.sensor_id != id) {
+            // Slot has been reused for another sensor
+            return false;
+        }
+        *data = tmp;
+        if (version) {
+            *version = seq1 / 2;
+        }
+        return true;
+    }
+    return false;
+}
+
+
+uint8_t
+SnapshotTable::sensors(uint32_t *ids, uint8_t max) const
+{
+    uint8_t n = used.load(std::memory_order_acquire);
+    uint8_t count = 0;
+
+    for (int i = 0; (i < n) && (count < max); i++) {
+        ids[count++] = slots[i].sensor_id.load(std::memory_order_relaxed);
+    }
+    return count;
+}
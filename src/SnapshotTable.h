@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SnapshotTable.h
+//
+// Latest reading per sensor for concurrent readers (seqlock)
+//
+// The receive path is the only writer. Each slot holds a sequence counter and a copy of the
+// reading; the writer makes the counter odd, stores the reading and makes the counter even
+// again - it never waits for readers. Readers copy the slot and retry if the counter was odd
+// or has changed meanwhile, so they never take a lock and never block the writer.
+//
+// The reading is stored as an array of relaxed atomic words, which keeps the racy copy well
+// defined with respect to the C++ memory model (a plain memcpy would be a data race).
+//
+// When all slots are in use, the slot updated least recently is reused for a new sensor.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SNAPSHOT_TABLE_H
+#define SNAPSHOT_TABLE_H
+
+#include <stdint.h>
+#include <atomic>
+#include "WeatherSensorCfg.h"
+#include "WeatherSensor.h"
+
+/**
+ * Number of slots
+ */
+#define SNAPSHOT_TABLE_SIZE SENSOR_TABLE_SIZE
+
+/**
+ * Number of attempts of read() before giving up (writer busy with the same slot)
+ */
+#define SNAPSHOT_READ_RETRIES 100
+
+// Reading size in 32-bit words
+#define SNAPSHOT_WORDS ((sizeof(weather_data_t) + sizeof(uint32_t) - 1) / sizeof(uint32_t))
+
+
+/**
+ * \class SnapshotTable
+ *
+ * \brief Latest weather_data_t per sensor - single writer, any number of lock-free readers
+ */
+class SnapshotTable {
+private:
+    /**
+     * \brief Slot - sequence counter and reading
+     */
+    typedef struct Slot {
+        std::atomic<uint32_t> seq;                  //!< sequence counter - odd: write in progress
+        std::atomic<uint32_t> sensor_id;            //!< sensor ID (hint for lookup)
+        std::atomic<uint32_t> data[SNAPSHOT_WORDS]; //!< reading
+    } slot_t;
+
+    slot_t   slots[SNAPSHOT_TABLE_SIZE];           //!< slot storage
+    uint32_t stamp[SNAPSHOT_TABLE_SIZE];           //!< writer only: update counter at last write
+    uint32_t updates;                              //!< writer only: number of writes
+    std::atomic<uint8_t>  used;                    //!< number of slots in use
+    mutable std::atomic<uint32_t> retried;         //!< number of read retries
+
+    int findSlot(uint32_t id) const;
+
+public:
+    /**
+     * Constructor
+     */
+    SnapshotTable()
+    {
+        clear();
+    };
+
+    /**
+     * \brief Remove all readings
+     *
+     * Must not be called concurrently with read().
+     */
+    void clear(void);
+
+    /**
+     * \brief Store reading (writer)
+     *
+     * Must only be called from one task. Does not block.
+     *
+     * \param data      reading; data.sensor_id is the key
+     */
+    void write(const weather_data_t &data);
+
+    /**
+     * \brief Copy latest reading (reader)
+     *
+     * Lock-free; may be called from any task concurrently with write().
+     *
+     * \param id        sensor ID
+     * \param data      reading, not modified if false is returned
+     * \param version   (optional) number of writes to the slot - increases with each update
+     *
+     * \returns true if a consistent copy was obtained, false if not found (or the writer
+     *          kept the slot busy for SNAPSHOT_READ_RETRIES attempts)
+     */
+    bool read(uint32_t id, weather_data_t *data, uint32_t *version = nullptr) const;
+
+    /**
+     * \brief Sensor IDs (reader)
+     *
+     * \param ids       array for sensor IDs
+     * \param max       size of ids
+     *
+     * \returns number of sensor IDs stored in ids
+     */
+    uint8_t sensors(uint32_t *ids, uint8_t max) const;
+
+    /**
+     * \brief Number of read attempts repeated because of concurrent writes
+     */
+    uint32_t retries(void) const
+    {
+        return retried.load(std::memory_order_relaxed);
+    };
+};
+
+#endif
@@ -0,0 +1,253 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// StormTracker.cpp
+//
+// Streaming tracker of an active thunderstorm from the lightning sensor's events
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <math.h>
+#include "StormTracker.h"
+
+
+void
+StormTracker::reset(void)
+{
+    for (int i = 0; i < STORM_BUCKETS; i++) {
+        bucketNo[i] = 0;
+        bucketEvents[i] = 0;
+        bucketMin[i] = STORM_DISTANCE_INVALID;
+        bucketDist[i] = 0;
+    }
+    lastUpdate = 0;
+    lastEvent = 0;
+    active = false;
+    nearby = false;
+    clearTrend();
+}
+
+
+void
+StormTracker::clearTrend(void)
+{
+    firstSample = 0;
+    lastSample = 0;
+    sw = sx = sy = sxx = sxy = 0;
+    samples = 0;
+    prevTrend = STORM_TREND_UNKNOWN;
+}
+
+
+void
+StormTracker::addSample(uint32_t ts, float distance, float weight)
+{
+    if (samples > 0) {
+        float dt = (float)(ts - lastSample);
+
+        // Move origin to ts (x' = x - dt)
+        sxx += dt * (dt * sw - 2 * sx);
+        sxy -= dt * sy;
+        sx  -= dt * sw;
+
+        // Exponential weighting
+        float decay = expf(-dt / STORM_TREND_TAU);
+        sw  *= decay;
+        sx  *= decay;
+        sy  *= decay;
+        sxx *= decay;
+        sxy *= decay;
+    } else {
+        firstSample = ts;
+    }
+
+    // New sample at x = 0 - sx, sxx and sxy are not changed
+    sw += weight;
+    sy += weight * distance;
+    lastSample = ts;
+    if (samples < UINT16_MAX)
+        samples++;
+}
+
+
+uint8_t
+StormTracker::update(time_t timestamp, int events, uint8_t distance)
+{
+    uint32_t ts = (uint32_t)timestamp;
+    uint8_t flags = 0;
+
+    if ((lastUpdate != 0) && (ts < lastUpdate)) {
+        log_w("Timestamp older than last update - ignored");
+        return 0;
+    }
+
+    if (events > 0) {
+        if (!active) {
+            // New storm - previous regression is meaningless
+            active = true;
+            nearby = false;
+            clearTrend();
+            flags |= STORM_START;
+        }
+
+        uint32_t no = ts / STORM_BUCKET;
+        int idx = no % STORM_BUCKETS;
+        if ((bucketNo[idx] != no) || (bucketEvents[idx] == 0)) {
+            bucketNo[idx] = no;
+            bucketEvents[idx] = 0;
+            bucketMin[idx] = STORM_DISTANCE_INVALID;
+            bucketDist[idx] = 0;
+        }
+        uint32_t sum = bucketEvents[idx] + (uint32_t)events;
+        bucketEvents[idx] = (sum > UINT16_MAX) ? UINT16_MAX : sum;
+        if (distance < bucketMin[idx])
+            bucketMin[idx] = distance;
+        bucketDist[idx] += (uint32_t)distance * events;
+
+        // The sensor only reports the distance of the last strike - one sample per update
+        addSample(ts, distance, 1.0f);
+        lastEvent = ts;
+
+        bool near = (closest(timestamp) < STORM_ALERT_DISTANCE);
+        if (near && !nearby)
+            flags |= STORM_NEARBY;
+        nearby = near;
+    } else if (active && (ts - lastEvent >= STORM_TIMEOUT)) {
+        active = false;
+        nearby = false;
+        clearTrend();
+        flags |= STORM_END;
+    }
+
+    storm_trend_t t = trend();
+    if ((t == STORM_TREND_APPROACHING) && (prevTrend != STORM_TREND_APPROACHING))
+        flags |= STORM_APPROACH;
+    prevTrend = t;
+    lastUpdate = ts;
+
+    return flags;
+}
+
+
+// Bucket within window ending at bucket number 'no'
+#define IN_WINDOW(i, no) ((bucketEvents[i] != 0) && (bucketNo[i] <= (no)) && \
+                          (bucketNo[i] + STORM_BUCKETS > (no)))
+
+
+int
+StormTracker::events(time_t timestamp) const
+{
+    uint32_t no = (uint32_t)timestamp / STORM_BUCKET;
+    int res = 0;
+
+    for (int i = 0; i < STORM_BUCKETS; i++) {
+        if (IN_WINDOW(i, no))
+            res += bucketEvents[i];
+    }
+    return res;
+}
+
+
+float
+StormTracker::rate(time_t timestamp) const
+{
+    return events(timestamp) * 3600.0f / (STORM_BUCKETS * STORM_BUCKET);
+}
+
+
+uint8_t
+StormTracker::closest(time_t timestamp) const
+{
+    uint32_t no = (uint32_t)timestamp / STORM_BUCKET;
+    uint8_t res = STORM_DISTANCE_INVALID;
+
+    for (int i = 0; i < STORM_BUCKETS; i++) {
+        if (IN_WINDOW(i, no) && (bucketMin[i] < res))
+            res = bucketMin[i];
+    }
+    return res;
+}
+
+
+float
+StormTracker::meanDistance(time_t timestamp) const
+{
+    uint32_t no = (uint32_t)timestamp / STORM_BUCKET;
+    uint32_t n = 0;
+    uint32_t sum = 0;
+
+    for (int i = 0; i < STORM_BUCKETS; i++) {
+        if (IN_WINDOW(i, no)) {
+            n += bucketEvents[i];
+            sum += bucketDist[i];
+        }
+    }
+    return (n == 0) ? -1 : (float)sum / n;
+}
+
+
+float
+StormTracker::speed(bool *valid) const
+{
+    float den = sw * sxx - sx * sx;
+
+    bool ok = (samples >= STORM_TREND_MIN_SAMPLES) &&
+              (lastSample - firstSample >= STORM_TREND_MIN_SPAN) && (den > 0);
+    if (valid)
+        *valid = ok;
+    if (!ok)
+        return 0;
+
+    return (sw * sxy - sx * sy) / den * 3600.0f;
+}
+
+
+storm_trend_t
+StormTracker::trend(void) const
+{
+    bool valid;
+    float v = speed(&valid);
+
+    if (!valid)
+        return STORM_TREND_UNKNOWN;
+    if (v < -STORM_TREND_THRESHOLD)
+        return STORM_TREND_APPROACHING;
+    if (v > STORM_TREND_THRESHOLD)
+        return STORM_TREND_RECEDING;
+    return STORM_TREND_STEADY;
+}
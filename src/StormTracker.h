@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// StormTracker.h
+//
+// Streaming tracker of an active thunderstorm from the lightning sensor's events
+//
+// Fed with the events and the distance of each lightning sensor update (see Lightning).
+//
+// Sliding window:
+// STORM_BUCKETS buckets of STORM_BUCKET seconds, numbered by timestamp / bucket length, each
+// holding the number of events, the minimum distance and the event-weighted distance sum.
+// Buckets are reused when their number has left the window. Strike rate, closest and mean
+// distance are derived from the buckets within the window.
+//
+// Distance trend:
+// Exponentially weighted linear regression of the distance over time (time constant
+// STORM_TREND_TAU). The weighted sums are kept relative to the latest sample; moving the
+// origin and decaying the sums is O(1). The slope is reported in km/h - negative values
+// indicate an approaching storm.
+//
+// update() returns flags for storm start/end, approach and the storm getting closer than
+// STORM_ALERT_DISTANCE, each set once on the transition - so alerts can be sent immediately.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _STORM_TRACKER_H
+#define _STORM_TRACKER_H
+
+#include <stdint.h>
+#include <time.h>
+#include "WeatherSensorCfg.h"
+
+/**
+ * Bucket length in seconds
+ */
+#define STORM_BUCKET 300
+
+/**
+ * Number of buckets - STORM_BUCKETS * STORM_BUCKET is the sliding window length
+ */
+#define STORM_BUCKETS 6
+
+/**
+ * Time constant of the distance regression in seconds
+ */
+#define STORM_TREND_TAU 1800.0f
+
+/**
+ * Minimum number of samples for a valid trend
+ */
+#define STORM_TREND_MIN_SAMPLES 3
+
+/**
+ * Minimum time between first and last sample in seconds for a valid trend
+ */
+#define STORM_TREND_MIN_SPAN 600
+
+/**
+ * Slope (km/h) required to report approaching/receding
+ */
+#define STORM_TREND_THRESHOLD 5.0f
+
+/**
+ * Distance in km for STORM_NEARBY alert
+ */
+#define STORM_ALERT_DISTANCE 10
+
+/**
+ * Storm ends if there were no events for this time in seconds
+ */
+#define STORM_TIMEOUT (STORM_BUCKETS * STORM_BUCKET)
+
+#define STORM_DISTANCE_INVALID 0xFF     //!< no distance available
+
+/**
+ * update() flags
+ */
+#define STORM_START     0x01            //!< first events after no storm
+#define STORM_END       0x02            //!< no events for STORM_TIMEOUT
+#define STORM_APPROACH  0x04            //!< trend changed to approaching
+#define STORM_NEARBY    0x08            //!< closest distance fell below STORM_ALERT_DISTANCE
+
+
+/**
+ * \brief Distance trend
+ */
+typedef enum StormTrend {
+    STORM_TREND_UNKNOWN = 0,            //!< not enough samples
+    STORM_TREND_STEADY,                 //!< slope within +-STORM_TREND_THRESHOLD
+    STORM_TREND_APPROACHING,            //!< distance decreasing
+    STORM_TREND_RECEDING                //!< distance increasing
+} storm_trend_t;
+
+
+/**
+ * \class StormTracker
+ *
+ * \brief Strike rate, distance statistics and distance trend of an active storm
+ */
+class StormTracker {
+private:
+    uint32_t bucketNo[STORM_BUCKETS];   //!< bucket number (timestamp / STORM_BUCKET)
+    uint16_t bucketEvents[STORM_BUCKETS]; //!< events in bucket
+    uint8_t  bucketMin[STORM_BUCKETS];  //!< minimum distance in bucket
+    uint32_t bucketDist[STORM_BUCKETS]; //!< sum of distance * events in bucket
+    uint32_t lastUpdate;                //!< timestamp of last update (0: no update yet)
+    uint32_t lastEvent;                 //!< timestamp of last update with events
+    uint32_t firstSample;               //!< timestamp of first regression sample
+    uint32_t lastSample;                //!< timestamp of last regression sample (origin)
+    float    sw;                        //!< sum of weights
+    float    sx;                        //!< sum of weight * time
+    float    sy;                        //!< sum of weight * distance
+    float    sxx;                       //!< sum of weight * time^2
+    float    sxy;                       //!< sum of weight * time * distance
+    uint16_t samples;                   //!< number of regression samples
+    bool     active;                    //!< storm active
+    bool     nearby;                    //!< closest distance below STORM_ALERT_DISTANCE
+    storm_trend_t prevTrend;            //!< trend after last update
+
+    void clearTrend(void);
+    void addSample(uint32_t ts, float distance, float weight);
+
+public:
+    /**
+     * Constructor
+     */
+    StormTracker()
+    {
+        reset();
+    };
+
+    /**
+     * Reset tracker
+     */
+    void reset(void);
+
+    /**
+     * \brief Update tracker (O(1))
+     *
+     * Timestamps older than the last update are ignored.
+     *
+     * \param timestamp     timestamp (UTC)
+     * \param events        number of events since the previous update (see Lightning::lastCycle())
+     * \param distance      distance of last strike in km (only used if events > 0)
+     *
+     * \returns STORM_START | STORM_END | STORM_APPROACH | STORM_NEARBY flags on transitions
+     */
+    uint8_t update(time_t timestamp, int events, uint8_t distance);
+
+    /**
+     * \brief Storm active (events within STORM_TIMEOUT)
+     */
+    bool isActive(void) const
+    {
+        return active;
+    };
+
+    /**
+     * \brief Number of events within window
+     *
+     * \param timestamp     current time
+     */
+    int events(time_t timestamp) const;
+
+    /**
+     * \brief Strike rate within window
+     *
+     * \param timestamp     current time
+     *
+     * \returns events per hour
+     */
+    float rate(time_t timestamp) const;
+
+    /**
+     * \brief Closest distance within window
+     *
+     * \param timestamp     current time
+     *
+     * \returns distance in km or STORM_DISTANCE_INVALID if there were no events
+     */
+    uint8_t closest(time_t timestamp) const;
+
+    /**
+     * \brief Mean distance (weighted by events) within window
+     *
+     * \param timestamp     current time
+     *
+     * \returns distance in km or -1 if there were no events
+     */
+    float meanDistance(time_t timestamp) const;
+
+    /**
+     * \brief Slope of the distance regression
+     *
+     * \param valid     (optional) false if there are not enough samples or they span
+     *                  less than STORM_TREND_MIN_SPAN
+     *
+     * \returns slope in km/h (negative: approaching)
+     */
+    float speed(bool *valid = nullptr) const;
+
+    /**
+     * \brief Distance trend
+     */
+    storm_trend_t trend(void) const;
+};
+
+#endif
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Timebase.cpp
+//
+// Monotonic receive timestamps converted to UTC via a periodically refreshed NTP anchor
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Timebase.h"
+
+
+void
+Timebase::reset(void)
+{
+    monoRef = 0;
+    utcRef  = 0;
+    slewUs  = 0;
+    ratePpb = 0;
+    anchors = 0;
+    isValid = false;
+}
+
+
+void
+Timebase::anchor(int64_t mono_us, int64_t utc_us)
+{
+    if (!isValid) {
+        monoRef = mono_us;
+        utcRef  = utc_us;
+        slewUs  = 0;
+        anchors = 1;
+        isValid = true;
+        return;
+    }
+
+    int64_t elapsed = mono_us - monoRef;
+    int64_t predicted = toUtcUs(mono_us);
+    int64_t offset = utc_us - predicted;
+
+    if ((elapsed <= 0) || (offset > TIMEBASE_STEP_THRESHOLD_US) || (offset < -TIMEBASE_STEP_THRESHOLD_US)) {
+        // Out of order sample or offset too large - step to the new time
+        monoRef = mono_us;
+        utcRef  = utc_us;
+        slewUs  = 0;
+        if (anchors < UINT16_MAX)
+            anchors++;
+        return;
+    }
+
+    // Frequency correction - only with a meaningful baseline and after the first step/slew
+    if ((anchors > 1) && (elapsed >= 60LL * 1000000LL)) {
+        int64_t rate = ratePpb + (offset * 1000000000LL / elapsed) / 4;
+        if (rate > TIMEBASE_RATE_MAX_PPB) {
+            rate = TIMEBASE_RATE_MAX_PPB;
+        } else if (rate < -TIMEBASE_RATE_MAX_PPB) {
+            rate = -TIMEBASE_RATE_MAX_PPB;
+        }
+        ratePpb = (int32_t)rate;
+    }
+
+    // Phase correction - continue from the predicted time and slew in the offset
+    monoRef = mono_us;
+    utcRef  = predicted;
+    slewUs  = offset;
+    if (anchors < UINT16_MAX)
+        anchors++;
+}
+
+
+int64_t
+Timebase::toUtcUs(int64_t mono_us) const
+{
+    int64_t dt = mono_us - monoRef;
+    // Rate correction with ms resolution to avoid overflow for long extrapolation periods
+    int64_t res = utcRef + dt + ((dt / 1000LL) * ratePpb) / 1000000LL;
+
+    if ((dt > 0) && (slewUs != 0)) {
+        // Slewing is limited to TIMEBASE_SLEW_MAX_PPM of the elapsed time
+        int64_t slew = dt * TIMEBASE_SLEW_MAX_PPM / 1000000LL;
+        if (slewUs > 0) {
+            res += (slew < slewUs) ? slew : slewUs;
+        } else {
+            res -= (slew < -slewUs) ? slew : -slewUs;
+        }
+    }
+    return res;
+}
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Timebase.h
+//
+// Monotonic receive timestamps converted to UTC via a periodically refreshed NTP anchor
+//
+// The receive ISR only captures a monotonic microsecond counter. Conversion to UTC is done
+// later (and cheaply) by extrapolating from the last (monotonic, UTC) anchor pair, which is
+// refreshed whenever SNTP delivers a new time sample. Small offsets between the prediction
+// and a new NTP sample are slewed in at a bounded rate, so the UTC timeline never jumps
+// backwards; large offsets are stepped. If NTP is unreachable, the last anchor and the
+// learned clock rate are used indefinitely.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+#include <time.h>
+
+#if defined(ESP32)
+    #include <esp_timer.h>
+#endif
+
+/**
+ * Interval for refreshing the NTP anchor (SNTP sync interval) in ms
+ */
+#define TIMEBASE_ANCHOR_INTERVAL_MS (60UL * 60UL * 1000UL)
+
+/**
+ * Offsets between prediction and NTP sample larger than this are stepped (not slewed)
+ */
+#define TIMEBASE_STEP_THRESHOLD_US 1000000LL
+
+/**
+ * Maximum slew rate in ppm (same order as adjtime())
+ */
+#define TIMEBASE_SLEW_MAX_PPM 500LL
+
+/**
+ * Limit of the learned clock rate correction in ppb
+ */
+#define TIMEBASE_RATE_MAX_PPB 500000LL
+
+
+/**
+ * \brief Monotonic microsecond counter
+ *
+ * Safe to be called from interrupt context on ESP32 (esp_timer_get_time() is in IRAM).
+ *
+ * \returns monotonic time in microseconds
+ */
+static inline int64_t timebase_mono_us(void)
+{
+#if defined(ESP32)
+    return esp_timer_get_time();
+#elif defined(ARDUINO)
+    // 32-bit micros() - extended to 64 bits; must be called at least every ~71 minutes
+    static uint32_t prev;
+    static uint32_t high;
+    uint32_t now = micros();
+    if (now < prev) {
+        high++;
+    }
+    prev = now;
+    return ((int64_t)high << 32) | now;
+#else
+    struct timespec tp;
+    clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (int64_t)tp.tv_sec * 1000000LL + tp.tv_nsec / 1000;
+#endif
+}
+
+
+/**
+ * \class Timebase
+ *
+ * \brief Conversion of monotonic timestamps to UTC
+ *
+ * Usage:
+ * - capture timebase_mono_us() in the receive ISR
+ * - call anchor() with each new NTP time sample (e.g. from the SNTP sync callback)
+ * - call toUtc() / toUtcUs() when processing the received frame
+ */
+class Timebase {
+private:
+    int64_t monoRef;      //!< monotonic time of the anchor in us
+    int64_t utcRef;       //!< UTC of the anchor in us
+    int64_t slewUs;       //!< offset still to be slewed in after the anchor in us
+    int32_t ratePpb;      //!< learned rate correction of the monotonic clock in ppb
+    uint16_t anchors;     //!< number of NTP samples applied
+    bool     isValid;     //!< at least one anchor has been set
+
+public:
+    /**
+     * Constructor
+     */
+    Timebase()
+    {
+        reset();
+    };
+
+    /**
+     * Discard anchor and learned clock rate
+     */
+    void reset(void);
+
+    /**
+     * \brief Apply a new NTP time sample
+     *
+     * \param mono_us   monotonic time (timebase_mono_us()) at which the sample was taken
+     * \param utc_us    UTC in microseconds since epoch
+     */
+    void anchor(int64_t mono_us, int64_t utc_us);
+
+    /**
+     * \brief Check if UTC conversion is available
+     *
+     * \returns true if at least one NTP sample has been applied
+     */
+    bool valid(void) const
+    {
+        return isValid;
+    };
+
+    /**
+     * \brief Convert monotonic time to UTC
+     *
+     * \param mono_us   monotonic time in microseconds
+     *
+     * \returns UTC in microseconds since epoch
+     */
+    int64_t toUtcUs(int64_t mono_us) const;
+
+    /**
+     * \brief Convert monotonic time to UTC
+     *
+     * \param mono_us   monotonic time in microseconds
+     *
+     * \returns UTC in seconds since epoch
+     */
+    time_t toUtc(int64_t mono_us) const
+    {
+        return (time_t)(toUtcUs(mono_us) / 1000000LL);
+    };
+
+    /**
+     * \brief Learned rate correction of the monotonic clock
+     *
+     * \returns rate correction in ppb
+     */
+    int32_t rate(void) const
+    {
+        return ratePpb;
+    };
+
+    /**
+     * \brief Age of the current anchor
+     *
+     * \param mono_us   current monotonic time in microseconds
+     *
+     * \returns time since last NTP sample in microseconds
+     */
+    int64_t anchorAge(int64_t mono_us) const
+    {
+        return mono_us - monoRef;
+    };
+};
+
+#endif
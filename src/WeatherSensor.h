@@ -22,6 +22,7 @@ struct WeatherData {
             float    wind_avg_meter_sec;  //!< wind speed (avg)   in m/s
             float    delta_t;           //!< time difference in seconds
             float    delta_rain;        //!< rain difference in mm
+            float    rain_rate;         //!< rain rate in mm/h
             uint8_t  humidity;                //!< humidity in %
             bool     temp_ok;         //!< temperature o.k. (only 6-in-1)
             bool     humidity_ok;     //!< humidity o.k.
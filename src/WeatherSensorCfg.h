@@ -69,6 +69,18 @@
 // 20241130 Added pin definitions for Heltec Vision Master T190
 // 20241205 Added pin definitions for Lilygo T3-S3 (SX1262/SX1276/LR1121)
 // 20241227 Improved maintainability of board definitions
+// 20261019 Added SENSOR_TABLE_SIZE
+//          Added COLUMN_STORE_BLOCKS and COLUMN_STORE_SERIES
+//          Added RAINGAUGE_HIST_SIZE
+//          Added PERSIST_INTERVAL and PERSIST_DELTA
+//          Added GAUGE_MANAGER_SIZE and GAUGE_MANAGER_LIGHTNING
+//          Added AGG_INTERVAL, AGG_PUBLISH_SUMMARY and AGG_SUMMARY_ONLY
+//          Added SEGMENT_LOG_* (on-device reading log)
+//          Added HTTP_* (local HTTP server)
+//          Added POOL_FRAMES and POOL_BUFFERS
+//          Added PIPELINE_TRACE and TRACE_REPORT_INTERVAL
+//          Added LINK_STATS_INTERVAL
+//          Added RAIN_ACC_TABLE_SIZE
 //
 // ToDo:
 // -
@@ -85,6 +97,21 @@
 // ------------------------------------------------------------------------------------------------
 #define MAX_SENSORS_DEFAULT 1       // Maximum number of sensors to be received
 
+// Maximum number of sensors for which state (last reading, rain baseline, statistics)
+// is tracked simultaneously; least recently heard sensors are evicted
+#define SENSOR_TABLE_SIZE 16
+
+// In-memory history of recent readings (see ColumnStore.h):
+// number of blocks (64 readings each) shared by all sensors and max. number of sensors
+#define COLUMN_STORE_BLOCKS 16
+#define COLUMN_STORE_SERIES 4
+
+// Interval summaries (see IntervalAggregator.h): interval length in seconds,
+// publish summaries (topic weather/summary) and publish summaries only (no raw data)
+#define AGG_INTERVAL 300
+#define AGG_PUBLISH_SUMMARY
+//#define AGG_SUMMARY_ONLY
+
 // List of sensor IDs to be excluded - can be empty
 #define SENSOR_IDS_EXC { }
 
@@ -122,6 +149,50 @@
     #endif
 #endif
 
+// Capacity of the rain gauge history in 6-minute slots (12 bits each) - default: past hour
+//#define RAINGAUGE_HIST_SIZE 40
+
+// Preferences are written only if the state has changed and at least PERSIST_INTERVAL seconds
+// have elapsed since the last write or PERSIST_DELTA (rain in 0.1 mm / lightning events)
+// has accumulated
+#define PERSIST_INTERVAL 900
+#define PERSIST_DELTA 10
+
+// Number of rain gauges and lightning sensors handled by GaugeManager
+#define GAUGE_MANAGER_SIZE 4
+#define GAUGE_MANAGER_LIGHTNING 1
+
+// Number of rain accumulator baselines kept in Preferences (see RainAccTable.h)
+#define RAIN_ACC_TABLE_SIZE 8
+
+// On-device log of readings in LittleFS (see SegmentLog.h): directory, segment size
+// in bytes and max. number of segments (oldest segments are deleted)
+#define SEGMENT_LOG
+#define SEGMENT_LOG_DIR "/littlefs/log"
+#define SEGMENT_LOG_BLOCK_SIZE 2048
+#define SEGMENT_LOG_MAX_SEGMENTS 128
+
+// Local HTTP server (see HttpServer.h): port, max. number of simultaneous clients, buffer
+// sizes per client (response buffer: one TCP segment) and idle timeout
+#define HTTP_SERVER
+#define HTTP_PORT 80
+#define HTTP_MAX_CLIENTS 4
+#define HTTP_REQUEST_SIZE 512
+#define HTTP_RESPONSE_SIZE 1460
+#define HTTP_TIMEOUT_MS 5000
+
+// Static block pools (see BlockPool.h): number of receive frame buffers and MQTT message buffers (1 KiB each)
+#define POOL_FRAMES 2
+#define POOL_BUFFERS 2
+
+// Latency trace of the receive pipeline (see PipelineTrace.h): report interval in s
+// (serial console and MQTT topic weather/trace)
+#define PIPELINE_TRACE
+#define TRACE_REPORT_INTERVAL 600
+
+// Publish interval of the per-sensor link statistics in s (MQTT topic weather/link)
+#define LINK_STATS_INTERVAL 300
+
 // ------------------------------------------------------------------------------------------------
 // --- Board ---
 // ------------------------------------------------------------------------------------------------
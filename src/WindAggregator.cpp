@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// WindAggregator.cpp
+//
+// Streaming wind statistics with circular mean direction and wind rose
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string.h>
+#include <math.h>
+#include "WindAggregator.h"
+
+// sin(0...90 deg) in Q15 (saturated at 32767)
+static const int16_t sinLut[91] = {
+        0,   572,  1144,  1715,  2286,  2856,  3425,  3993,  4560,  5126,
+     5690,  6252,  6813,  7371,  7927,  8481,  9032,  9580, 10126, 10668,
+    11207, 11743, 12275, 12803, 13328, 13848, 14365, 14876, 15384, 15886,
+    16384, 16877, 17364, 17847, 18324, 18795, 19261, 19720, 20174, 20622,
+    21063, 21498, 21926, 22348, 22763, 23170, 23571, 23965, 24351, 24730,
+    25102, 25466, 25822, 26170, 26510, 26842, 27166, 27482, 27789, 28088,
+    28378, 28660, 28932, 29197, 29452, 29698, 29935, 30163, 30382, 30592,
+    30792, 30983, 31164, 31336, 31499, 31651, 31795, 31928, 32052, 32166,
+    32270, 32365, 32449, 32524, 32588, 32643, 32688, 32723, 32748, 32763,
+    32767
+};
+
+static const uint16_t roseLimits[WIND_ROSE_BINS - 1] = WIND_ROSE_LIMITS;
+
+
+// Wind direction in deg, rounded to integer and wrapped to 0...359
+static int wrapDeg(float direction)
+{
+    int d = (int)lroundf(direction) % 360;
+
+    return (d < 0) ? d + 360 : d;
+}
+
+
+// Sector of integer direction (0...359); sector 0 is centered on north
+static int sectorOf(int d)
+{
+    return ((d * WIND_ROSE_SECTORS * 2 + 360) / 720) % WIND_ROSE_SECTORS;
+}
+
+
+int16_t
+WindAggregator::sinQ15(int deg)
+{
+    deg %= 360;
+    if (deg < 0)
+        deg += 360;
+
+    if (deg <= 90)
+        return sinLut[deg];
+    if (deg <= 180)
+        return sinLut[180 - deg];
+    if (deg <= 270)
+        return -sinLut[deg - 180];
+    return -sinLut[360 - deg];
+}
+
+
+int
+WindAggregator::sector(float direction)
+{
+    return sectorOf(wrapDeg(direction));
+}
+
+
+void
+WindAggregator::reset(void)
+{
+    memset(this, 0, sizeof(WindAggregator));
+}
+
+
+void
+WindAggregator::update(float direction, float speed, float gust_speed)
+{
+    int d = wrapDeg(direction);
+    int32_t v = (speed > 0) ? (int32_t)(speed * 10 + 0.5f) : 0;
+    int32_t g = (gust_speed > 0) ? (int32_t)(gust_speed * 10 + 0.5f) : 0;
+    int32_t s = sinQ15(d);
+    int32_t c = cosQ15(d);
+
+    if (n == UINT16_MAX)
+        return;
+    n++;
+
+    sinSpeed += v * s;
+    cosSpeed += v * c;
+    sinSum += s;
+    cosSum += c;
+    speedSum += v;
+    speedSqSum += (uint64_t)(v * v);
+    if (g > gust)
+        gust = (g > UINT16_MAX) ? UINT16_MAX : g;
+
+    if (v < WIND_CALM) {
+        calms++;
+        return;
+    }
+    int bin = 0;
+    while ((bin < WIND_ROSE_BINS - 1) && (v >= roseLimits[bin]))
+        bin++;
+    hist[sectorOf(d)][bin]++;
+}
+
+
+float
+WindAggregator::direction(bool *valid) const
+{
+    bool ok = (sinSpeed != 0) || (cosSpeed != 0);
+
+    if (valid)
+        *valid = ok;
+    if (!ok)
+        return 0;
+
+    float deg = atan2f((float)sinSpeed, (float)cosSpeed) * (float)(180.0 / M_PI);
+    return (deg < 0) ? deg + 360 : deg;
+}
+
+
+float
+WindAggregator::directionStdDev(void) const
+{
+    if (n == 0)
+        return 0;
+
+    float s = (float)sinSum / (n * 32768.0f);
+    float c = (float)cosSum / (n * 32768.0f);
+    float r2 = s * s + c * c;
+    float eps = (r2 < 1) ? sqrtf(1 - r2) : 0;
+
+    // Yamartino (1984)
+    float sigma = asinf(eps) * (1 + (2 / sqrtf(3) - 1) * eps * eps * eps);
+    return sigma * (float)(180.0 / M_PI);
+}
+
+
+float
+WindAggregator::speed(void) const
+{
+    return (n == 0) ? 0 : speedSum * 0.1f / n;
+}
+
+
+float
+WindAggregator::speedStdDev(void) const
+{
+    if (n == 0)
+        return 0;
+
+    double mean = (double)speedSum / n;
+    double var = (double)speedSqSum / n - mean * mean;
+    return (var > 0) ? (float)sqrt(var) * 0.1f : 0;
+}
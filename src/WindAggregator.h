@@ -0,0 +1,215 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// WindAggregator.h
+//
+// Streaming wind statistics with circular mean direction and wind rose
+//
+// The wind direction is averaged as a vector: the sine and cosine of each direction are
+// accumulated, weighted by the average wind speed (vector mean) and unweighted (unit vector
+// mean, for the direction's standard deviation by the Yamartino method). Per frame, sine
+// and cosine are taken from a quarter-wave lookup table in Q15 fixed-point (1 degree
+// resolution) and summed in integers; floating point trigonometry is only used when the
+// statistics are queried.
+//
+// Also tracked: gust maximum, mean and standard deviation of the wind speed, and a wind rose
+// of WIND_ROSE_SECTORS direction sectors by WIND_ROSE_BINS speed bins (frames with a wind
+// speed below WIND_CALM are counted as calm).
+//
+// The object has no constructor and is valid when zero-initialized.
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _WIND_AGGREGATOR_H
+#define _WIND_AGGREGATOR_H
+
+#include <stdint.h>
+
+/**
+ * Number of wind rose direction sectors (22.5 deg each)
+ */
+#define WIND_ROSE_SECTORS 16
+
+/**
+ * Number of wind rose speed bins
+ */
+#define WIND_ROSE_BINS 5
+
+/**
+ * Calm threshold in 0.1 m/s
+ */
+#define WIND_CALM 5
+
+/**
+ * Upper limits of wind rose speed bins 0...WIND_ROSE_BINS-2 in 0.1 m/s
+ * (last bin: above)
+ */
+#define WIND_ROSE_LIMITS { 20, 40, 60, 80 }
+
+
+/**
+ * \class WindAggregator
+ *
+ * \brief Wind statistics - vector mean direction, gusts and wind rose
+ */
+class WindAggregator {
+private:
+    int64_t  sinSpeed;                  //!< sum of speed * sin(dir) (0.1 m/s * Q15)
+    int64_t  cosSpeed;                  //!< sum of speed * cos(dir) (0.1 m/s * Q15)
+    int64_t  sinSum;                    //!< sum of sin(dir) (Q15)
+    int64_t  cosSum;                    //!< sum of cos(dir) (Q15)
+    uint32_t speedSum;                  //!< sum of speed in 0.1 m/s
+    uint64_t speedSqSum;                //!< sum of speed^2 in (0.1 m/s)^2
+    uint16_t n;                         //!< number of frames
+    uint16_t calms;                     //!< number of frames with speed below WIND_CALM
+    uint16_t gust;                      //!< gust maximum in 0.1 m/s
+    uint16_t hist[WIND_ROSE_SECTORS][WIND_ROSE_BINS]; //!< wind rose
+
+public:
+    /**
+     * Discard statistics
+     */
+    void reset(void);
+
+    /**
+     * \brief Add frame (O(1), integer arithmetic only)
+     *
+     * \param direction     wind direction in deg
+     * \param speed         average wind speed in m/s
+     * \param gust_speed    gust wind speed in m/s
+     */
+    void update(float direction, float speed, float gust_speed);
+
+    /**
+     * \brief Number of frames
+     */
+    uint16_t count(void) const
+    {
+        return n;
+    };
+
+    /**
+     * \brief Speed weighted vector mean of the wind direction
+     *
+     * \param valid     (optional) false if there was no wind
+     *
+     * \returns direction in deg (0...360)
+     */
+    float direction(bool *valid = nullptr) const;
+
+    /**
+     * \brief Standard deviation of the wind direction (Yamartino method)
+     *
+     * \returns standard deviation in deg
+     */
+    float directionStdDev(void) const;
+
+    /**
+     * \brief Mean wind speed
+     *
+     * \returns speed in m/s
+     */
+    float speed(void) const;
+
+    /**
+     * \brief Standard deviation of the wind speed
+     *
+     * \returns standard deviation in m/s
+     */
+    float speedStdDev(void) const;
+
+    /**
+     * \brief Gust maximum
+     *
+     * \returns speed in m/s
+     */
+    float gustMax(void) const
+    {
+        return gust * 0.1f;
+    };
+
+    /**
+     * \brief Number of calm frames (speed below WIND_CALM)
+     */
+    uint16_t calm(void) const
+    {
+        return calms;
+    };
+
+    /**
+     * \brief Wind rose - number of frames in direction sector and speed bin
+     *
+     * \param sector    direction sector (0: N, 1: NNE, ...)
+     * \param bin       speed bin (see WIND_ROSE_LIMITS)
+     */
+    uint16_t rose(int sector, int bin) const
+    {
+        return hist[sector][bin];
+    };
+
+    /**
+     * \brief Direction sector of wind direction
+     *
+     * \param direction     wind direction in deg
+     *
+     * \returns sector (0...WIND_ROSE_SECTORS-1)
+     */
+    static int sector(float direction);
+
+    /**
+     * \brief Sine from lookup table
+     *
+     * \param deg       angle in deg (integer)
+     *
+     * \returns sin(deg) in Q15
+     */
+    static int16_t sinQ15(int deg);
+
+    /**
+     * \brief Cosine from lookup table
+     *
+     * \param deg       angle in deg (integer)
+     *
+     * \returns cos(deg) in Q15
+     */
+    static int16_t cosQ15(int deg)
+    {
+        return sinQ15(deg + 90);
+    };
+};
+
+#endif
@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestBlockPool.cpp
+//
+// CppUTest unit tests for BlockPool - artificial test cases and multi-threaded stress test
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include <thread>
+#include <atomic>
+#include <new>
+#include "BlockPool.h"
+
+#define STRESS_THREADS 8
+#define STRESS_ROUNDS  100000
+#define STRESS_HOLD    4
+
+TEST_GROUP(TG_BlockPoolBasic) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_BlockPoolScope) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_BlockPoolStress) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test allocation until exhausted, release and statistics
+ */
+TEST(TG_BlockPoolBasic, Test_BlockPoolBasic) {
+  StaticBlockPool<30, 4> pool;
+  void *blocks[4];
+
+  printf("< BlockPoolBasic >\n");
+
+  CHECK_EQUAL(4, pool.capacity());
+  CHECK_EQUAL(0, pool.size() % alignof(max_align_t));
+  CHECK(pool.size() >= 30);
+
+  for (int i = 0; i < 4; i++) {
+    blocks[i] = pool.alloc();
+    CHECK(blocks[i] != nullptr);
+    CHECK(pool.owns(blocks[i]));
+    CHECK_EQUAL(0, (uintptr_t)blocks[i] % alignof(max_align_t));
+    memset(blocks[i], i, 30);
+  }
+  for (int i = 0; i < 4; i++) {
+    for (int j = i + 1; j < 4; j++) {
+      CHECK(blocks[i] != blocks[j]);
+    }
+  }
+  CHECK(pool.alloc() == nullptr);
+  CHECK_EQUAL(1, pool.failed());
+  CHECK_EQUAL(4, pool.inUse());
+
+  // Released block is reused first
+  pool.release(blocks[2]);
+  CHECK_EQUAL(3, pool.inUse());
+  POINTERS_EQUAL(blocks[2], pool.alloc());
+
+  // Foreign pointers and nullptr are ignored
+  int other;
+  pool.release(&other);
+  pool.release(nullptr);
+  CHECK_FALSE(pool.owns(&other));
+  CHECK_EQUAL(4, pool.inUse());
+
+  for (int i = 0; i < 4; i++) {
+    pool.release(blocks[i]);
+  }
+  CHECK_EQUAL(0, pool.inUse());
+  CHECK_EQUAL(4, pool.maxUsed());
+
+  pool.reset();
+  CHECK_EQUAL(0, pool.maxUsed());
+  CHECK_EQUAL(0, pool.failed());
+}
+
+/*
+ * Test scoped allocation
+ */
+TEST(TG_BlockPoolScope, Test_BlockPoolScope) {
+  StaticBlockPool<64, 2> pool;
+
+  printf("< BlockPoolScope >\n");
+
+  {
+    PoolBlock a(pool);
+    PoolBlock b(pool);
+    PoolBlock c(pool);
+    CHECK(a.get() != nullptr);
+    CHECK(b.get() != nullptr);
+    CHECK(c.get() == nullptr);
+    CHECK_EQUAL(2, pool.inUse());
+  }
+  CHECK_EQUAL(0, pool.inUse());
+  CHECK_EQUAL(2, pool.maxUsed());
+}
+
+/*
+ * Test concurrent allocation and release: a block must never be handed out twice
+ * (each thread marks its blocks and checks the mark before release), and no block
+ * must get lost
+ */
+TEST(TG_BlockPoolStress, Test_BlockPoolStress) {
+  static StaticBlockPool<sizeof(uint32_t) * 4, 16> pool;
+  std::atomic<uint32_t> errors(0);
+  std::thread threads[STRESS_THREADS];
+
+  printf("< BlockPoolStress >\n");
+
+  pool.reset();
+  for (int t = 0; t < STRESS_THREADS; t++) {
+    threads[t] = std::thread([&, t]() {
+      uint32_t *held[STRESS_HOLD] = {nullptr};
+      uint32_t e = 0;
+      for (uint32_t k = 0; k < STRESS_ROUNDS; k++) {
+        int slot = k % STRESS_HOLD;
+        if (held[slot]) {
+          std::atomic<uint32_t> *mark = (std::atomic<uint32_t> *)held[slot];
+          if (mark->load(std::memory_order_relaxed) != (uint32_t)(t << 24 | slot)) {
+            e++;
+          }
+          pool.release(held[slot]);
+          held[slot] = nullptr;
+        }
+        // Hold a varying number of blocks
+        if ((k / STRESS_HOLD + t) % 3 != 0) {
+          uint32_t *p = (uint32_t *)pool.alloc();
+          if (p) {
+            new (p) std::atomic<uint32_t>((uint32_t)(t << 24 | slot));
+            held[slot] = p;
+          }
+        }
+      }
+      for (int slot = 0; slot < STRESS_HOLD; slot++) {
+        pool.release(held[slot]);
+      }
+      errors += e;
+    });
+  }
+  for (int t = 0; t < STRESS_THREADS; t++) {
+    threads[t].join();
+  }
+
+  printf("max. %u of %u blocks used, %u allocations failed\n", pool.maxUsed(), pool.capacity(), pool.failed());
+  CHECK_EQUAL(0, errors.load());
+  CHECK_EQUAL(0, pool.inUse());
+  CHECK(pool.maxUsed() <= 16);
+
+  // All blocks available again
+  void *blocks[16];
+  for (int i = 0; i < 16; i++) {
+    blocks[i] = pool.alloc();
+    CHECK(blocks[i] != nullptr);
+  }
+  CHECK(pool.alloc() == nullptr);
+  for (int i = 0; i < 16; i++) {
+    pool.release(blocks[i]);
+  }
+}
@@ -0,0 +1,227 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestCalendarTracker.cpp
+//
+// CppUTest unit tests for CalendarTracker - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "CalendarTracker.h"
+#include "PackedReading.h"
+
+static char tzSaved[64];
+static bool tzSet;
+
+static void setTz(const char *tz)
+{
+  const char *cur = getenv("TZ");
+  tzSet = (cur != NULL);
+  if (tzSet) {
+    strncpy(tzSaved, cur, sizeof(tzSaved) - 1);
+  }
+  setenv("TZ", tz, 1);
+  tzset();
+}
+
+static void restoreTz(void)
+{
+  if (tzSet) {
+    setenv("TZ", tzSaved, 1);
+  } else {
+    unsetenv("TZ");
+  }
+  tzset();
+}
+
+static time_t localTime(const char *time)
+{
+  tm tm = {0};
+  strptime(time, "%Y-%m-%d %H:%M", &tm);
+  tm.tm_isdst = -1;
+  return mktime(&tm);
+}
+
+TEST_GROUP(TG_CalendarPeriods) {
+  void setup() {
+    setTz("CET-1CEST,M3.5.0,M10.5.0/3");
+  }
+
+  void teardown() {
+    restoreTz();
+  }
+};
+
+TEST_GROUP(TG_CalendarDst) {
+  void setup() {
+    setTz("CET-1CEST,M3.5.0,M10.5.0/3");
+  }
+
+  void teardown() {
+    restoreTz();
+  }
+};
+
+TEST_GROUP(TG_CalendarTimeBack) {
+  void setup() {
+    setTz("CET-1CEST,M3.5.0,M10.5.0/3");
+  }
+
+  void teardown() {
+    restoreTz();
+  }
+};
+
+TEST_GROUP(TG_CalendarReference) {
+  void setup() {
+    setTz("EST5EDT,M3.2.0,M11.1.0");
+  }
+
+  void teardown() {
+    restoreTz();
+  }
+};
+
+/*
+ * Test day, week and month changes
+ */
+TEST(TG_CalendarPeriods, Test_CalendarPeriods) {
+  CalendarTracker cal;
+
+  printf("< CalendarPeriods >\n");
+
+  // Sunday
+  CHECK_EQUAL(CALENDAR_DAY | CALENDAR_WEEK | CALENDAR_MONTH, cal.update(localTime("2022-09-04 12:00")));
+  CHECK_EQUAL(localTime("2022-09-05 00:00"), cal.nextDay());
+  CHECK_EQUAL(localTime("2022-09-05 00:00"), cal.nextWeek());
+  CHECK_EQUAL(localTime("2022-10-01 00:00"), cal.nextMonth());
+  int32_t day = cal.day();
+  int32_t week = cal.week();
+  int32_t month = cal.month();
+  CHECK_EQUAL(2022 * 12 + 8, month);
+
+  CHECK_EQUAL(0, cal.update(localTime("2022-09-04 23:59")));
+
+  // Monday
+  CHECK_EQUAL(CALENDAR_DAY | CALENDAR_WEEK, cal.update(localTime("2022-09-05 00:00")));
+  CHECK_EQUAL(day + 1, cal.day());
+  CHECK_EQUAL(week + 1, cal.week());
+  CHECK_EQUAL(localTime("2022-09-12 00:00"), cal.nextWeek());
+
+  // Tuesday
+  CHECK_EQUAL(CALENDAR_DAY, cal.update(localTime("2022-09-06 08:00")));
+
+  // Next month (Saturday)
+  CHECK_EQUAL(CALENDAR_DAY | CALENDAR_WEEK | CALENDAR_MONTH, cal.update(localTime("2022-10-01 00:01")));
+  CHECK_EQUAL(month + 1, cal.month());
+  CHECK_EQUAL(localTime("2022-11-01 00:00"), cal.nextMonth());
+
+  // New year
+  cal.update(localTime("2022-12-31 23:59"));
+  CHECK_EQUAL(CALENDAR_DAY | CALENDAR_MONTH, cal.update(localTime("2023-01-01 00:00")));
+  CHECK_EQUAL(2023 * 12, cal.month());
+
+  cal.reset();
+  CHECK_EQUAL(CALENDAR_DAY | CALENDAR_WEEK | CALENDAR_MONTH, cal.update(localTime("2023-01-01 00:00")));
+}
+
+/*
+ * Test days with DST transitions
+ */
+TEST(TG_CalendarDst, Test_CalendarDst) {
+  CalendarTracker cal;
+
+  printf("< CalendarDst >\n");
+
+  // Begin of DST - 23 hours
+  cal.update(localTime("2022-03-27 01:00"));
+  CHECK_EQUAL(23 * 3600, cal.nextDay() - localTime("2022-03-27 00:00"));
+  CHECK_EQUAL(0, cal.update(localTime("2022-03-27 23:59")));
+  CHECK_EQUAL(CALENDAR_DAY | CALENDAR_WEEK, cal.update(localTime("2022-03-28 00:00")));
+
+  // End of DST - 25 hours
+  cal.update(localTime("2022-10-30 00:30"));
+  CHECK_EQUAL(25 * 3600, cal.nextDay() - localTime("2022-10-30 00:00"));
+  CHECK_EQUAL(0, cal.update(localTime("2022-10-30 23:59")));
+  CHECK_EQUAL(CALENDAR_DAY | CALENDAR_WEEK, cal.update(localTime("2022-10-31 00:00")));
+}
+
+/*
+ * Test time going backwards
+ */
+TEST(TG_CalendarTimeBack, Test_CalendarTimeBack) {
+  CalendarTracker cal;
+
+  printf("< CalendarTimeBack >\n");
+
+  cal.update(localTime("2022-10-01 00:10"));
+  int32_t day = cal.day();
+  int32_t month = cal.month();
+
+  CHECK_EQUAL(CALENDAR_DAY | CALENDAR_MONTH, cal.update(localTime("2022-09-30 23:50")));
+  CHECK_EQUAL(day - 1, cal.day());
+  CHECK_EQUAL(month - 1, cal.month());
+  CHECK_EQUAL(localTime("2022-10-01 00:00"), cal.nextDay());
+
+  CHECK_EQUAL(CALENDAR_DAY | CALENDAR_MONTH, cal.update(localTime("2022-10-01 00:20")));
+  CHECK_EQUAL(day, cal.day());
+}
+
+/*
+ * Test against localtime_r() over two years in irregular steps
+ */
+TEST(TG_CalendarReference, Test_CalendarReference) {
+  CalendarTracker cal;
+
+  printf("< CalendarReference >\n");
+
+  time_t ts = localTime("2022-01-01 00:00");
+  time_t end = localTime("2024-01-01 00:00");
+  for (; ts < end; ts += 1237) {
+    cal.update(ts);
+    tm t;
+    localtime_r(&ts, &t);
+    int32_t day = (int32_t)(utcToEpoch(&t) / 86400);
+    CHECK_EQUAL(day, cal.day());
+    CHECK_EQUAL((day + 3) / 7, cal.week());
+    CHECK_EQUAL((t.tm_year + 1900) * 12 + t.tm_mon, cal.month());
+  }
+}
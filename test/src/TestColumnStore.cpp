@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestColumnStore.cpp
+//
+// CppUTest unit tests for ColumnStore - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include "ColumnStore.h"
+
+#define TS_BASE 1662451200UL // 2022-09-06 08:00:00 UTC
+
+static ColumnStore store;
+
+static void setReading(packed_reading_t &p, uint32_t id, uint32_t ts, int16_t temp_dc, uint32_t rain_dmm)
+{
+  memset(&p, 0, sizeof(packed_reading_t));
+  p.epoch = ts;
+  p.sensor_id = id;
+  p.s_type = 1;
+  p.chan = 0;
+  p.temp_dc = temp_dc;
+  p.humidity = 50;
+  p.rain_dmm = rain_dmm;
+  p.flags = PACKED_TEMP_OK | PACKED_HUMIDITY_OK | PACKED_RAIN_OK | PACKED_VALID | PACKED_COMPLETE;
+}
+
+TEST_GROUP(TG_ColumnStoreBasic) {
+  void setup() {
+    store.clear();
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_ColumnStoreRange) {
+  void setup() {
+    store.clear();
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_ColumnStoreRecycle) {
+  void setup() {
+    store.clear();
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test append, read back and out of order rejection
+ */
+TEST(TG_ColumnStoreBasic, Test_ColumnStoreBasic) {
+  packed_reading_t p;
+  packed_reading_t out[4];
+  column_stats_t st;
+
+  printf("< ColumnStoreBasic >\n");
+
+  CHECK_FALSE(store.stats(0x39582376, COL_TEMP, 0, UINT32_MAX, st));
+  LONGS_EQUAL(0, store.read(0x39582376, 0, UINT32_MAX, out, 4));
+
+  setReading(p, 0x39582376, TS_BASE, 327, 156);
+  p.wind_dir_deg = 270;
+  p.wind_gust_dms = 25;
+  p.wind_avg_dms = 18;
+  p.flags |= PACKED_WIND_OK;
+  CHECK(store.append(p));
+  LONGS_EQUAL(1, store.rows(0x39582376));
+
+  LONGS_EQUAL(1, store.read(0x39582376, 0, UINT32_MAX, out, 4));
+  MEMCMP_EQUAL(&p, &out[0], sizeof(packed_reading_t));
+
+  // Older than newest row
+  setReading(p, 0x39582376, TS_BASE - 1, 327, 156);
+  CHECK_FALSE(store.append(p));
+  LONGS_EQUAL(1, store.droppedRows());
+
+  // Same timestamp is accepted
+  setReading(p, 0x39582376, TS_BASE, 330, 156);
+  CHECK(store.append(p));
+
+  CHECK(store.stats(0x39582376, COL_TEMP, 0, UINT32_MAX, st));
+  LONGS_EQUAL(2, st.count);
+  DOUBLES_EQUAL(32.7, st.min, 0.001);
+  DOUBLES_EQUAL(33.0, st.max, 0.001);
+  DOUBLES_EQUAL(32.85, st.mean, 0.001);
+  DOUBLES_EQUAL(32.7, st.first, 0.001);
+  DOUBLES_EQUAL(33.0, st.last, 0.001);
+
+  // Wind is only valid in the first row
+  CHECK(store.stats(0x39582376, COL_WIND_AVG, 0, UINT32_MAX, st));
+  LONGS_EQUAL(1, st.count);
+  DOUBLES_EQUAL(1.8, st.mean, 0.001);
+  CHECK_FALSE(store.stats(0x39582376, COL_UV, 0, UINT32_MAX, st));
+}
+
+/*
+ * Test range queries across block boundaries
+ */
+TEST(TG_ColumnStoreRange, Test_ColumnStoreRange) {
+  packed_reading_t p;
+  column_stats_t st;
+
+  printf("< ColumnStoreRange >\n");
+
+  // 200 readings, 60 s apart - temperature 0.0, 0.1, ... 19.9 degC
+  for (int i = 0; i < 200; i++) {
+    setReading(p, 0x12345678, TS_BASE + i * 60, i, 1000 + i);
+    if (i == 100) {
+      // Temperature missing
+      p.flags &= ~PACKED_TEMP_OK;
+    }
+    CHECK(store.append(p));
+  }
+  LONGS_EQUAL(200, store.rows(0x12345678));
+
+  // Rows 50...149, range boundaries between timestamps
+  CHECK(store.stats(0x12345678, COL_TEMP, TS_BASE + 50 * 60 - 30, TS_BASE + 149 * 60 + 30, st));
+  LONGS_EQUAL(99, st.count);
+  DOUBLES_EQUAL(5.0, st.min, 0.001);
+  DOUBLES_EQUAL(14.9, st.max, 0.001);
+  DOUBLES_EQUAL((9950 - 100) / 99.0 / 10.0, st.mean, 0.001);
+  LONGS_EQUAL(TS_BASE + 50 * 60, st.first_ts);
+  LONGS_EQUAL(TS_BASE + 149 * 60, st.last_ts);
+
+  // Rain difference over the last hour
+  CHECK(store.stats(0x12345678, COL_RAIN, TS_BASE + 199 * 60 - 3600, TS_BASE + 199 * 60, st));
+  LONGS_EQUAL(61, st.count);
+  DOUBLES_EQUAL(6.0, st.last - st.first, 0.001);
+
+  // Empty ranges
+  CHECK_FALSE(store.stats(0x12345678, COL_TEMP, TS_BASE + 30, TS_BASE + 59, st));
+  CHECK_FALSE(store.stats(0x12345678, COL_TEMP, TS_BASE + 200 * 60, UINT32_MAX, st));
+  CHECK_FALSE(store.stats(0x12345678, COL_TEMP, 0, TS_BASE - 1, st));
+
+  // Read with limited buffer
+  packed_reading_t out[10];
+  LONGS_EQUAL(10, store.read(0x12345678, TS_BASE + 60 * 60, UINT32_MAX, out, 10));
+  LONGS_EQUAL(TS_BASE + 60 * 60, out[0].epoch);
+  LONGS_EQUAL(TS_BASE + 69 * 60, out[9].epoch);
+  LONGS_EQUAL(2, store.read(0x12345678, TS_BASE + 63, TS_BASE + 180, out, 10));
+}
+
+/*
+ * Test recycling of blocks and series when the pool is exhausted
+ */
+TEST(TG_ColumnStoreRecycle, Test_ColumnStoreRecycle) {
+  packed_reading_t p;
+  column_stats_t st;
+  const int capacity = COLUMN_STORE_BLOCKS * COLUMN_STORE_BLOCK_SIZE;
+
+  printf("< ColumnStoreRecycle >\n");
+
+  // Second sensor with a single block
+  setReading(p, 0x22222222, TS_BASE, 100, 0);
+  CHECK(store.append(p));
+
+  // First sensor fills the pool - its own oldest blocks are recycled
+  for (int i = 0; i < 2 * capacity; i++) {
+    setReading(p, 0x11111111, TS_BASE + i, i % 1000, 0);
+    CHECK(store.append(p));
+  }
+  LONGS_EQUAL(1, store.rows(0x22222222));
+  uint32_t rows = store.rows(0x11111111);
+  CHECK(rows <= (uint32_t)(capacity - COLUMN_STORE_BLOCK_SIZE));
+  CHECK(rows > (uint32_t)(capacity - 2 * COLUMN_STORE_BLOCK_SIZE));
+
+  // Newest rows are still there
+  CHECK(store.stats(0x11111111, COL_TEMP, TS_BASE + 2 * capacity - 1, UINT32_MAX, st));
+  DOUBLES_EQUAL(((2 * capacity - 1) % 1000) * 0.1, st.last, 0.001);
+
+  // New sensors replace the least recently updated series
+  for (uint32_t id = 1; id < COLUMN_STORE_SERIES; id++) {
+    setReading(p, id, TS_BASE + 2 * capacity + id, 0, 0);
+    CHECK(store.append(p));
+  }
+  LONGS_EQUAL(0, store.rows(0x22222222));
+  CHECK(store.rows(0x11111111) > 0);
+}
@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestGaugeManager.cpp
+//
+// CppUTest unit tests for GaugeManager - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Added lightning test
+// 20261019 Added test for reset and update across restarts
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include "GaugeManager.h"
+
+#define TOLERANCE 0.1
+#define BASE 1662465600L // 2022-09-06 12:00:00 UTC
+
+static weather_data_t frame(uint32_t id, float rain, bool rain_ok = true)
+{
+  weather_data_t ws;
+  memset(&ws, 0, sizeof(ws));
+  ws.sensor_id = id;
+  ws.rain_mm = rain;
+  ws.rain_ok = rain_ok;
+  return ws;
+}
+
+/*
+ * Storage in RAM for the state - survives the GaugeManager objects (simulated restarts)
+ */
+class GaugeStorage : public BlobStorage {
+public:
+  uint8_t  rec[4][sizeof(gauge_state_t)];
+  size_t   len[4];
+
+  GaugeStorage() {
+    memset(len, 0, sizeof(len));
+  }
+
+  int index(const char *key) {
+    return ((key[0] == 'h') ? 0 : 1) + ((key[1] == '1') ? 2 : 0);
+  }
+
+  size_t read(const char *key, void *buf, size_t n) {
+    int i = index(key);
+    if (len[i] == 0 || n < len[i])
+      return 0;
+    memcpy(buf, rec[i], len[i]);
+    return len[i];
+  }
+
+  bool write(const char *key, const void *buf, size_t n) {
+    int i = index(key);
+    memcpy(rec[i], buf, n);
+    len[i] = n;
+    return true;
+  }
+};
+
+TEST_GROUP(TG_GaugeManagerRoute) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_GaugeManagerEvict) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_GaugeManagerLightning) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_GaugeManagerRestart) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test routing of frames by sensor ID
+ */
+TEST(TG_GaugeManagerRoute, Test_GaugeManagerRoute) {
+  GaugeManager gauges;
+  bool valid;
+
+  printf("< GaugeManagerRoute >\n");
+
+  CHECK_EQUAL(0, gauges.size());
+  CHECK(gauges.rainGauge(0x11) == nullptr);
+  DOUBLES_EQUAL(-1, gauges.currentDay(0x11), TOLERANCE);
+  DOUBLES_EQUAL(0, gauges.pastHour(0x11, &valid), TOLERANCE);
+  CHECK_FALSE(valid);
+
+  // Frames without rain data are ignored
+  CHECK(gauges.update(frame(0x33, 0, false), BASE) == nullptr);
+  CHECK_EQUAL(0, gauges.size());
+
+  // Two sensors, interleaved
+  for (int i = 0; i <= 10; i++) {
+    time_t ts = BASE + i * 360;
+    RainGauge *rg = gauges.update(frame(0x11, 10.0 + i * 0.2), ts);
+    CHECK(rg == gauges.rainGauge(0x11));
+    gauges.update(frame(0x22, 500.0 + i * 1.0), ts + 12);
+  }
+  CHECK_EQUAL(2, gauges.size());
+  CHECK(gauges.rainGauge(0x11) != gauges.rainGauge(0x22));
+
+  DOUBLES_EQUAL(2.0, gauges.pastHour(0x11, &valid), TOLERANCE);
+  CHECK(valid);
+  DOUBLES_EQUAL(10.0, gauges.pastHour(0x22, &valid), TOLERANCE);
+  CHECK(valid);
+  DOUBLES_EQUAL(2.0, gauges.currentDay(0x11), TOLERANCE);
+  DOUBLES_EQUAL(10.0, gauges.currentDay(0x22), TOLERANCE);
+  DOUBLES_EQUAL(10.0, gauges.currentWeek(0x22), TOLERANCE);
+  DOUBLES_EQUAL(10.0, gauges.currentMonth(0x22), TOLERANCE);
+  DOUBLES_EQUAL(0.4, gauges.window(0x11, 10), TOLERANCE);
+  DOUBLES_EQUAL(2.0, gauges.window(0x22, 10), TOLERANCE);
+
+  gauges.reset();
+  CHECK_EQUAL(0, gauges.size());
+  CHECK(gauges.rainGauge(0x11) == nullptr);
+}
+
+/*
+ * Test replacement of the sensor updated least recently
+ */
+TEST(TG_GaugeManagerEvict, Test_GaugeManagerEvict) {
+  GaugeManager gauges;
+
+  printf("< GaugeManagerEvict >\n");
+
+  for (uint32_t id = 1; id <= GAUGE_MANAGER_SIZE; id++) {
+    gauges.update(frame(id, 10.0), BASE + id);
+  }
+  CHECK_EQUAL(GAUGE_MANAGER_SIZE, gauges.size());
+
+  // Sensor 1 updated again - sensor 2 is the least recently updated one
+  gauges.update(frame(1, 11.0), BASE + 100);
+  gauges.update(frame(0x99, 20.0), BASE + 101);
+  CHECK_EQUAL(GAUGE_MANAGER_SIZE, gauges.size());
+  CHECK(gauges.rainGauge(2) == nullptr);
+  CHECK(gauges.rainGauge(1) != nullptr);
+  CHECK(gauges.rainGauge(0x99) != nullptr);
+
+  // New sensor starts from scratch
+  DOUBLES_EQUAL(0, gauges.currentDay(0x99), TOLERANCE);
+  DOUBLES_EQUAL(1.0, gauges.currentDay(1), TOLERANCE);
+}
+
+/*
+ * Test routing of lightning sensor data by sensor ID
+ */
+TEST(TG_GaugeManagerLightning, Test_GaugeManagerLightning) {
+  GaugeManager gauges;
+  bool valid;
+  time_t ts;
+  int events;
+  uint8_t distance;
+
+  printf("< GaugeManagerLightning >\n");
+
+  CHECK(gauges.lightningSensor(0x44) == nullptr);
+  CHECK_EQUAL(0, gauges.lightningPastHour(0x44, &valid));
+  CHECK_FALSE(valid);
+  CHECK(gauges.updateLightning(0, BASE, 0, 0) == nullptr);
+
+  uint8_t alerts;
+  for (int i = 0; i <= 10; i++) {
+    Lightning *lgt = gauges.updateLightning(0x44, BASE + i * 360, 100 + 3 * i, 7, false, &alerts);
+    CHECK(lgt == gauges.lightningSensor(0x44));
+    // The first update only sets the counter baseline
+    CHECK_EQUAL((i == 1) ? (STORM_START | STORM_NEARBY) : 0, alerts);
+  }
+  CHECK(gauges.storm(0x44)->isActive());
+  CHECK_EQUAL(7, gauges.storm(0x44)->closest(BASE + 3600));
+  CHECK_EQUAL(30, gauges.lightningPastHour(0x44, &valid));
+  CHECK(valid);
+  CHECK(gauges.lightningSensor(0x44)->lastEvent(ts, events, distance));
+  CHECK_EQUAL(7, distance);
+
+  // Lightning sensors do not occupy rain gauges
+  CHECK_EQUAL(0, gauges.size());
+
+  // Second sensor - replaces the first one if the pool is full
+  gauges.updateLightning(0x55, BASE + 4000, 50, 3);
+  CHECK(gauges.lightningSensor(0x55) != nullptr);
+  if (GAUGE_MANAGER_LIGHTNING == 1) {
+    CHECK(gauges.lightningSensor(0x44) == nullptr);
+  }
+  CHECK_EQUAL(0, gauges.lightningPastHour(0x55));
+
+  gauges.reset();
+  CHECK(gauges.lightningSensor(0x55) == nullptr);
+}
+
+/*
+ * Test reset and update across simulated restarts
+ */
+TEST(TG_GaugeManagerRestart, Test_GaugeManagerRestart) {
+  GaugeStorage storage;
+
+  printf("< GaugeManagerRestart >\n");
+
+  {
+    GaugeManager gauges(storage);
+    for (int i = 0; i <= 10; i++) {
+      gauges.update(frame(0x11, 10.0 + i * 0.2), BASE + i * 360);
+    }
+    DOUBLES_EQUAL(2.0, gauges.currentDay(0x11), TOLERANCE);
+    gauges.flush();
+  }
+
+  // Restart - sensor and its rain gauge are restored by the first update
+  {
+    GaugeManager gauges(storage);
+    gauges.update(frame(0x11, 12.4), BASE + 11 * 360);
+    CHECK_EQUAL(1, gauges.size());
+    DOUBLES_EQUAL(2.4, gauges.currentDay(0x11), TOLERANCE);
+
+    // Reset after the state has been loaded
+    gauges.reset();
+    CHECK_EQUAL(0, gauges.size());
+  }
+
+  // Restart - the reset is not undone
+  {
+    GaugeManager gauges(storage);
+    gauges.update(frame(0x22, 500.0), BASE + 12 * 360);
+    CHECK_EQUAL(1, gauges.size());
+    CHECK(gauges.rainGauge(0x11) == nullptr);
+    gauges.flush();
+  }
+
+  // Restart - reset before the first update
+  {
+    GaugeManager gauges(storage);
+    gauges.reset();
+    gauges.update(frame(0x33, 100.0), BASE + 13 * 360);
+    CHECK_EQUAL(1, gauges.size());
+    CHECK(gauges.rainGauge(0x22) == nullptr);
+  }
+
+  // Restart - the reset before the first update is not undone
+  {
+    GaugeManager gauges(storage);
+    gauges.update(frame(0x44, 200.0), BASE + 14 * 360);
+    CHECK(gauges.rainGauge(0x22) == nullptr);
+    CHECK(gauges.rainGauge(0x11) == nullptr);
+  }
+}
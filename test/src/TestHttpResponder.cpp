@@ -0,0 +1,314 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestHttpResponder.cpp
+//
+// CppUTest unit tests for HttpResponder - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Added test of metric family grouping
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include "HttpResponder.h"
+
+#define TS_BASE 1662451200UL // 2022-09-06 08:00:00 UTC
+
+static SnapshotTable snapshots;
+static ColumnStore store;
+static SensorTable sensors;
+static char response[16384];
+
+// Complete response to 'req', produced in pieces of at most 'chunk' (< sizeof(response)) bytes
+static size_t respond(HttpResponder &responder, const char *req, size_t chunk)
+{
+  static char buf[sizeof(response)];
+  http_cursor_t cursor;
+  size_t len = 0;
+  size_t n;
+
+  responder.begin(req, strlen(req), cursor);
+  while ((n = responder.fill(cursor, buf, chunk)) > 0) {
+    if (len + n < sizeof(response)) {
+      memcpy(response + len, buf, n);
+    }
+    len += n;
+  }
+  response[(len < sizeof(response)) ? len : 0] = '\0';
+  return len;
+}
+
+// Number of occurrences of 's' in the response
+static int count(const char *s)
+{
+  int n = 0;
+  for (const char *p = strstr(response, s); p; p = strstr(p + 1, s)) {
+    n++;
+  }
+  return n;
+}
+
+// Check that each metric family is one contiguous group starting with its TYPE line
+static bool grouped(const char *text)
+{
+  char done[64][64];
+  char current[64] = "";
+  int n = 0;
+
+  for (const char *line = text; *line; ) {
+    const char *end = strchr(line, '\n');
+    if (!end)
+      return false;
+    char name[64];
+    if (strncmp(line, "# TYPE ", 7) == 0) {
+      sscanf(line + 7, "%63s", name);
+      for (int i = 0; i < n; i++) {
+        if (strcmp(done[i], name) == 0)
+          return false;
+      }
+      if (n == 64)
+        return false;
+      strcpy(done[n++], name);
+      strcpy(current, name);
+    } else {
+      size_t k = strcspn(line, "{ ");
+      if ((k != strlen(current)) || (strncmp(line, current, k) != 0))
+        return false;
+    }
+    line = end + 1;
+  }
+  return true;
+}
+
+// Response body
+static const char *body(void)
+{
+  const char *p = strstr(response, "\r\n\r\n");
+  return p ? p + 4 : "";
+}
+
+TEST_GROUP(TG_HttpResponderLatest) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_HttpResponderHistory) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_HttpResponderMetrics) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_HttpResponderErrors) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test latest readings from the SnapshotTable
+ */
+TEST(TG_HttpResponderLatest, Test_HttpResponderLatest) {
+  HttpResponder responder(&snapshots, nullptr, nullptr);
+  weather_data_t ws;
+
+  printf("< HttpResponderLatest >\n");
+
+  snapshots.clear();
+  respond(responder, "GET /latest HTTP/1.1\r\n\r\n", HTTP_ITEM_SIZE);
+  CHECK(strncmp(response, "HTTP/1.1 200 OK\r\n", 17) == 0);
+  CHECK(strstr(response, "Content-Type: application/json\r\n") != nullptr);
+  STRCMP_EQUAL("[]\n", body());
+
+  memset(&ws, 0, sizeof(ws));
+  ws.sensor_id = 0x1234;
+  ws.timestamp.tm_year = 122;
+  ws.timestamp.tm_mon = 8;
+  ws.timestamp.tm_mday = 6;
+  ws.timestamp.tm_hour = 8;
+  ws.temp_c = 21.5f;
+  ws.temp_ok = true;
+  ws.humidity = 55;
+  ws.humidity_ok = true;
+  ws.battery_ok = true;
+  snapshots.write(ws);
+  ws.sensor_id = 0x5678;
+  ws.humidity_ok = false;
+  ws.rain_mm = 12.3f;
+  ws.rain_ok = true;
+  snapshots.write(ws);
+
+  respond(responder, "GET /latest HTTP/1.1\r\nHost: receiver\r\n\r\n", HTTP_ITEM_SIZE);
+  STRCMP_EQUAL("[{\"sensor_id\":4660,\"timestamp\":\"2022-09-06T08:00:00Z\",\"temperature\":21.5,"
+               "\"humidity\":55,\"battery_ok\":true},"
+               "{\"sensor_id\":22136,\"timestamp\":\"2022-09-06T08:00:00Z\",\"temperature\":21.5,"
+               "\"rain\":12.3,\"rain_rate\":0.0,\"battery_ok\":true}]\n", body());
+}
+
+/*
+ * Test history streamed in pieces, including rows with equal timestamps
+ */
+TEST(TG_HttpResponderHistory, Test_HttpResponderHistory) {
+  HttpResponder responder(nullptr, &store, nullptr);
+  packed_reading_t p;
+
+  printf("< HttpResponderHistory >\n");
+
+  store.clear();
+  for (uint32_t i = 0; i < 200; i++) {
+    // Two rows per timestamp
+    memset(&p, 0, sizeof(p));
+    p.epoch = TS_BASE + (i / 2) * 60;
+    p.sensor_id = 1;
+    p.temp_dc = 200 + i;
+    p.flags = PACKED_TEMP_OK;
+    store.append(p);
+  }
+
+  char req[96];
+  snprintf(req, sizeof(req), "GET /history?sensor=1&from=%lu&to=%lu HTTP/1.1\r\n\r\n",
+           TS_BASE + 10 * 60, TS_BASE + 59 * 60);
+
+  // Buffer for only a few rows per call
+  size_t len = respond(responder, req, HTTP_ITEM_SIZE);
+  CHECK(len < sizeof(response));
+  const char *first = "{\"sensor_id\":1,\"rows\":[{\"timestamp\":\"2022-09-06T08:10:00Z\",\"temperature\":22.0},";
+  CHECK(strncmp(body(), first, strlen(first)) == 0);
+  CHECK_EQUAL(100, count("timestamp"));
+  CHECK_EQUAL(1, count("\"temperature\":22.0}"));
+  CHECK_EQUAL(1, count("\"temperature\":31.9}"));
+  CHECK_EQUAL(0, count(",,"));
+  CHECK_EQUAL(0, count("}{"));
+  CHECK(strcmp(response + len - 3, "]}\n") == 0);
+
+  // Same result with a large buffer
+  size_t len2 = respond(responder, req, sizeof(response) - 1);
+  CHECK_EQUAL(len, len2);
+
+  // Whole range, hexadecimal sensor ID
+  respond(responder, "GET /history?sensor=0x1 HTTP/1.1\r\n\r\n", HTTP_ITEM_SIZE);
+  CHECK_EQUAL(200, count("timestamp"));
+
+  // Unknown sensor
+  respond(responder, "GET /history?sensor=2 HTTP/1.1\r\n\r\n", HTTP_ITEM_SIZE);
+  STRCMP_EQUAL("{\"sensor_id\":2,\"rows\":[]}\n", body());
+}
+
+/*
+ * Test metrics
+ */
+TEST(TG_HttpResponderMetrics, Test_HttpResponderMetrics) {
+  HttpResponder responder(&snapshots, &store, &sensors);
+
+  printf("< HttpResponderMetrics >\n");
+
+  sensors.clear();
+  sensor_state_t *s = sensors.lookup(0x1234);
+  s->frames = 5;
+  s->published = 4;
+  s->link.reset();
+  s->link.update(0, -86.0f, 1);
+  s->link.update(12000000LL, -88.0f, 2);
+  s->link.update(36000000LL, -87.0f, 3);
+  s->link.digestError();
+  sensor_state_t *s2 = sensors.lookup(0x55);
+  s2->frames = 7;
+
+  responder.stats().connections = 3;
+  respond(responder, "GET /metrics HTTP/1.1\r\n\r\n", HTTP_ITEM_SIZE);
+  CHECK(strstr(response, "Content-Type: text/plain; version=0.0.4\r\n") != nullptr);
+  CHECK_EQUAL(1, count("weather_http_requests_total 1\n"));
+  CHECK_EQUAL(1, count("weather_http_connections_total 3\n"));
+  CHECK_EQUAL(1, count("weather_sensors 2\n"));
+  CHECK(grouped(body()));
+  CHECK_EQUAL(1, count("# TYPE weather_frames_total counter\n"));
+  CHECK_EQUAL(1, count("# TYPE weather_rssi_dbm gauge\n"));
+  CHECK_EQUAL(1, count("weather_frames_total{sensor=\"85\"} 7\n"));
+  CHECK_EQUAL(1, count("weather_frames_total{sensor=\"4660\"} 5\n"));
+  CHECK_EQUAL(1, count("weather_published_total{sensor=\"4660\"} 4\n"));
+  CHECK_EQUAL(1, count("weather_link_received_total{sensor=\"4660\"} 3\n"));
+  CHECK_EQUAL(1, count("weather_link_expected_total{sensor=\"4660\"} 4\n"));
+  CHECK_EQUAL(1, count("weather_link_duplicates_total{sensor=\"4660\"} 0\n"));
+  CHECK_EQUAL(1, count("weather_link_digest_errors_total{sensor=\"4660\"} 1\n"));
+  CHECK_EQUAL(1, count("weather_link_period_seconds{sensor=\"4660\"} 12.000\n"));
+  CHECK_EQUAL(1, count("weather_rssi_dbm{sensor=\"4660\"} -87.0\n"));
+  CHECK_EQUAL(1, count("weather_rssi_stddev_db{sensor=\"4660\"} 1.00\n"));
+  CHECK_EQUAL(1, count("weather_store_rows{sensor=\"4660\"} 0\n"));
+}
+
+/*
+ * Test error responses
+ */
+TEST(TG_HttpResponderErrors, Test_HttpResponderErrors) {
+  HttpResponder responder(&snapshots, &store, &sensors);
+
+  printf("< HttpResponderErrors >\n");
+
+  respond(responder, "POST /latest HTTP/1.1\r\n\r\n", HTTP_ITEM_SIZE);
+  CHECK(strncmp(response, "HTTP/1.1 405 Method Not Allowed\r\n", 33) == 0);
+
+  respond(responder, "GET /index.html HTTP/1.1\r\n\r\n", HTTP_ITEM_SIZE);
+  CHECK(strncmp(response, "HTTP/1.1 404 Not Found\r\n", 24) == 0);
+  STRCMP_EQUAL("{\"error\":\"Not Found\"}\n", body());
+
+  respond(responder, "GET /history?from=1 HTTP/1.1\r\n\r\n", HTTP_ITEM_SIZE);
+  CHECK(strncmp(response, "HTTP/1.1 400 Bad Request\r\n", 26) == 0);
+  respond(responder, "GET /history?sensor=abc HTTP/1.1\r\n\r\n", HTTP_ITEM_SIZE);
+  CHECK(strncmp(response, "HTTP/1.1 400 Bad Request\r\n", 26) == 0);
+  respond(responder, "GET /history?sensor=1&from=20&to=10 HTTP/1.1\r\n\r\n", HTTP_ITEM_SIZE);
+  CHECK(strncmp(response, "HTTP/1.1 400 Bad Request\r\n", 26) == 0);
+  respond(responder, "GARBAGE", HTTP_ITEM_SIZE);
+  CHECK(strncmp(response, "HTTP/1.1 400 Bad Request\r\n", 26) == 0);
+
+  CHECK_EQUAL(6, responder.stats().requests);
+  CHECK_EQUAL(6, responder.stats().errors);
+}
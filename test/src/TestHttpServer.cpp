@@ -0,0 +1,244 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestHttpServer.cpp
+//
+// CppUTest unit tests for HttpServer - load test with concurrent clients on the loopback interface
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include <thread>
+#include <atomic>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "HttpServer.h"
+
+#define TS_BASE 1662451200UL // 2022-09-06 08:00:00 UTC
+#define LOAD_CLIENTS  32
+#define LOAD_REQUESTS 20
+
+static SnapshotTable snapshots;
+static ColumnStore store;
+
+static int connectTo(uint16_t port)
+{
+  struct sockaddr_in addr;
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Send request in pieces of 'piece' bytes, receive response until the server closes
+static size_t request(uint16_t port, const char *req, size_t piece, char *resp, size_t max)
+{
+  int fd = connectTo(port);
+  size_t len = 0;
+
+  if (fd < 0) {
+    return 0;
+  }
+  for (size_t pos = 0; pos < strlen(req); pos += piece) {
+    size_t n = strlen(req) - pos;
+    send(fd, req + pos, (n < piece) ? n : piece, MSG_NOSIGNAL);
+    if (n > piece) {
+      usleep(20000);
+    }
+  }
+  for (;;) {
+    ssize_t n = recv(fd, resp + len, max - len - 1, 0);
+    if (n <= 0) {
+      break;
+    }
+    len += n;
+  }
+  resp[len] = '\0';
+  close(fd);
+  return len;
+}
+
+// Test data - history of one sensor, latest reading of two sensors
+static void setup_data(void)
+{
+  packed_reading_t p;
+  weather_data_t ws;
+
+  store.clear();
+  for (uint32_t i = 0; i < 300; i++) {
+    memset(&p, 0, sizeof(p));
+    p.epoch = TS_BASE + i * 60;
+    p.sensor_id = 1;
+    p.temp_dc = 200 + i % 50;
+    p.humidity = 60;
+    p.flags = PACKED_TEMP_OK | PACKED_HUMIDITY_OK;
+    store.append(p);
+  }
+  snapshots.clear();
+  memset(&ws, 0, sizeof(ws));
+  ws.sensor_id = 1;
+  ws.temp_c = 21.5f;
+  ws.temp_ok = true;
+  snapshots.write(ws);
+  ws.sensor_id = 2;
+  snapshots.write(ws);
+}
+
+TEST_GROUP(TG_HttpServerLoad) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_HttpServerPartial) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test many concurrent clients - more than HTTP_MAX_CLIENTS, so connections also wait
+ * in the backlog; every response must be complete
+ */
+TEST(TG_HttpServerLoad, Test_HttpServerLoad) {
+  static HttpResponder responder(&snapshots, &store, nullptr);
+  static HttpServer server(responder);
+  static char expected[2][32768];
+  static const char *reqs[2] = {
+    "GET /latest HTTP/1.1\r\nHost: receiver\r\n\r\n",
+    "GET /history?sensor=1 HTTP/1.1\r\nHost: receiver\r\n\r\n"
+  };
+  std::atomic<int> finished(0);
+  std::atomic<int> errors(0);
+  std::thread clients[LOAD_CLIENTS];
+
+  printf("< HttpServerLoad >\n");
+
+  setup_data();
+  CHECK(server.begin(0));
+  CHECK(server.port() != 0);
+
+  // Reference responses
+  for (int r = 0; r < 2; r++) {
+    http_cursor_t cursor;
+    size_t len = 0;
+    size_t n;
+    responder.begin(reqs[r], strlen(reqs[r]), cursor);
+    while ((n = responder.fill(cursor, expected[r] + len, sizeof(expected[r]) - 1 - len)) > 0) {
+      len += n;
+    }
+    expected[r][len] = '\0';
+  }
+  CHECK(strlen(expected[1]) > 10 * HTTP_RESPONSE_SIZE);
+  responder.reset();
+
+  uint16_t port = server.port();
+  for (int i = 0; i < LOAD_CLIENTS; i++) {
+    clients[i] = std::thread([&, i]() {
+      static thread_local char resp[32768];
+      for (int k = 0; k < LOAD_REQUESTS; k++) {
+        int r = (i + k) & 1;
+        request(port, reqs[r], strlen(reqs[r]), resp, sizeof(resp));
+        if (strcmp(resp, expected[r]) != 0) {
+          errors++;
+        }
+      }
+      finished++;
+    });
+  }
+
+  while (finished < LOAD_CLIENTS) {
+    server.poll(10);
+  }
+  for (int i = 0; i < LOAD_CLIENTS; i++) {
+    clients[i].join();
+  }
+
+  http_stats_t &stats = responder.stats();
+  printf("%u connections, %u requests\n", stats.connections, stats.requests);
+  CHECK_EQUAL(0, errors.load());
+  CHECK_EQUAL(LOAD_CLIENTS * LOAD_REQUESTS, stats.connections);
+  CHECK_EQUAL(LOAD_CLIENTS * LOAD_REQUESTS, stats.requests);
+  CHECK_EQUAL(0, stats.errors);
+  CHECK_EQUAL(0, stats.active);
+  server.end();
+  CHECK_EQUAL(-1, server.poll(0));
+}
+
+/*
+ * Test request received in several pieces
+ */
+TEST(TG_HttpServerPartial, Test_HttpServerPartial) {
+  static HttpResponder responder(&snapshots, &store, nullptr);
+  static HttpServer server(responder);
+  static char resp[4096];
+  std::atomic<bool> done(false);
+
+  printf("< HttpServerPartial >\n");
+
+  setup_data();
+  CHECK(server.begin(0));
+  uint16_t port = server.port();
+  std::thread client([&]() {
+    request(port, "GET /latest HTTP/1.1\r\nHost: receiver\r\n\r\n", 5, resp, sizeof(resp));
+    done = true;
+  });
+  while (!done) {
+    server.poll(10);
+  }
+  client.join();
+
+  CHECK(strncmp(resp, "HTTP/1.1 200 OK\r\n", 17) == 0);
+  CHECK(strstr(resp, "\r\n\r\n[{\"sensor_id\":1,") != nullptr);
+  CHECK_EQUAL(1, responder.stats().requests);
+  CHECK_EQUAL(0, responder.stats().active);
+}
@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestIntervalAggregator.cpp
+//
+// CppUTest unit tests for IntervalAggregator - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include "IntervalAggregator.h"
+
+#define TOLERANCE 0.01
+#define BASE 1662465600UL// 2022-09-06 12:00:00 UTC
+
+static weather_data_t frame(float temp, uint8_t hum, float wind, float dir, bool ok = true)
+{
+  weather_data_t ws;
+  memset(&ws, 0, sizeof(ws));
+  ws.sensor_id = 0x11;
+  ws.temp_c = temp;
+  ws.temp_ok = ok;
+  ws.humidity = hum;
+  ws.humidity_ok = ok;
+  ws.wind_avg_meter_sec = wind;
+  ws.wind_gust_meter_sec = wind * 2;
+  ws.wind_direction_deg = dir;
+  ws.wind_ok = ok;
+  ws.rain_ok = true;
+  return ws;
+}
+
+TEST_GROUP(TG_AggregatorStats) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_AggregatorBoundary) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_AggregatorChannels) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_AggregatorPoll) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test statistics of one interval
+ */
+TEST(TG_AggregatorStats, Test_AggregatorStats) {
+  IntervalAggregator agg;
+  agg_interval_t iv;
+  agg.reset();
+
+  printf("< AggregatorStats >\n");
+
+  CHECK_EQUAL(0, agg.current().start);
+
+  // 12 s frames - 25 per interval
+  for (int i = 0; i < 25; i++) {
+    CHECK_FALSE(agg.update(BASE + i * 12, frame(20.0 + i * 0.1, 50 + i, 2.0, 180), 0.2, &iv));
+  }
+  const agg_interval_t &cur = agg.current();
+  CHECK_EQUAL(BASE, cur.start);
+  CHECK_EQUAL(25, cur.frames);
+  CHECK_EQUAL(25, cur.stat[AGG_TEMP].count);
+  DOUBLES_EQUAL(21.2, aggMean(cur, AGG_TEMP), TOLERANCE);
+  DOUBLES_EQUAL(20.0, cur.stat[AGG_TEMP].min, TOLERANCE);
+  DOUBLES_EQUAL(22.4, cur.stat[AGG_TEMP].max, TOLERANCE);
+  DOUBLES_EQUAL(22.4, cur.stat[AGG_TEMP].last, TOLERANCE);
+  DOUBLES_EQUAL(62, aggMean(cur, AGG_HUMIDITY), TOLERANCE);
+  DOUBLES_EQUAL(2.0, aggMean(cur, AGG_WIND_SPEED), TOLERANCE);
+  DOUBLES_EQUAL(4.0, cur.stat[AGG_WIND_GUST].max, TOLERANCE);
+  DOUBLES_EQUAL(180, cur.wind.direction(), TOLERANCE);
+  CHECK_EQUAL(25, cur.wind.count());
+  DOUBLES_EQUAL(5.0, cur.stat[AGG_RAIN].sum, TOLERANCE);
+
+  agg.reset();
+  CHECK_EQUAL(0, agg.current().start);
+  CHECK_EQUAL(0, agg.current().frames);
+}
+
+/*
+ * Test closing of intervals on boundary crossings
+ */
+TEST(TG_AggregatorBoundary, Test_AggregatorBoundary) {
+  IntervalAggregator agg;
+  agg_interval_t iv;
+  agg.reset();
+
+  printf("< AggregatorBoundary >\n");
+
+  // Start within the interval - interval is aligned anyway
+  agg.update(BASE + 100, frame(10, 40, 1, 90), 0, &iv);
+  agg.update(BASE + 299, frame(12, 42, 1, 90), 0, &iv);
+  CHECK_EQUAL(BASE, agg.current().start);
+
+  // Boundary crossed - summary of previous interval returned
+  CHECK(agg.update(BASE + 300, frame(30, 60, 1, 90), 0, &iv));
+  CHECK_EQUAL(BASE, iv.start);
+  CHECK_EQUAL(2, iv.frames);
+  DOUBLES_EQUAL(11, aggMean(iv, AGG_TEMP), TOLERANCE);
+  CHECK_EQUAL(BASE + 300, agg.current().start);
+  CHECK_EQUAL(1, agg.current().frames);
+
+  // Out of order frame from previous interval ignored
+  CHECK_FALSE(agg.update(BASE + 200, frame(99, 99, 9, 9), 0, &iv));
+  CHECK_EQUAL(1, agg.current().frames);
+
+  // Gap of several intervals - only intervals with data produce a summary
+  CHECK(agg.update(BASE + 1500, frame(15, 45, 1, 90), 0, &iv));
+  CHECK_EQUAL(BASE + 300, iv.start);
+  DOUBLES_EQUAL(30, aggMean(iv, AGG_TEMP), TOLERANCE);
+  CHECK_EQUAL(BASE + 1500, agg.current().start);
+}
+
+/*
+ * Test measurements not flagged as o.k. and missing rain increments
+ */
+TEST(TG_AggregatorChannels, Test_AggregatorChannels) {
+  IntervalAggregator agg;
+  agg_interval_t iv;
+  agg.reset();
+
+  printf("< AggregatorChannels >\n");
+
+  agg.update(BASE, frame(10, 40, 1, 90, false), -1, &iv);
+  agg.update(BASE + 12, frame(20, 50, 3, 270), 0.4, &iv);
+  agg.update(BASE + 24, frame(-5, 0, 0, 0, false), 0.2, &iv);
+
+  const agg_interval_t &cur = agg.current();
+  CHECK_EQUAL(3, cur.frames);
+  CHECK_EQUAL(1, cur.stat[AGG_TEMP].count);
+  DOUBLES_EQUAL(20, aggMean(cur, AGG_TEMP), TOLERANCE);
+  CHECK_EQUAL(2, cur.stat[AGG_RAIN].count);
+  DOUBLES_EQUAL(0.6, cur.stat[AGG_RAIN].sum, TOLERANCE);
+  CHECK(aggValid(cur, AGG_WIND_GUST));
+  CHECK_EQUAL(1, cur.wind.count());
+  DOUBLES_EQUAL(270, cur.wind.direction(), TOLERANCE);
+  CHECK_FALSE(aggValid(cur, AGG_LIGHT));
+  DOUBLES_EQUAL(0, aggMean(cur, AGG_LIGHT), TOLERANCE);
+}
+
+/*
+ * Test closing of intervals without further frames
+ */
+TEST(TG_AggregatorPoll, Test_AggregatorPoll) {
+  IntervalAggregator agg;
+  agg_interval_t iv;
+  agg.reset();
+
+  printf("< AggregatorPoll >\n");
+
+  CHECK_FALSE(agg.poll(BASE + 1000, &iv));
+
+  agg.update(BASE + 10, frame(10, 40, 1, 90), 0, &iv);
+  CHECK_FALSE(agg.poll(BASE + 299, &iv));
+  CHECK(agg.poll(BASE + 300, &iv));
+  CHECK_EQUAL(BASE, iv.start);
+  CHECK_EQUAL(1, iv.frames);
+  CHECK_EQUAL(0, agg.current().start);
+  CHECK_FALSE(agg.poll(BASE + 600, &iv));
+
+  // Next frame starts a new interval without summary
+  CHECK_FALSE(agg.update(BASE + 700, frame(10, 40, 1, 90), 0, &iv));
+  CHECK_EQUAL(BASE + 600, agg.current().start);
+}
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestLinkStats.cpp
+//
+// CppUTest unit tests for LinkStats - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include "LinkStats.h"
+
+#define MS 1000LL
+#define PERIOD 12000    // ms
+
+TEST_GROUP(TG_LinkStatsRssi) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_LinkStatsPeriod) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_LinkStatsLoss) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_LinkStatsDuplicates) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test RSSI mean, variance, min and max
+ */
+TEST(TG_LinkStatsRssi, Test_LinkStatsRssi) {
+  LinkStats link;
+  const float rssi[] = {-80, -82, -84, -86, -88};
+
+  printf("< LinkStatsRssi >\n");
+
+  link.reset();
+  CHECK_EQUAL(0, link.received());
+  DOUBLES_EQUAL(0, link.rssiVariance(), 0);
+
+  link.update(0, rssi[0], 1);
+  DOUBLES_EQUAL(-80, link.rssi(), 1e-6);
+  DOUBLES_EQUAL(0, link.rssiVariance(), 0);
+
+  for (int i = 1; i < 5; i++) {
+    link.update(i * PERIOD * MS, rssi[i], i + 1);
+  }
+  CHECK_EQUAL(5, link.received());
+  DOUBLES_EQUAL(-84, link.rssi(), 1e-4);
+  DOUBLES_EQUAL(10, link.rssiVariance(), 1e-4);
+  DOUBLES_EQUAL(-88, link.rssiMinimum(), 0);
+  DOUBLES_EQUAL(-80, link.rssiMaximum(), 0);
+  CHECK_EQUAL(4 * PERIOD * MS, link.lastSeen());
+}
+
+/*
+ * Test learning of the transmit period with jitter, starting with an interval
+ * which contains a lost frame
+ */
+TEST(TG_LinkStatsPeriod, Test_LinkStatsPeriod) {
+  LinkStats link;
+  int64_t t = 0;
+
+  printf("< LinkStatsPeriod >\n");
+
+  link.reset();
+  link.update(t, -80, 0);
+  CHECK_EQUAL(0, link.period());
+
+  // Second frame lost
+  t += 2 * PERIOD * MS;
+  link.update(t, -80, 1);
+  CHECK_EQUAL(2 * PERIOD, link.period());
+
+  // Shorter interval replaces the estimate
+  t += (PERIOD + 150) * MS;
+  link.update(t, -80, 2);
+  CHECK_EQUAL(PERIOD + 150, link.period());
+
+  // Jitter +/-100 ms around the true period
+  for (int i = 0; i < 100; i++) {
+    t += (PERIOD + ((i & 1) ? 100 : -100)) * MS;
+    link.update(t, -80, 3 + i);
+  }
+  CHECK(link.period() > PERIOD - 50);
+  CHECK(link.period() < PERIOD + 50);
+  CHECK_EQUAL(103, link.received());
+  CHECK_EQUAL(104, link.expected());
+  CHECK_EQUAL(1, link.lost());
+}
+
+/*
+ * Test counting of lost frames
+ */
+TEST(TG_LinkStatsLoss, Test_LinkStatsLoss) {
+  LinkStats link;
+  int64_t t = 0;
+
+  printf("< LinkStatsLoss >\n");
+
+  link.reset();
+  for (int i = 0; i < 10; i++) {
+    link.update(t, -90, i);
+    t += PERIOD * MS;
+  }
+  CHECK_EQUAL(0, link.lost());
+
+  // Gap of 5 periods (4 frames lost), slightly late
+  t += 4 * PERIOD * MS + 300 * MS;
+  link.update(t, -90, 100);
+  CHECK_EQUAL(11, link.received());
+  CHECK_EQUAL(15, link.expected());
+  CHECK_EQUAL(4, link.lost());
+  CHECK(link.period() >= PERIOD);
+  CHECK(link.period() < PERIOD + 100);
+
+  // Digest errors are counted separately
+  link.digestError();
+  link.digestError();
+  CHECK_EQUAL(2, link.digestErrors());
+  CHECK_EQUAL(4, link.lost());
+}
+
+/*
+ * Test duplicate detection
+ */
+TEST(TG_LinkStatsDuplicates, Test_LinkStatsDuplicates) {
+  LinkStats link;
+  const uint8_t a[] = {0x12, 0x34, 0x56};
+  const uint8_t b[] = {0x12, 0x34, 0x57};
+
+  printf("< LinkStatsDuplicates >\n");
+
+  CHECK(LinkStats::hash(a, sizeof(a)) != LinkStats::hash(b, sizeof(b)));
+
+  link.reset();
+  CHECK_FALSE(link.update(0, -70, LinkStats::hash(a, sizeof(a))));
+  // Repeated transmission
+  CHECK(link.update(200 * MS, -75, LinkStats::hash(a, sizeof(a))));
+  CHECK_EQUAL(1, link.duplicates());
+  CHECK_EQUAL(1, link.received());
+  DOUBLES_EQUAL(-70, link.rssi(), 0);
+
+  // Same payload one period later is a new frame (unchanged readings)
+  CHECK_FALSE(link.update(PERIOD * MS, -70, LinkStats::hash(a, sizeof(a))));
+  // Different payload within the window
+  CHECK_FALSE(link.update((PERIOD + 500) * MS, -70, LinkStats::hash(b, sizeof(b))));
+  CHECK_EQUAL(1, link.duplicates());
+  CHECK_EQUAL(3, link.received());
+}
@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestPackedReading.cpp
+//
+// CppUTest unit tests for PackedReading - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include "Decoder.h"
+#include "PackedReading.h"
+
+// Bresser 7-in-1 test message (see test_decoder.c)
+static const uint8_t msg[] = {0xC4, 0xD6, 0x3A, 0xC5, 0xBD, 0xFA, 0x18, 0xAA, 0xAA, 0xAA, 0xAA, 0xAB, 0xFC,
+                              0xAA, 0x98, 0xDA, 0x89, 0xA3, 0x2F, 0xEC, 0xAF, 0x9A, 0xAA, 0xAA, 0xAA, 0x00};
+
+static void checkEqual(const weather_data_t &a, const weather_data_t &b)
+{
+  CHECK_EQUAL(a.sensor_id, b.sensor_id);
+  CHECK(a.temp_c == b.temp_c);
+  CHECK(a.light_klx == b.light_klx);
+  CHECK(a.light_lux == b.light_lux);
+  CHECK(a.uv == b.uv);
+  CHECK(a.rain_mm == b.rain_mm);
+  CHECK(a.wind_direction_deg == b.wind_direction_deg);
+  CHECK(a.wind_gust_meter_sec == b.wind_gust_meter_sec);
+  CHECK(a.wind_avg_meter_sec == b.wind_avg_meter_sec);
+  CHECK_EQUAL(a.humidity, b.humidity);
+  CHECK_EQUAL(a.s_type, b.s_type);
+  CHECK_EQUAL(a.chan, b.chan);
+  CHECK_EQUAL(a.temp_ok, b.temp_ok);
+  CHECK_EQUAL(a.humidity_ok, b.humidity_ok);
+  CHECK_EQUAL(a.light_ok, b.light_ok);
+  CHECK_EQUAL(a.uv_ok, b.uv_ok);
+  CHECK_EQUAL(a.wind_ok, b.wind_ok);
+  CHECK_EQUAL(a.rain_ok, b.rain_ok);
+  CHECK_EQUAL(a.battery_ok, b.battery_ok);
+  CHECK_EQUAL(a.valid, b.valid);
+  CHECK_EQUAL(a.complete, b.complete);
+  CHECK_EQUAL(a.startup, b.startup);
+  CHECK_EQUAL(a.timestamp.tm_year, b.timestamp.tm_year);
+  CHECK_EQUAL(a.timestamp.tm_mon, b.timestamp.tm_mon);
+  CHECK_EQUAL(a.timestamp.tm_mday, b.timestamp.tm_mday);
+  CHECK_EQUAL(a.timestamp.tm_hour, b.timestamp.tm_hour);
+  CHECK_EQUAL(a.timestamp.tm_min, b.timestamp.tm_min);
+  CHECK_EQUAL(a.timestamp.tm_sec, b.timestamp.tm_sec);
+}
+
+TEST_GROUP(TG_PackedReadingSize) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_PackedReadingRoundTrip) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_PackedReadingTime) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test size of packed representation
+ */
+TEST(TG_PackedReadingSize, Test_PackedReadingSize) {
+  printf("< PackedReadingSize >\n");
+
+  CHECK_EQUAL(24U, sizeof(packed_reading_t));
+  CHECK(sizeof(packed_reading_t) * 4 <= sizeof(weather_data_t));
+}
+
+/*
+ * Test lossless conversion of decoded data
+ */
+TEST(TG_PackedReadingRoundTrip, Test_PackedReadingRoundTrip) {
+  weather_data_t ws;
+  weather_data_t res;
+  packed_reading_t p;
+
+  printf("< PackedReadingRoundTrip >\n");
+
+  memset(&ws, 0, sizeof(ws));
+  CHECK_EQUAL(DECODE_OK, decoderPayload(msg, sizeof(msg), &ws));
+  epochToUtc(1662451200LL + 3723, &ws.timestamp);
+
+  packReading(&ws, &p);
+  CHECK_EQUAL(1662451200U + 3723U, p.epoch);
+  CHECK_EQUAL(327, p.temp_dc);
+  CHECK_EQUAL(156U, (unsigned)p.rain_dmm);
+  unpackReading(&p, &res);
+  checkEqual(ws, res);
+
+  // Negative temperature, all flags inverted, maximum values
+  ws.temp_c = (915 - 1000) * 0.1f;
+  ws.rain_mm = 999999 * 0.1f;
+  ws.light_lux = 999999;
+  ws.light_klx = 999999 * 0.001f;
+  ws.uv = 999 * 0.1f;
+  ws.wind_gust_meter_sec = 999 * 0.1f;
+  ws.wind_avg_meter_sec = 999 * 0.1f;
+  ws.wind_direction_deg = 359 * 1.0f;
+  ws.temp_ok = !ws.temp_ok;
+  ws.battery_ok = !ws.battery_ok;
+  ws.startup = !ws.startup;
+  ws.chan = 7;
+  packReading(&ws, &p);
+  CHECK_EQUAL(-85, p.temp_dc);
+  unpackReading(&p, &res);
+  checkEqual(ws, res);
+}
+
+/*
+ * Test UTC conversions
+ */
+TEST(TG_PackedReadingTime, Test_PackedReadingTime) {
+  struct tm t;
+
+  printf("< PackedReadingTime >\n");
+
+  for (int64_t epoch = -86400LL * 800; epoch < 86400LL * 365 * 140; epoch += 86400LL * 13 + 3671) {
+    epochToUtc(epoch, &t);
+    time_t ts = (time_t)epoch;
+    struct tm *ref = gmtime(&ts);
+    CHECK_EQUAL(ref->tm_year, t.tm_year);
+    CHECK_EQUAL(ref->tm_mon, t.tm_mon);
+    CHECK_EQUAL(ref->tm_mday, t.tm_mday);
+    CHECK_EQUAL(ref->tm_hour, t.tm_hour);
+    CHECK_EQUAL(ref->tm_min, t.tm_min);
+    CHECK_EQUAL(ref->tm_sec, t.tm_sec);
+    CHECK_EQUAL(ref->tm_wday, t.tm_wday);
+    CHECK_EQUAL(ref->tm_yday, t.tm_yday);
+    CHECK_EQUAL(epoch, utcToEpoch(&t));
+  }
+}
@@ -0,0 +1,292 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestPersistentBlob.cpp
+//
+// CppUTest unit tests for PersistentBlob - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include "PersistentBlob.h"
+
+/*
+ * Storage in RAM - records for h0, d0, h1, d1; writes can be made to fail
+ */
+class RamStorage : public BlobStorage {
+public:
+  uint8_t  rec[4][64];
+  size_t   len[4];
+  int      writes;
+  int      failAfter;   // number of writes before failure (-1: never)
+
+  RamStorage() {
+    memset(len, 0, sizeof(len));
+    writes = 0;
+    failAfter = -1;
+  }
+
+  int index(const char *key) {
+    return ((key[0] == 'h') ? 0 : 1) + ((key[1] == '1') ? 2 : 0);
+  }
+
+  size_t read(const char *key, void *buf, size_t n) {
+    int i = index(key);
+    if (len[i] == 0 || n < len[i])
+      return 0;
+    memcpy(buf, rec[i], len[i]);
+    return len[i];
+  }
+
+  bool write(const char *key, const void *buf, size_t n) {
+    if (failAfter == 0)
+      return false;
+    if (failAfter > 0)
+      failAfter--;
+    int i = index(key);
+    memcpy(rec[i], buf, n);
+    len[i] = n;
+    writes++;
+    return true;
+  }
+};
+
+typedef struct {
+  uint32_t counter;
+  float    value;
+} test_state_t;
+
+TEST_GROUP(TG_PersistCoalesce) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_PersistSlots) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_PersistTorn) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_PersistInvalid) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test that writes are coalesced by time and change weight
+ */
+TEST(TG_PersistCoalesce, Test_PersistCoalesce) {
+  RamStorage storage;
+  PersistentBlob blob(storage, 1, 900, 10);
+  test_state_t state = {0, 0};
+
+  printf("< PersistCoalesce >\n");
+
+  CHECK_FALSE(blob.load(&state, sizeof(state)));
+  CHECK_FALSE(blob.poll(&state, sizeof(state), 1000));
+
+  // Small changes every 12 s - written after 900 s
+  uint32_t now = 1000;
+  for (int i = 0; i < 75; i++, now += 12) {
+    state.counter++;
+    blob.changed(now, 0);
+    CHECK_FALSE(blob.poll(&state, sizeof(state), now));
+  }
+  CHECK(blob.dirty());
+  state.counter++;
+  blob.changed(now, 0);
+  CHECK(blob.poll(&state, sizeof(state), now));
+  CHECK_FALSE(blob.dirty());
+  CHECK_EQUAL(1, blob.written());
+
+  // Large change - written immediately
+  now += 12;
+  state.value = 1.5;
+  blob.changed(now, 10);
+  CHECK(blob.poll(&state, sizeof(state), now));
+  CHECK_EQUAL(2, blob.written());
+
+  // Weight accumulates
+  for (int i = 0; i < 9; i++) {
+    now += 12;
+    blob.changed(now, 1);
+    CHECK_FALSE(blob.poll(&state, sizeof(state), now));
+  }
+  now += 12;
+  blob.changed(now, 1);
+  CHECK(blob.poll(&state, sizeof(state), now));
+
+  // Flush only if dirty
+  CHECK_FALSE(blob.flush(&state, sizeof(state)));
+  state.counter++;
+  blob.changed(now + 1);
+  CHECK(blob.flush(&state, sizeof(state)));
+  CHECK_EQUAL(4, blob.written());
+
+  test_state_t loaded;
+  PersistentBlob blob2(storage, 1);
+  CHECK(blob2.load(&loaded, sizeof(loaded)));
+  CHECK_EQUAL(state.counter, loaded.counter);
+  DOUBLES_EQUAL(1.5, loaded.value, 0.001);
+}
+
+/*
+ * Test that writes alternate between slots
+ */
+TEST(TG_PersistSlots, Test_PersistSlots) {
+  RamStorage storage;
+  PersistentBlob blob(storage, 1);
+  test_state_t state = {0, 0};
+
+  printf("< PersistSlots >\n");
+
+  for (uint32_t i = 1; i <= 5; i++) {
+    state.counter = i;
+    blob.changed(i);
+    CHECK(blob.flush(&state, sizeof(state)));
+    CHECK_EQUAL(2 * i, (uint32_t)storage.writes);
+  }
+  test_state_t s0, s1;
+  memcpy(&s0, storage.rec[1], sizeof(s0));
+  memcpy(&s1, storage.rec[3], sizeof(s1));
+  CHECK_EQUAL(4, s0.counter);
+  CHECK_EQUAL(5, s1.counter);
+
+  // Sequence continues after load
+  PersistentBlob blob2(storage, 1);
+  test_state_t loaded;
+  CHECK(blob2.load(&loaded, sizeof(loaded)));
+  CHECK_EQUAL(5, loaded.counter);
+  loaded.counter = 6;
+  blob2.changed(10);
+  CHECK(blob2.flush(&loaded, sizeof(loaded)));
+  memcpy(&s0, storage.rec[1], sizeof(s0));
+  CHECK_EQUAL(6, s0.counter);
+}
+
+/*
+ * Test that an interrupted write is never observed
+ */
+TEST(TG_PersistTorn, Test_PersistTorn) {
+  RamStorage storage;
+  PersistentBlob blob(storage, 1);
+  test_state_t state = {1, 0};
+
+  printf("< PersistTorn >\n");
+
+  blob.changed(1);
+  CHECK(blob.flush(&state, sizeof(state)));
+  state.counter = 2;
+  blob.changed(2);
+  CHECK(blob.flush(&state, sizeof(state)));
+
+  // Data written, header not
+  state.counter = 3;
+  blob.changed(3);
+  storage.failAfter = 1;
+  CHECK_FALSE(blob.flush(&state, sizeof(state)));
+  CHECK(blob.dirty());
+
+  test_state_t loaded;
+  PersistentBlob blob2(storage, 1);
+  CHECK(blob2.load(&loaded, sizeof(loaded)));
+  CHECK_EQUAL(2, loaded.counter);
+
+  // Retry succeeds
+  storage.failAfter = -1;
+  CHECK(blob.flush(&state, sizeof(state)));
+  CHECK(blob2.load(&loaded, sizeof(loaded)));
+  CHECK_EQUAL(3, loaded.counter);
+}
+
+/*
+ * Test that corrupted slots and other versions/sizes are rejected
+ */
+TEST(TG_PersistInvalid, Test_PersistInvalid) {
+  RamStorage storage;
+  PersistentBlob blob(storage, 1);
+  test_state_t state = {1, 0};
+
+  printf("< PersistInvalid >\n");
+
+  blob.changed(1);
+  blob.flush(&state, sizeof(state));
+  state.counter = 2;
+  blob.changed(2);
+  blob.flush(&state, sizeof(state));
+
+  // Corrupt data of newest slot - fall back to older slot
+  storage.rec[1][0] ^= 0x01;
+  test_state_t loaded;
+  PersistentBlob blob2(storage, 1);
+  CHECK(blob2.load(&loaded, sizeof(loaded)));
+  CHECK_EQUAL(1, loaded.counter);
+
+  // Both slots corrupted
+  storage.rec[3][1] ^= 0x80;
+  CHECK_FALSE(blob2.load(&loaded, sizeof(loaded)));
+  storage.rec[3][1] ^= 0x80;
+
+  // Other version
+  PersistentBlob blob3(storage, 2);
+  CHECK_FALSE(blob3.load(&loaded, sizeof(loaded)));
+
+  // Other size
+  uint32_t small;
+  CHECK_FALSE(blob2.load(&small, sizeof(small)));
+
+  // CRC-32 check value
+  CHECK_EQUAL(0xCBF43926UL, crc32(0, "123456789", 9));
+}
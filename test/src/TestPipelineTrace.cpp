@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestPipelineTrace.cpp
+//
+// CppUTest unit tests for PipelineTrace - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <time.h>
+#include "PipelineTrace.h"
+
+// Busy wait
+static void spin(uint32_t us)
+{
+  struct timespec t0;
+  struct timespec t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  do {
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+  } while ((t1.tv_sec - t0.tv_sec) * 1000000LL + (t1.tv_nsec - t0.tv_nsec) / 1000 < us);
+}
+
+TEST_GROUP(TG_PipelineTraceHistogram) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_PipelineTraceClock) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test histogram buckets, percentiles and mean
+ */
+TEST(TG_PipelineTraceHistogram, Test_PipelineTraceHistogram) {
+  PipelineTrace trace;
+
+  printf("< PipelineTraceHistogram >\n");
+
+  CHECK_EQUAL(0, trace.percentile(TRACE_DECODE, 50));
+  CHECK_EQUAL(0, trace.mean(TRACE_DECODE));
+
+  trace.record(TRACE_DECODE, 0);
+  trace.record(TRACE_DECODE, 1);
+  trace.record(TRACE_DECODE, 1000);     // bucket 9: 512...1023
+  trace.record(TRACE_DECODE, 1024);     // bucket 10
+  trace.record(TRACE_DECODE, UINT32_MAX);
+  const trace_stats_t &s = trace.stage(TRACE_DECODE);
+  CHECK_EQUAL(5, s.count);
+  CHECK_EQUAL(2, s.buckets[0]);
+  CHECK_EQUAL(1, s.buckets[9]);
+  CHECK_EQUAL(1, s.buckets[10]);
+  CHECK_EQUAL(1, s.buckets[TRACE_BUCKETS - 1]);
+  CHECK_EQUAL(UINT32_MAX, s.max_ns);
+
+  trace.reset();
+  // 90 fast samples (~10 us), 10 slow samples (~1 s)
+  for (int i = 0; i < 90; i++) {
+    trace.record(TRACE_READ, 10000 + i);
+  }
+  for (int i = 0; i < 10; i++) {
+    trace.record(TRACE_READ, 1000000000UL + i);
+  }
+  CHECK_EQUAL(16383, trace.percentile(TRACE_READ, 50));
+  CHECK_EQUAL(16383, trace.percentile(TRACE_READ, 90));
+  CHECK_EQUAL(1000000009UL, trace.percentile(TRACE_READ, 91));
+  CHECK_EQUAL(1000000009UL, trace.percentile(TRACE_READ, 100));
+  CHECK_EQUAL(16383, trace.percentile(TRACE_READ, 0));
+  CHECK_EQUAL(100009040UL, trace.mean(TRACE_READ));
+
+  STRCMP_EQUAL("decode", PipelineTrace::name(TRACE_DECODE));
+  STRCMP_EQUAL("total", PipelineTrace::name(TRACE_TOTAL));
+}
+
+/*
+ * Test stage timing with the cycle counter
+ */
+TEST(TG_PipelineTraceClock, Test_PipelineTraceClock) {
+  PipelineTrace trace;
+
+  printf("< PipelineTraceClock >\n");
+
+  // Not started - ignored
+  trace.mark(TRACE_READ);
+  trace.end();
+  CHECK_EQUAL(0, trace.stage(TRACE_READ).count);
+  CHECK_EQUAL(0, trace.stage(TRACE_TOTAL).count);
+
+  uint32_t isr = trace_cycles();
+  trace.begin(isr);
+  spin(2000);
+  trace.mark(TRACE_READ);
+  spin(500);
+  trace.mark(TRACE_DECODE);
+  trace.end();
+
+  // Loose limits - the test may be preempted
+  uint32_t read = trace.stage(TRACE_READ).max_ns;
+  uint32_t decode = trace.stage(TRACE_DECODE).max_ns;
+  uint32_t total = trace.stage(TRACE_TOTAL).max_ns;
+  printf("read: %u ns, decode: %u ns, total: %u ns\n", read, decode, total);
+  CHECK(read >= 1800000UL);
+  CHECK(read < 50000000UL);
+  CHECK(decode >= 450000UL);
+  CHECK(total >= read + decode);
+  CHECK(total < read + decode + 1000000UL);
+  CHECK_EQUAL(1, trace.stage(TRACE_TOTAL).count);
+
+  // Frame ended - further marks are ignored
+  trace.mark(TRACE_TIME);
+  CHECK_EQUAL(0, trace.stage(TRACE_TIME).count);
+}
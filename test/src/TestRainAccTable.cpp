@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestRainAccTable.cpp
+//
+// CppUTest unit tests for RainAccTable - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include "RainAccTable.h"
+
+/*
+ * Storage in RAM - records for h0, d0, h1, d1
+ */
+class TableStorage : public BlobStorage {
+public:
+  uint8_t  rec[4][sizeof(rain_acc_table_t)];
+  size_t   len[4];
+  int      writes;
+
+  TableStorage() {
+    memset(len, 0, sizeof(len));
+    writes = 0;
+  }
+
+  int index(const char *key) {
+    return ((key[0] == 'h') ? 0 : 1) + ((key[1] == '1') ? 2 : 0);
+  }
+
+  size_t read(const char *key, void *buf, size_t n) {
+    int i = index(key);
+    if (len[i] == 0 || n < len[i])
+      return 0;
+    memcpy(buf, rec[i], len[i]);
+    return len[i];
+  }
+
+  bool write(const char *key, const void *buf, size_t n) {
+    int i = index(key);
+    memcpy(rec[i], buf, n);
+    len[i] = n;
+    writes++;
+    return true;
+  }
+};
+
+TEST_GROUP(TG_RainAccTablePersist) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_RainAccTableReplace) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+
+/*
+ * Test that baselines are written immediately, increments coalesced and the state restored
+ */
+TEST(TG_RainAccTablePersist, Test_RainAccTablePersist) {
+  TableStorage storage;
+  RainAccumulator acc;
+  uint32_t now = 1662451200UL;
+
+  printf("< RainAccTablePersist >\n");
+
+  {
+    RainAccTable table(storage);
+    acc.reset();
+    CHECK_FALSE(table.restore(0x11, acc));
+
+    // New sensor - written immediately
+    acc.update(1000, false);
+    table.update(0x11, acc, now);
+    CHECK_EQUAL(1, table.size());
+    int writes = storage.writes;
+    CHECK(writes > 0);
+
+    // Small increments are coalesced
+    for (int i = 1; i <= 5; i++) {
+      acc.update(1000 + i, false);
+      table.update(0x11, acc, now + i * 60);
+    }
+    CHECK_EQUAL(writes, storage.writes);
+
+    // Sensor reset - written immediately
+    acc.update(3, true);
+    table.update(0x11, acc, now + 360);
+    CHECK(storage.writes > writes);
+    writes = storage.writes;
+
+    acc.update(4, false);
+    table.update(0x11, acc, now + 420);
+    CHECK_EQUAL(writes, storage.writes);
+    table.flush();
+    CHECK(storage.writes > writes);
+  }
+
+  // Restored after restart
+  RainAccTable table(storage);
+  RainAccumulator restored;
+  restored.reset();
+  CHECK(table.restore(0x11, restored));
+  CHECK_EQUAL(acc.total(), restored.total());
+  CHECK_EQUAL(1, restored.getState().resets);
+  CHECK_EQUAL(2, restored.update(6, false));
+
+  // Reset is persisted
+  table.reset();
+  CHECK_EQUAL(0, table.size());
+  RainAccTable cleared(storage);
+  CHECK_FALSE(cleared.restore(0x11, restored));
+}
+
+/*
+ * Test that the table is bounded - the sensor updated least recently is replaced
+ */
+TEST(TG_RainAccTableReplace, Test_RainAccTableReplace) {
+  TableStorage storage;
+  RainAccTable table(storage);
+  RainAccumulator acc;
+  uint32_t now = 1662451200UL;
+
+  printf("< RainAccTableReplace >\n");
+
+  for (uint32_t id = 1; id <= RAIN_ACC_TABLE_SIZE; id++) {
+    acc.reset();
+    acc.update(id * 10, false);
+    table.update(id, acc, now + id);
+  }
+  CHECK_EQUAL(RAIN_ACC_TABLE_SIZE, table.size());
+
+  // Sensor 1 updated again - sensor 2 is the least recently updated one
+  acc.reset();
+  CHECK(table.restore(1, acc));
+  acc.update(20, false);
+  table.update(1, acc, now + 100);
+
+  acc.reset();
+  acc.update(500, false);
+  table.update(0x99, acc, now + 200);
+  CHECK_EQUAL(RAIN_ACC_TABLE_SIZE, table.size());
+  CHECK_FALSE(table.restore(2, acc));
+  CHECK(table.restore(1, acc));
+  CHECK_EQUAL(10, acc.total());
+  CHECK(table.restore(0x99, acc));
+  CHECK_EQUAL(500, acc.getState().prev);
+}
@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestRainAccumulator.cpp
+//
+// CppUTest unit tests for RainAccumulator - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Removed checks of dirty()/saved()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include "RainAccumulator.h"
+
+
+TEST_GROUP(TG_RainAccBasic) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_RainAccWrap) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_RainAccStartup) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_RainAccState) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test accumulation without wrap/reset
+ */
+TEST(TG_RainAccBasic, Test_RainAccBasic) {
+  RainAccumulator acc;
+
+  printf("< RainAccBasic >\n");
+
+  acc.reset();
+  CHECK_FALSE(acc.valid());
+
+  // First reading only sets the baseline - even if the counter is 0
+  CHECK_EQUAL(RAIN_DELTA_INVALID, acc.update(0, false));
+  CHECK(acc.valid());
+  CHECK_EQUAL(0, acc.update(0, false));
+  CHECK_EQUAL(3, acc.update(3, false));
+  CHECK_EQUAL(0, acc.update(3, false));
+  CHECK_EQUAL(156, acc.update(159, false));
+  CHECK_EQUAL(159U, (unsigned)acc.total());
+}
+
+/*
+ * Test counter wrap at the 6-digit limit
+ */
+TEST(TG_RainAccWrap, Test_RainAccWrap) {
+  RainAccumulator acc;
+
+  printf("< RainAccWrap >\n");
+
+  acc.reset();
+  acc.update(999990, false);
+  CHECK_EQUAL(5, acc.update(999995, false));
+  CHECK_EQUAL(12, acc.update(7, false));
+  CHECK_EQUAL(17U, (unsigned)acc.total());
+  CHECK_EQUAL(1, acc.getState().wraps);
+  CHECK_EQUAL(0, acc.getState().resets);
+
+  // Total keeps growing beyond the counter range
+  for (int i = 0; i < 5; i++) {
+    acc.update(500000, false);
+    acc.update(999999, false);
+    acc.update(0, false);
+  }
+  CHECK_EQUAL(17U + 999993U + 4U * 1000000U, (unsigned)acc.total());
+  CHECK_EQUAL(6, acc.getState().wraps);
+}
+
+/*
+ * Test sensor reset (battery change) - counter restarts from zero with startup flag
+ */
+TEST(TG_RainAccStartup, Test_RainAccStartup) {
+  RainAccumulator acc;
+
+  printf("< RainAccStartup >\n");
+
+  acc.reset();
+  acc.update(1500, false);
+  CHECK_EQUAL(20, acc.update(1520, false));
+
+  // Battery change - counter restarted, startup flag set
+  CHECK_EQUAL(0, acc.update(0, true));
+  CHECK_EQUAL(2, acc.update(2, true));
+  CHECK_EQUAL(3, acc.update(5, false));
+  CHECK_EQUAL(25U, (unsigned)acc.total());
+  CHECK_EQUAL(1, acc.getState().resets);
+
+  // Decrease far from the limit without startup flag - not a wrap
+  CHECK_EQUAL(1, acc.update(1, false));
+  CHECK_EQUAL(26U, (unsigned)acc.total());
+  CHECK_EQUAL(2, acc.getState().resets);
+  CHECK_EQUAL(0, acc.getState().wraps);
+}
+
+/*
+ * Test restoring a saved state
+ */
+TEST(TG_RainAccState, Test_RainAccState) {
+  RainAccumulator acc;
+  RainAccumulator acc2;
+
+  printf("< RainAccState >\n");
+
+  acc.reset();
+  acc.update(100, false);
+  acc.update(105, false);
+
+  // Save older state, continue; restored state recovers the increments
+  rain_acc_state_t s = acc.getState();
+  acc.update(120, false);
+
+  acc2.setState(s);
+  CHECK_EQUAL(15, acc2.update(120, false));
+  CHECK_EQUAL(acc.total(), acc2.total());
+}
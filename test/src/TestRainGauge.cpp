@@ -35,6 +35,10 @@
 //
 // 20220830 Created
 // 20240124 Fixed setTime(), fixed test cases / adjusted test cases to new algorithm
+// 20261019 Added test of past() and slot saturation
+// 20261019 Added test of window()
+// 20261019 Added test of updateBatch()
+// 20261019 Added test of reset() with persisted state
 //
 // ToDo: 
 // -
@@ -45,6 +49,8 @@
 
 #define TOLERANCE 0.1
 #include "RainGauge.h"
+#include <stdlib.h>
+#include <string.h>
 
 /**
  * \example
@@ -65,6 +71,38 @@ static void setTime(const char *time, tm &tm, time_t &ts)
   ts = mktime(&tm);
 }
 
+/*
+ * Storage in RAM - records for h0, d0, h1, d1 (survives RainGauge instances)
+ */
+class RainStorage : public BlobStorage {
+public:
+  uint8_t  rec[4][sizeof(nvData_t)];
+  size_t   len[4];
+
+  RainStorage() {
+    memset(len, 0, sizeof(len));
+  }
+
+  int index(const char *key) {
+    return ((key[0] == 'h') ? 0 : 1) + ((key[1] == '1') ? 2 : 0);
+  }
+
+  size_t read(const char *key, void *buf, size_t n) {
+    int i = index(key);
+    if (len[i] == 0 || n < len[i])
+      return 0;
+    memcpy(buf, rec[i], len[i]);
+    return len[i];
+  }
+
+  bool write(const char *key, const void *buf, size_t n) {
+    int i = index(key);
+    memcpy(rec[i], buf, n);
+    len[i] = n;
+    return true;
+  }
+};
+
 TEST_GROUP(TestRainGaugeHour) {
   void setup() {
   }
@@ -177,6 +215,30 @@ TEST_GROUP(TestRainGaugeStartup) {
   }
 };
 
+TEST_GROUP(TestRainGaugePast) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TestRainGaugeBatch) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TestRainGaugeResetPersist) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
 TEST_GROUP(TestRainGaugeInvReq) {
   void setup() {
   }
@@ -1140,6 +1202,161 @@ TEST(TestRainGaugeStartup, TestRainStartup) {
   DOUBLES_EQUAL(5, rainGauge.currentWeek(), TOLERANCE);
 }
 
+/*
+ * Test rainfall during arbitrary past period and saturation of history slots
+ */
+TEST(TestRainGaugePast, TestRainPast) {
+  RainGauge rainGauge(1000);
+  rainGauge.reset();
+
+  tm        tm;
+  time_t    ts;
+  int       qual;
+
+  printf("< RainPast >\n");
+
+  setTime("2022-09-06 8:00", tm, ts);
+  rainGauge.update(ts, 10.0);
+  setTime("2022-09-06 8:06", tm, ts);
+  rainGauge.update(ts, 10.5);
+  setTime("2022-09-06 8:18", tm, ts);
+  rainGauge.update(ts, 11.7);
+  setTime("2022-09-06 8:24", tm, ts);
+  rainGauge.update(ts, 13.1);
+
+  DOUBLES_EQUAL(1.4, rainGauge.past(6, &qual), TOLERANCE);
+  CHECK_EQUAL(1, qual);
+  DOUBLES_EQUAL(2.6, rainGauge.past(12, &qual), TOLERANCE);
+  CHECK_EQUAL(2, qual);
+  DOUBLES_EQUAL(3.1, rainGauge.past(60, &qual), TOLERANCE);
+  CHECK_EQUAL(4, qual);
+  DOUBLES_EQUAL(rainGauge.pastHour(), rainGauge.past(24 * 60), TOLERANCE);
+
+  bool val;
+  DOUBLES_EQUAL(2.6, rainGauge.window(10, &val), TOLERANCE);
+  CHECK(val);
+  DOUBLES_EQUAL(3.1, rainGauge.window(24 * 60, &val), TOLERANCE);
+  CHECK_FALSE(val);
+
+  // Cloudburst - slot saturates
+  setTime("2022-09-06 8:30", tm, ts);
+  rainGauge.update(ts, 613.1);
+  DOUBLES_EQUAL(409.4, rainGauge.past(6), TOLERANCE);
+  DOUBLES_EQUAL(409.4 + 3.1, rainGauge.pastHour(), TOLERANCE);
+  DOUBLES_EQUAL(603.1, rainGauge.currentDay(), TOLERANCE);
+
+  // Rolling windows do not saturate
+  DOUBLES_EQUAL(601.4, rainGauge.window(10), TOLERANCE);
+}
+
+/*
+ * Test that updateBatch() gives the same results as sequential updates
+ * (overflow, sensor startup, gaps, timestamp going backwards)
+ */
+#define BATCH_SAMPLES 25000
+static rain_sample_t batchSamples[BATCH_SAMPLES];
+
+TEST(TestRainGaugeBatch, TestRainBatch) {
+  RainGauge seq(100);
+  RainGauge batch(100);
+  tm        tm;
+  time_t    ts;
+
+  printf("< RainBatch >\n");
+
+  srand(7);
+  setTime("2022-09-06 8:00", tm, ts);
+  float rain = 90.0;
+  for (int i = 0; i < BATCH_SAMPLES; i++) {
+    ts += 12;
+    if (i == 8000)
+      ts += 2 * 3600;
+    bool startup = (i >= 12000) && (i < 12010);
+    if (i == 12000)
+      rain = 0;
+    if (rand() % 8 == 0)
+      rain += 0.1f * (rand() % 5);
+    if (rain >= 100)
+      rain -= 100;
+    batchSamples[i].timestamp = (i == 15000) ? ts - 100 : ts;
+    batchSamples[i].rain = rain;
+    batchSamples[i].startup = startup;
+  }
+
+  // Chunks of different size with queries in between
+  size_t pos = 0;
+  size_t applied = 0;
+  for (size_t chunk = 1; pos < BATCH_SAMPLES; chunk = chunk * 3 + 1) {
+    size_t n = (pos + chunk > BATCH_SAMPLES) ? BATCH_SAMPLES - pos : chunk;
+    for (size_t i = pos; i < pos + n; i++) {
+      seq.update(batchSamples[i].timestamp, batchSamples[i].rain, batchSamples[i].startup);
+    }
+    applied += batch.updateBatch(&batchSamples[pos], n);
+    pos += n;
+
+    bool vs, vb;
+    int  qs, qb;
+    DOUBLES_EQUAL(seq.pastHour(&vs, &qs), batch.pastHour(&vb, &qb), 0.001);
+    CHECK_EQUAL(vs, vb);
+    CHECK_EQUAL(qs, qb);
+    DOUBLES_EQUAL(seq.window(10), batch.window(10), 0.001);
+    DOUBLES_EQUAL(seq.window(24 * 60), batch.window(24 * 60), 0.001);
+    DOUBLES_EQUAL(seq.currentDay(), batch.currentDay(), 0.001);
+    DOUBLES_EQUAL(seq.currentWeek(), batch.currentWeek(), 0.001);
+    DOUBLES_EQUAL(seq.currentMonth(), batch.currentMonth(), 0.001);
+  }
+  CHECK_EQUAL(BATCH_SAMPLES - 1, applied);
+}
+
+/*
+ * Test that reset() is not undone by loading the persisted state
+ */
+TEST(TestRainGaugeResetPersist, Test_RainResetPersist) {
+  RainStorage storage;
+  tm        tm;
+  time_t    ts;
+
+  printf("< RainResetPersist >\n");
+
+  setTime("2022-09-06 8:00", tm, ts);
+  {
+    RainGauge rainGauge(storage);
+    rainGauge.update(ts, 10.0);
+    rainGauge.update(ts + 360, 15.0);
+    rainGauge.flush();
+  }
+
+  // State is restored after restart
+  {
+    RainGauge rainGauge(storage);
+    rainGauge.update(ts + 720, 16.0);
+    DOUBLES_EQUAL(6.0, rainGauge.currentDay(), TOLERANCE);
+  }
+
+  // Reset before the first update after restart - cleared state is not overwritten by the old one
+  {
+    RainGauge rainGauge(storage);
+    rainGauge.reset();
+    rainGauge.update(ts + 1080, 20.0);
+    DOUBLES_EQUAL(0, rainGauge.currentDay(), TOLERANCE);
+    rainGauge.update(ts + 1440, 21.0);
+    DOUBLES_EQUAL(1.0, rainGauge.currentDay(), TOLERANCE);
+  }
+
+  // Reset without a subsequent update persists, too
+  {
+    RainGauge rainGauge(storage);
+    rainGauge.update(ts + 1800, 22.0);
+    DOUBLES_EQUAL(2.0, rainGauge.currentDay(), TOLERANCE);
+    rainGauge.reset();
+  }
+  {
+    RainGauge rainGauge(storage);
+    rainGauge.update(ts + 2160, 23.0);
+    DOUBLES_EQUAL(0, rainGauge.currentDay(), TOLERANCE);
+  }
+}
+
 /*
  * Test that methods indicate an invalid request if
  * called before initial invocation of update()
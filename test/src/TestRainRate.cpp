@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestRainRate.cpp
+//
+// CppUTest unit tests for RainRate - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include "RainRate.h"
+
+#define BASE 1662451200L // 2022-09-06 08:00:00 UTC
+#define FRAME 12
+
+TEST_GROUP(TG_RainRateSteady) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_RainRateLight) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_RainRateHeavy) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_RainRateStop) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test constant rate - one tip per minute (6 mm/h)
+ */
+TEST(TG_RainRateSteady, Test_RainRateSteady) {
+  RainRate rr;
+  rr.reset();
+
+  printf("< RainRateSteady >\n");
+
+  time_t ts = BASE;
+  float rate = 0;
+  for (int i = 0; i < 300; i++, ts += FRAME) {
+    rate = rr.update(ts, (i % 5 == 4) ? 1 : 0);
+  }
+  DOUBLES_EQUAL(6.0, rate, 0.1);
+
+  // No spikes between tips
+  for (int i = 0; i < 10; i++, ts += FRAME) {
+    rate = rr.update(ts, (i % 5 == 4) ? 1 : 0);
+    CHECK(rate < 6.1);
+    CHECK(rate > 5.9);
+  }
+}
+
+/*
+ * Test light rain - one tip in 12 minutes (0.5 mm/h)
+ */
+TEST(TG_RainRateLight, Test_RainRateLight) {
+  RainRate rr;
+  rr.reset();
+
+  printf("< RainRateLight >\n");
+
+  time_t ts = BASE;
+  float rate = 0;
+  for (int i = 0; i < 1200; i++, ts += FRAME) {
+    rate = rr.update(ts, (i % 60 == 59) ? 1 : 0);
+    if (i > 600) {
+      // Quantisation must not cause a spike of one tip per frame (30 mm/h)
+      CHECK(rate < 0.6);
+      CHECK(rate > 0.45);
+    }
+  }
+  DOUBLES_EQUAL(0.5, rate, 0.05);
+}
+
+/*
+ * Test heavy rain after dry period - 5 tips per frame (150 mm/h)
+ */
+TEST(TG_RainRateHeavy, Test_RainRateHeavy) {
+  RainRate rr;
+  rr.reset();
+
+  printf("< RainRateHeavy >\n");
+
+  time_t ts = BASE;
+  for (int i = 0; i < 10; i++, ts += FRAME) {
+    DOUBLES_EQUAL(0, rr.update(ts, 0), 0.001);
+  }
+
+  // Detected within two frames
+  float rate = rr.update(ts, 5);
+  CHECK(rate > 80);
+  ts += FRAME;
+  rate = rr.update(ts, 5);
+  CHECK(rate > 130);
+  for (int i = 0; i < 10; i++) {
+    ts += FRAME;
+    rate = rr.update(ts, 5);
+  }
+  DOUBLES_EQUAL(150.0, rate, 1.0);
+
+  // A single tip after a dry period does not give a rate
+  rr.reset();
+  rr.update(BASE, 0);
+  DOUBLES_EQUAL(0, rr.update(BASE + FRAME, 1), 0.001);
+}
+
+/*
+ * Test decay after the rain has stopped
+ */
+TEST(TG_RainRateStop, Test_RainRateStop) {
+  RainRate rr;
+  rr.reset();
+
+  printf("< RainRateStop >\n");
+
+  time_t ts = BASE;
+  for (int i = 0; i < 100; i++, ts += FRAME) {
+    rr.update(ts, 1);
+  }
+  time_t last = ts - FRAME;
+  DOUBLES_EQUAL(30.0, rr.current(last), 0.5);
+
+  // Limited by one tip over the time since the last tip
+  DOUBLES_EQUAL(6.0, rr.update(last + 60, 0), 0.01);
+  DOUBLES_EQUAL(0.6, rr.update(last + 600, 0), 0.01);
+  DOUBLES_EQUAL(0.1, rr.current(last + 3600), 0.01);
+  DOUBLES_EQUAL(0, rr.update(last + 3601, 0), 0.001);
+
+  // Rain resumes - first tip gives no rate, then the rate rises towards 6 mm/h
+  DOUBLES_EQUAL(0, rr.update(last + 4000, 1), 0.001);
+  float rate = rr.update(last + 4060, 1);
+  CHECK(rate > 1.5);
+  CHECK(rate < 6.0);
+}
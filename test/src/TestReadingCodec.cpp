@@ -0,0 +1,303 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestReadingCodec.cpp
+//
+// CppUTest unit tests for ReadingCodec - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include "ReadingCodec.h"
+
+#define BASE 1662465600UL // 2022-09-06 12:00:00 UTC
+#define SERIES_LEN 1000
+
+// Pseudo random numbers - reproducible
+static uint32_t lcg = 1;
+static int rnd(int n)
+{
+  lcg = lcg * 1103515245U + 12345U;
+  return (int)((lcg >> 16) % n);
+}
+
+// Weather sensor series - 12 s period with occasional jitter, slowly changing values
+static void series(packed_reading_t *r, int len)
+{
+  lcg = 1;
+  memset(r, 0, len * sizeof(packed_reading_t));
+  uint32_t ts = BASE;
+  int temp = 215;
+  int hum = 60;
+  int dir = 200;
+  int avg = 25;
+  int rain = 12345;
+  int light = 20000;
+  for (int i = 0; i < len; i++) {
+    ts += (rnd(10) == 0) ? 11 + rnd(3) : 12;
+    if (rnd(8) == 0)
+      temp += rnd(3) - 1;
+    if (rnd(20) == 0)
+      hum += rnd(3) - 1;
+    dir = (dir + rnd(21) - 10 + 360) % 360;
+    avg = avg + rnd(5) - 2;
+    avg = (avg < 0) ? 0 : avg;
+    if (rnd(30) == 0)
+      rain += 1;
+    light += rnd(41) - 20;
+    r[i].epoch = ts;
+    r[i].sensor_id = 0x39582376;
+    r[i].s_type = 1;
+    r[i].chan = 0;
+    r[i].temp_dc = temp;
+    r[i].humidity = hum;
+    r[i].wind_dir_deg = dir;
+    r[i].wind_avg_dms = avg;
+    r[i].wind_gust_dms = avg + rnd(10);
+    r[i].rain_dmm = rain;
+    r[i].uv_d = 12;
+    r[i].light_lux = light;
+    r[i].flags = PACKED_TEMP_OK | PACKED_HUMIDITY_OK | PACKED_WIND_OK | PACKED_RAIN_OK |
+                 PACKED_LIGHT_OK | PACKED_UV_OK | PACKED_BATTERY_OK | PACKED_VALID |
+                 PACKED_COMPLETE;
+  }
+  r[0].flags |= PACKED_STARTUP;
+}
+
+TEST_GROUP(TG_CodecSeries) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_CodecTimestamp) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_CodecExtremes) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_CodecBounds) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test round trip and compression ratio of a weather sensor series
+ */
+TEST(TG_CodecSeries, Test_CodecSeries) {
+  static packed_reading_t in[SERIES_LEN];
+  static uint8_t block[SERIES_LEN * sizeof(packed_reading_t)];
+  ReadingEncoder enc;
+  ReadingDecoder dec;
+  packed_reading_t out;
+
+  printf("< CodecSeries >\n");
+
+  series(in, SERIES_LEN);
+  enc.begin(block, sizeof(block));
+  for (int i = 0; i < SERIES_LEN; i++) {
+    CHECK(enc.append(in[i]));
+  }
+  CHECK_EQUAL(SERIES_LEN, enc.count());
+
+  size_t bytes = enc.bytes();
+  printf("CodecSeries: %d readings in %u bytes - %.2f bytes/reading, ratio %.1f (packed), %.1f (weather_data_t)\n",
+         SERIES_LEN, (unsigned)bytes, (double)bytes / SERIES_LEN,
+         (double)SERIES_LEN * sizeof(packed_reading_t) / bytes,
+         (double)SERIES_LEN * sizeof(weather_data_t) / bytes);
+  CHECK(bytes * 5 < SERIES_LEN * sizeof(packed_reading_t));
+  CHECK(bytes * 10 < SERIES_LEN * sizeof(weather_data_t));
+
+  dec.begin(block, bytes);
+  CHECK_EQUAL(SERIES_LEN, dec.count());
+  for (int i = 0; i < SERIES_LEN; i++) {
+    CHECK(dec.next(out));
+    MEMCMP_EQUAL(&in[i], &out, sizeof(packed_reading_t));
+  }
+  CHECK_FALSE(dec.next(out));
+}
+
+/*
+ * Test all timestamp delta-of-delta buckets, including gaps and backward steps
+ */
+TEST(TG_CodecTimestamp, Test_CodecTimestamp) {
+  static const int32_t deltas[] = {
+    12, 12, 12, 75, 12, -51, 12, 267, 11, 2060, 12, -2000, 12, 100000, 0, 0, -100000, 12,
+    -3000000
+  };
+  const int len = sizeof(deltas) / sizeof(deltas[0]);
+  packed_reading_t in[len];
+  uint8_t block[256];
+  ReadingEncoder enc;
+  ReadingDecoder dec;
+  packed_reading_t out;
+
+  printf("< CodecTimestamp >\n");
+
+  memset(in, 0, sizeof(in));
+  uint32_t ts = BASE;
+  enc.begin(block, sizeof(block));
+  for (int i = 0; i < len; i++) {
+    ts += deltas[i];
+    in[i].epoch = ts;
+    in[i].sensor_id = 0x11;
+    CHECK(enc.append(in[i]));
+  }
+
+  dec.begin(block, enc.bytes());
+  for (int i = 0; i < len; i++) {
+    CHECK(dec.next(out));
+    CHECK_EQUAL(in[i].epoch, out.epoch);
+  }
+  CHECK_FALSE(dec.next(out));
+}
+
+/*
+ * Test extreme field values and sensor changes
+ */
+TEST(TG_CodecExtremes, Test_CodecExtremes) {
+  packed_reading_t in[4];
+  uint8_t block[256];
+  ReadingEncoder enc;
+  ReadingDecoder dec;
+  packed_reading_t out;
+
+  printf("< CodecExtremes >\n");
+
+  memset(in, 0, sizeof(in));
+  in[0].epoch = 0xFFFFFFF0;
+  in[0].sensor_id = 0xFFFFFFFF;
+  in[0].s_type = 15;
+  in[0].chan = 15;
+  in[0].temp_dc = -32768;
+  in[0].humidity = 255;
+  in[0].wind_dir_deg = 0x3FF;
+  in[0].wind_gust_dms = 0x3FF;
+  in[0].wind_avg_dms = 0x3FF;
+  in[0].rain_dmm = 0xFFFFF;
+  in[0].uv_d = 0x3FF;
+  in[0].light_lux = 0xFFFFF;
+  in[0].flags = 0xFFF;
+  in[1] = in[0];
+  in[1].epoch = 1;
+  in[1].temp_dc = 32767;
+  in[1].rain_dmm = 0;
+  in[1].light_lux = 0;
+  in[2] = in[1];
+  in[2].sensor_id = 0x22;
+  in[2].chan = 3;
+  in[2].flags = 0;
+  in[3] = in[0];
+
+  enc.begin(block, sizeof(block));
+  for (int i = 0; i < 4; i++) {
+    CHECK(enc.append(in[i]));
+  }
+  dec.begin(block, enc.bytes());
+  for (int i = 0; i < 4; i++) {
+    CHECK(dec.next(out));
+    MEMCMP_EQUAL(&in[i], &out, sizeof(packed_reading_t));
+  }
+}
+
+/*
+ * Test full block and truncated block
+ */
+TEST(TG_CodecBounds, Test_CodecBounds) {
+  static packed_reading_t in[SERIES_LEN];
+  uint8_t block[64];
+  ReadingEncoder enc;
+  ReadingDecoder dec;
+  packed_reading_t out;
+
+  printf("< CodecBounds >\n");
+
+  series(in, SERIES_LEN);
+
+  // Too small for header
+  enc.begin(block, 1);
+  CHECK_FALSE(enc.append(in[0]));
+  CHECK_EQUAL(0, enc.bytes());
+
+  // Fill block until the next reading is rejected
+  enc.begin(block, sizeof(block));
+  int n = 0;
+  while (enc.append(in[n])) {
+    n++;
+  }
+  CHECK(n > 5);
+  CHECK_EQUAL(n, enc.count());
+  CHECK(enc.bytes() <= sizeof(block));
+
+  // Rejected reading left no trace
+  dec.begin(block, enc.bytes());
+  for (int i = 0; i < n; i++) {
+    CHECK(dec.next(out));
+    MEMCMP_EQUAL(&in[i], &out, sizeof(packed_reading_t));
+  }
+  CHECK_FALSE(dec.next(out));
+
+  // Truncated block
+  dec.begin(block, enc.bytes() / 2);
+  int m = 0;
+  while (dec.next(out)) {
+    m++;
+  }
+  CHECK(m < n);
+
+  // Empty block
+  dec.begin(block, 1);
+  CHECK_EQUAL(0, dec.count());
+  CHECK_FALSE(dec.next(out));
+}
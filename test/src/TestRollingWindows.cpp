@@ -0,0 +1,236 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestRollingWindows.cpp
+//
+// CppUTest unit tests for RollingWindows - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <stdlib.h>
+#include "RollingWindows.h"
+
+#define BASE 1662422400L // 2022-09-06 00:00:00 UTC
+
+/*
+ * Brute force reference
+ */
+#define REF_SIZE 20000
+static time_t   refTs[REF_SIZE];
+static uint16_t refDelta[REF_SIZE];
+static int      refCount;
+
+static uint32_t refSum(time_t from, time_t to)
+{
+  uint32_t sum = 0;
+  for (int i = 0; i < refCount; i++) {
+    if ((refTs[i] >= from) && (refTs[i] <= to))
+      sum += refDelta[i];
+  }
+  return sum;
+}
+
+TEST_GROUP(TG_RollingBasic) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_RollingValid) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_RollingGap) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_RollingRandom) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test constant rate of one event per minute over eight days
+ */
+TEST(TG_RollingBasic, Test_RollingBasic) {
+  RollingWindows windows;
+  bool valid;
+
+  printf("< RollingBasic >\n");
+
+  CHECK_EQUAL(0, windows.sum(600, &valid));
+  CHECK_FALSE(valid);
+
+  // Updates in the middle of each minute
+  time_t ts = BASE + 30;
+  for (int i = 0; i < 8 * 1440; i++, ts += 60) {
+    windows.update(ts, 1);
+  }
+  ts -= 60;
+  CHECK_EQUAL(ts, windows.updated());
+
+  CHECK_EQUAL(10, windows.sum(600, &valid));
+  CHECK(valid);
+  CHECK_EQUAL(60, windows.sum(3600, &valid));
+  CHECK(valid);
+  CHECK_EQUAL(180, windows.sum(3 * 3600, &valid));
+  CHECK(valid);
+  CHECK_EQUAL(1440, windows.sum(86400, &valid));
+  CHECK(valid);
+  CHECK_EQUAL(7 * 1440, windows.sum(7 * 86400, &valid));
+  CHECK(valid);
+
+  // Longer than supported
+  windows.sum(ROLLING_MAX_WINDOW + 1, &valid);
+  CHECK_FALSE(valid);
+
+  windows.reset();
+  CHECK_EQUAL(0, windows.updated());
+  CHECK_EQUAL(0, windows.sum(600, &valid));
+  CHECK_FALSE(valid);
+}
+
+/*
+ * Test windows exceeding the time covered by updates
+ */
+TEST(TG_RollingValid, Test_RollingValid) {
+  RollingWindows windows;
+  bool valid;
+
+  printf("< RollingValid >\n");
+
+  time_t ts = BASE + 30;
+  for (int i = 0; i < 120; i++, ts += 60) {
+    windows.update(ts, 2);
+  }
+  CHECK_EQUAL(40, windows.sum(1200, &valid));
+  CHECK(valid);
+
+  // Sum since first update
+  CHECK_EQUAL(240, windows.sum(86400, &valid));
+  CHECK_FALSE(valid);
+  CHECK_EQUAL(240, windows.sum(7 * 86400, &valid));
+  CHECK_FALSE(valid);
+}
+
+/*
+ * Test gaps between updates
+ */
+TEST(TG_RollingGap, Test_RollingGap) {
+  RollingWindows windows;
+  bool valid;
+
+  printf("< RollingGap >\n");
+
+  windows.update(BASE + 30, 0);
+  windows.update(BASE + 90, 5);
+
+  // Two hours without update
+  windows.update(BASE + 7230, 7);
+  CHECK_EQUAL(7, windows.sum(600, &valid));
+  CHECK(valid);
+  CHECK_EQUAL(7, windows.sum(3600, &valid));
+  CHECK_EQUAL(12, windows.sum(3 * 3600, &valid));
+  CHECK_FALSE(valid);
+
+  // Gap longer than all levels
+  windows.update(BASE + 10 * 86400L, 3);
+  CHECK_EQUAL(3, windows.sum(600, &valid));
+  CHECK(valid);
+  CHECK_EQUAL(3, windows.sum(86400, &valid));
+  CHECK(valid);
+  CHECK_EQUAL(3, windows.sum(7 * 86400, &valid));
+  CHECK(valid);
+
+  // Timestamp older than last update - added to current bucket
+  windows.update(BASE + 10 * 86400L - 60, 1);
+  CHECK_EQUAL(4, windows.sum(600));
+}
+
+/*
+ * Test random deltas and intervals against brute force reference
+ *
+ * The window start is rounded to the nearest bucket boundary, so the deviation is limited
+ * by the rain in half a bucket at either end.
+ */
+TEST(TG_RollingRandom, Test_RollingRandom) {
+  RollingWindows windows;
+  const uint32_t lengths[] = {600, 3600, 3 * 3600, 86400, 3 * 86400, 7 * 86400};
+  const uint32_t bucket[]  = {60, 60, 900, 900, 10800, 10800};
+
+  printf("< RollingRandom >\n");
+
+  srand(42);
+  refCount = 0;
+  time_t ts = BASE;
+  while (refCount < REF_SIZE) {
+    ts += 1 + rand() % 120;
+    uint16_t delta = (rand() % 4 == 0) ? rand() % 20 : 0;
+    refTs[refCount] = ts;
+    refDelta[refCount] = delta;
+    refCount++;
+    windows.update(ts, delta);
+
+    if (refCount % 997 == 0) {
+      for (int w = 0; w < 6; w++) {
+        bool valid;
+        uint32_t sum = windows.sum(lengths[w], &valid);
+        if (!valid)
+          continue;
+        uint32_t lower = refSum(ts - lengths[w] + bucket[w] / 2 + 1, ts);
+        uint32_t upper = refSum(ts - lengths[w] - bucket[w] / 2, ts);
+        CHECK(sum >= lower);
+        CHECK(sum <= upper);
+      }
+    }
+  }
+}
@@ -0,0 +1,367 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestSegmentLog.cpp
+//
+// CppUTest unit tests for SegmentLog - artificial test cases (files in a temporary directory)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Added test of failed journal writes
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "SegmentLog.h"
+
+#define BASE 1662465600UL // 2022-09-06 12:00:00 UTC
+#define PERIOD 12
+
+static char logDir[32];
+
+// Reading of sensor 'id' at time 'ts'
+static packed_reading_t reading(uint32_t id, uint32_t ts)
+{
+  packed_reading_t p;
+  memset(&p, 0, sizeof(p));
+  p.epoch = ts;
+  p.sensor_id = id;
+  p.temp_dc = 200 + (ts / 600) % 50;
+  p.humidity = 60;
+  p.wind_dir_deg = (ts / 60) % 360;
+  p.wind_avg_dms = (ts / 36) % 40;
+  p.rain_dmm = 1000 + ts / 3600;
+  p.flags = PACKED_TEMP_OK | PACKED_HUMIDITY_OK | PACKED_WIND_OK | PACKED_RAIN_OK;
+  return p;
+}
+
+static void removeDir(const char *dir)
+{
+  char name[SEGMENT_PATH_SIZE + 16];
+  DIR *d = opendir(dir);
+  struct dirent *e;
+
+  while (d && ((e = readdir(d)) != nullptr)) {
+    if (e->d_name[0] == '.')
+      continue;
+    snprintf(name, sizeof(name), "%s/%s", dir, e->d_name);
+    remove(name);
+  }
+  if (d)
+    closedir(d);
+  rmdir(dir);
+}
+
+static int countFiles(const char *dir, const char *ext)
+{
+  DIR *d = opendir(dir);
+  struct dirent *e;
+  int n = 0;
+
+  while (d && ((e = readdir(d)) != nullptr)) {
+    const char *dot = strrchr(e->d_name, '.');
+    if (dot && (strcmp(dot + 1, ext) == 0))
+      n++;
+  }
+  if (d)
+    closedir(d);
+  return n;
+}
+
+TEST_GROUP(TG_SegmentLogQuery) {
+  void setup() {
+    strcpy(logDir, "/tmp/bwslogXXXXXX");
+    CHECK(mkdtemp(logDir) != nullptr);
+  }
+
+  void teardown() {
+    removeDir(logDir);
+  }
+};
+
+TEST_GROUP(TG_SegmentLogRecover) {
+  void setup() {
+    strcpy(logDir, "/tmp/bwslogXXXXXX");
+    CHECK(mkdtemp(logDir) != nullptr);
+  }
+
+  void teardown() {
+    removeDir(logDir);
+  }
+};
+
+TEST_GROUP(TG_SegmentLogRetention) {
+  void setup() {
+    strcpy(logDir, "/tmp/bwslogXXXXXX");
+    CHECK(mkdtemp(logDir) != nullptr);
+  }
+
+  void teardown() {
+    removeDir(logDir);
+  }
+};
+
+TEST_GROUP(TG_SegmentLogCorrupt) {
+  void setup() {
+    strcpy(logDir, "/tmp/bwslogXXXXXX");
+    CHECK(mkdtemp(logDir) != nullptr);
+  }
+
+  void teardown() {
+    removeDir(logDir);
+  }
+};
+
+TEST_GROUP(TG_SegmentLogJournal) {
+  void setup() {
+    strcpy(logDir, "/tmp/bwslogXXXXXX");
+    CHECK(mkdtemp(logDir) != nullptr);
+  }
+
+  void teardown() {
+    removeDir(logDir);
+  }
+};
+
+/*
+ * Test range queries over sealed and active segments
+ */
+TEST(TG_SegmentLogQuery, Test_SegmentLogQuery) {
+  const int len = 3000;
+  static packed_reading_t out[len];
+  SegmentLog *log = new SegmentLog(logDir);
+
+  printf("< SegmentLogQuery >\n");
+
+  CHECK_FALSE(log->append(reading(0x11, BASE)));
+  CHECK(log->begin());
+  for (int i = 0; i < len; i++) {
+    CHECK(log->append(reading((i % 3) ? 0x11 : 0x22, BASE + i * PERIOD)));
+  }
+  CHECK(log->segments() > 2);
+  CHECK(log->pending() > 0);
+  CHECK_EQUAL(log->segments(), countFiles(logDir, "seg"));
+  CHECK_EQUAL(1, countFiles(logDir, "jnl"));
+  printf("SegmentLogQuery: %d readings in %u segments + %u pending\n",
+         len, log->segments(), log->pending());
+
+  // All readings
+  CHECK_EQUAL(len, log->query(0, 0, UINT32_MAX, out, len));
+  for (int i = 0; i < len; i++) {
+    packed_reading_t p = reading((i % 3) ? 0x11 : 0x22, BASE + i * PERIOD);
+    MEMCMP_EQUAL(&p, &out[i], sizeof(p));
+  }
+
+  // One sensor
+  CHECK_EQUAL(len / 3, log->query(0x22, 0, UINT32_MAX, out, len));
+  CHECK_EQUAL(0x22, out[len / 3 - 1].sensor_id);
+
+  // Short range - only one segment read
+  uint32_t reads = log->segmentsRead();
+  CHECK_EQUAL(10, log->query(0, BASE + 100 * PERIOD, BASE + 109 * PERIOD, out, len));
+  CHECK_EQUAL(BASE + 100 * PERIOD, out[0].epoch);
+  CHECK_EQUAL(reads + 1, log->segmentsRead());
+
+  // Range in active segment only
+  reads = log->segmentsRead();
+  CHECK_EQUAL(1, log->query(0, BASE + (len - 1) * PERIOD, UINT32_MAX, out, len));
+  CHECK_EQUAL(reads, log->segmentsRead());
+
+  // Destination buffer limit
+  CHECK_EQUAL(5, log->query(0, 0, UINT32_MAX, out, 5));
+  CHECK_EQUAL(0, log->corrupt());
+
+  delete log;
+}
+
+/*
+ * Test rebuilding of index and active segment after restart
+ */
+TEST(TG_SegmentLogRecover, Test_SegmentLogRecover) {
+  const int len = 1500;
+  static packed_reading_t out[len + 1];
+  SegmentLog *log = new SegmentLog(logDir);
+
+  printf("< SegmentLogRecover >\n");
+
+  CHECK(log->begin());
+  for (int i = 0; i < len; i++) {
+    log->append(reading(0x11, BASE + i * PERIOD));
+  }
+  uint16_t segs = log->segments();
+  uint16_t pending = log->pending();
+  delete log;
+
+  // Stale temporary file from an interrupted seal
+  char name[SEGMENT_PATH_SIZE];
+  snprintf(name, sizeof(name), "%s/%08X.tmp", logDir, 0x7777);
+  FILE *f = fopen(name, "wb");
+  fclose(f);
+
+  log = new SegmentLog(logDir);
+  CHECK(log->begin());
+  CHECK_EQUAL(segs, log->segments());
+  CHECK_EQUAL(pending, log->pending());
+  CHECK_EQUAL(0, countFiles(logDir, "tmp"));
+
+  CHECK(log->append(reading(0x11, BASE + len * PERIOD)));
+  CHECK_EQUAL(len + 1, log->query(0, 0, UINT32_MAX, out, len + 1));
+  for (int i = 0; i <= len; i++) {
+    CHECK_EQUAL(BASE + i * PERIOD, out[i].epoch);
+  }
+  delete log;
+}
+
+/*
+ * Test retention - by time and by number of segments
+ */
+TEST(TG_SegmentLogRetention, Test_SegmentLogRetention) {
+  static packed_reading_t out[1];
+  SegmentLog *log = new SegmentLog(logDir);
+
+  printf("< SegmentLogRetention >\n");
+
+  CHECK(log->begin());
+  int i = 0;
+  while (log->segments() < 10) {
+    log->append(reading(0x11, BASE + i++ * PERIOD));
+  }
+  int perSegment = i / 10;
+
+  // Delete segments older than half of the readings
+  uint32_t half = BASE + (i / 2) * PERIOD;
+  size_t deleted = log->retain(half);
+  CHECK(deleted >= 4);
+  CHECK(deleted <= 5);
+  CHECK_EQUAL(10 - deleted, log->segments());
+  CHECK_EQUAL(10 - deleted, countFiles(logDir, "seg"));
+  CHECK_EQUAL(1, log->query(0, 0, UINT32_MAX, out, 1));
+  CHECK(out[0].epoch <= half);
+  CHECK(out[0].epoch + perSegment * PERIOD > half);
+
+  // Fill up - oldest segments are deleted
+  while (i < (SEGMENT_LOG_MAX_SEGMENTS + 5) * perSegment) {
+    log->append(reading(0x11, BASE + i++ * PERIOD));
+  }
+  CHECK_EQUAL(SEGMENT_LOG_MAX_SEGMENTS, log->segments());
+  CHECK_EQUAL(SEGMENT_LOG_MAX_SEGMENTS, countFiles(logDir, "seg"));
+  delete log;
+
+  // Index rebuilt from directory
+  log = new SegmentLog(logDir);
+  CHECK(log->begin());
+  CHECK_EQUAL(SEGMENT_LOG_MAX_SEGMENTS, log->segments());
+  delete log;
+}
+
+/*
+ * Test detection of corrupt segments
+ */
+TEST(TG_SegmentLogCorrupt, Test_SegmentLogCorrupt) {
+  const int len = 4000;
+  static packed_reading_t out[len];
+  SegmentLog *log = new SegmentLog(logDir);
+
+  printf("< SegmentLogCorrupt >\n");
+
+  CHECK(log->begin());
+  for (int i = 0; i < len; i++) {
+    log->append(reading(0x11, BASE + i * PERIOD));
+  }
+  CHECK(log->segments() >= 2);
+
+  // Flip a data byte of the first segment
+  char name[SEGMENT_PATH_SIZE];
+  snprintf(name, sizeof(name), "%s/%08X.seg", logDir, 0);
+  FILE *f = fopen(name, "r+b");
+  CHECK(f != nullptr);
+  fseek(f, sizeof(segment_header_t) + 100, SEEK_SET);
+  int c = fgetc(f);
+  fseek(f, sizeof(segment_header_t) + 100, SEEK_SET);
+  fputc(c ^ 0x10, f);
+  fclose(f);
+
+  size_t n = log->query(0, 0, UINT32_MAX, out, len);
+  CHECK_EQUAL(1, log->corrupt());
+  CHECK(n < len);
+  CHECK(out[0].epoch > BASE);
+
+  // Corrupt header - segment deleted when opening the log
+  f = fopen(name, "r+b");
+  fputc(0, f);
+  fclose(f);
+  delete log;
+  log = new SegmentLog(logDir);
+  uint16_t segs = 0;
+  CHECK(log->begin());
+  segs = log->segments();
+  CHECK_EQUAL(1, log->corrupt());
+  CHECK_EQUAL(segs, countFiles(logDir, "seg"));
+  delete log;
+}
+
+/*
+ * Test that readings are kept if the journal cannot be written and the journal is rebuilt
+ */
+TEST(TG_SegmentLogJournal, Test_SegmentLogJournal) {
+  SegmentLog *log = new SegmentLog(logDir);
+
+  printf("< SegmentLogJournal >\n");
+
+  // Journal not accessible - readings are stored in the active segment
+  CHECK(log->begin());
+  removeDir(logDir);
+  CHECK(log->append(reading(0x11, BASE)));
+  CHECK(log->append(reading(0x11, BASE + PERIOD)));
+  CHECK_EQUAL(2, log->journalErrors());
+  CHECK_EQUAL(2, log->pending());
+
+  // Journal rebuilt with all readings of the active segment
+  CHECK_EQUAL(0, mkdir(logDir, 0700));
+  CHECK(log->append(reading(0x11, BASE + 2 * PERIOD)));
+  CHECK(log->append(reading(0x11, BASE + 3 * PERIOD)));
+  CHECK_EQUAL(2, log->journalErrors());
+  delete log;
+
+  log = new SegmentLog(logDir);
+  CHECK(log->begin());
+  CHECK_EQUAL(4, log->pending());
+  delete log;
+}
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestSensorTable.cpp
+//
+// CppUTest unit tests for SensorTable - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+// 20261019 Added check of non-const at()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include "SensorTable.h"
+
+
+TEST_GROUP(TG_SensorTableBasic) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_SensorTableEviction) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_SensorTableRemove) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test insertion and lookup
+ */
+TEST(TG_SensorTableBasic, Test_SensorTableBasic) {
+  static SensorTable table;
+  bool created;
+
+  printf("< SensorTableBasic >\n");
+
+  table.clear();
+  POINTERS_EQUAL(nullptr, table.find(0x906F));
+  CHECK_EQUAL(0, table.size());
+
+  sensor_state_t *s1 = table.lookup(0x906F, &created);
+  CHECK(created);
+  CHECK_EQUAL(0x906FU, s1->sensor_id);
+  CHECK_EQUAL(0U, s1->frames);
+  s1->published = 42;
+
+  sensor_state_t *s2 = table.lookup(0x1234, &created);
+  CHECK(created);
+  CHECK(s1 != s2);
+  CHECK_EQUAL(2, table.size());
+
+  sensor_state_t *s = table.lookup(0x906F, &created);
+  CHECK_FALSE(created);
+  POINTERS_EQUAL(s1, s);
+  CHECK_EQUAL(42U, s->published);
+  POINTERS_EQUAL(s2, table.find(0x1234));
+}
+
+/*
+ * Test that the least recently used entry is evicted when the table is full
+ */
+TEST(TG_SensorTableEviction, Test_SensorTableEviction) {
+  static SensorTable table;
+
+  printf("< SensorTableEviction >\n");
+
+  table.clear();
+  for (uint32_t id = 1; id <= SENSOR_TABLE_SIZE; id++) {
+    table.lookup(id * 0x100);
+  }
+  CHECK_EQUAL(SENSOR_TABLE_SIZE, table.size());
+
+  // Use sensor 1 - sensor 2 becomes least recently used
+  CHECK(table.find(0x100) != nullptr);
+
+  table.lookup(0xABCD);
+  CHECK_EQUAL(SENSOR_TABLE_SIZE, table.size());
+  CHECK_EQUAL(1U, table.evicted());
+  POINTERS_EQUAL(nullptr, table.find(0x200));
+  CHECK(table.find(0x100) != nullptr);
+  CHECK(table.find(0xABCD) != nullptr);
+  CHECK_EQUAL(0xABCDU, table.at(0)->sensor_id);
+  CHECK_EQUAL(0x100U, table.at(1)->sensor_id);
+  CHECK_EQUAL(0x300U, table.at(SENSOR_TABLE_SIZE - 1)->sensor_id);
+  POINTERS_EQUAL(nullptr, table.at(SENSOR_TABLE_SIZE));
+  POINTERS_EQUAL(static_cast<const SensorTable &>(table).at(1), table.at(1));
+
+  // All remaining sensors are still reachable
+  for (uint32_t id = 3; id <= SENSOR_TABLE_SIZE; id++) {
+    CHECK(table.find(id * 0x100) != nullptr);
+  }
+}
+
+/*
+ * Test removal with many colliding entries (backward shift deletion)
+ */
+TEST(TG_SensorTableRemove, Test_SensorTableRemove) {
+  static SensorTable table;
+
+  printf("< SensorTableRemove >\n");
+
+  table.clear();
+  for (uint32_t round = 0; round < 50; round++) {
+    for (uint32_t i = 0; i < SENSOR_TABLE_SIZE; i++) {
+      sensor_state_t *s = table.lookup(round * 7919 + i * 131);
+      s->frames = round * 1000 + i;
+    }
+    for (uint32_t i = 0; i < SENSOR_TABLE_SIZE; i += 2) {
+      CHECK(table.remove(round * 7919 + i * 131));
+    }
+    CHECK_FALSE(table.remove(round * 7919));
+    CHECK_EQUAL(SENSOR_TABLE_SIZE / 2, table.size());
+    for (uint32_t i = 1; i < SENSOR_TABLE_SIZE; i += 2) {
+      sensor_state_t *s = table.find(round * 7919 + i * 131);
+      CHECK(s != nullptr);
+      CHECK_EQUAL(round * 1000 + i, s->frames);
+    }
+    for (uint32_t i = 1; i < SENSOR_TABLE_SIZE; i += 2) {
+      CHECK(table.remove(round * 7919 + i * 131));
+    }
+    CHECK_EQUAL(0, table.size());
+  }
+}
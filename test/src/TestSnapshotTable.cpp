@@ -0,0 +1,234 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestSnapshotTable.cpp
+//
+// CppUTest unit tests for SnapshotTable - artificial test cases and reader stress test
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <string.h>
+#include <thread>
+#include <atomic>
+#include "SnapshotTable.h"
+
+#define STRESS_SENSORS 4
+#define STRESS_READERS 8
+#define STRESS_WRITES  200000
+
+// Reading of sensor 'id' with all fields derived from 'k'
+static weather_data_t reading(uint32_t id, uint32_t k)
+{
+  weather_data_t ws;
+  memset(&ws, 0, sizeof(ws));
+  ws.sensor_id = id;
+  ws.timestamp.tm_sec = k % 60;
+  ws.timestamp.tm_year = 122 + k % 7;
+  ws.temp_c = (float)k;
+  ws.light_lux = (float)(k + 1);
+  ws.rain_mm = k * 0.5f;
+  ws.wind_avg_meter_sec = (float)(k % 1000);
+  ws.humidity = k & 0xFF;
+  ws.temp_ok = true;
+  ws.startup = (k & 1);
+  return ws;
+}
+
+// Check that all fields belong to the same write
+static bool consistent(const weather_data_t &ws, uint32_t id)
+{
+  uint32_t k = (uint32_t)ws.temp_c;
+  weather_data_t ref = reading(id, k);
+  return memcmp(&ws, &ref, sizeof(ws)) == 0;
+}
+
+TEST_GROUP(TG_SnapshotTableBasic) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_SnapshotTableReuse) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_SnapshotTableStress) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test write and read of a few sensors
+ */
+TEST(TG_SnapshotTableBasic, Test_SnapshotTableBasic) {
+  SnapshotTable table;
+  weather_data_t ws;
+  uint32_t version;
+  uint32_t ids[4];
+
+  printf("< SnapshotTableBasic >\n");
+
+  CHECK_FALSE(table.read(0x1234, &ws));
+  CHECK_EQUAL(0, table.sensors(ids, 4));
+
+  table.write(reading(0x1234, 10));
+  table.write(reading(0x5678, 20));
+  table.write(reading(0x1234, 11));
+
+  CHECK(table.read(0x1234, &ws, &version));
+  CHECK(consistent(ws, 0x1234));
+  DOUBLES_EQUAL(11, ws.temp_c, 0);
+  CHECK_EQUAL(2, version);
+
+  CHECK(table.read(0x5678, &ws, &version));
+  DOUBLES_EQUAL(20, ws.temp_c, 0);
+  CHECK_EQUAL(1, version);
+
+  CHECK_FALSE(table.read(0x9999, &ws));
+  CHECK_EQUAL(2, table.sensors(ids, 4));
+  CHECK_EQUAL(0x1234, ids[0]);
+  CHECK_EQUAL(0x5678, ids[1]);
+  CHECK_EQUAL(1, table.sensors(ids, 1));
+  CHECK_EQUAL(0, table.retries());
+
+  table.clear();
+  CHECK_FALSE(table.read(0x1234, &ws));
+}
+
+/*
+ * Test reuse of the least recently updated slot when the table is full
+ */
+TEST(TG_SnapshotTableReuse, Test_SnapshotTableReuse) {
+  SnapshotTable table;
+  weather_data_t ws;
+  uint32_t ids[SNAPSHOT_TABLE_SIZE];
+
+  printf("< SnapshotTableReuse >\n");
+
+  for (uint32_t id = 1; id <= SNAPSHOT_TABLE_SIZE; id++) {
+    table.write(reading(id, id));
+  }
+  // Sensor 1 is updated again, sensor 2 is now the least recently updated one
+  table.write(reading(1, 100));
+  table.write(reading(1000, 1000));
+
+  CHECK_FALSE(table.read(2, &ws));
+  CHECK(table.read(1, &ws));
+  DOUBLES_EQUAL(100, ws.temp_c, 0);
+  CHECK(table.read(1000, &ws));
+  DOUBLES_EQUAL(1000, ws.temp_c, 0);
+  CHECK(table.read(3, &ws));
+  CHECK_EQUAL(SNAPSHOT_TABLE_SIZE, table.sensors(ids, SNAPSHOT_TABLE_SIZE));
+}
+
+/*
+ * Test many readers concurrently with the writer:
+ * every successful read must return a complete reading of the requested sensor,
+ * and each reader must never see a sensor's reading go backwards
+ */
+TEST(TG_SnapshotTableStress, Test_SnapshotTableStress) {
+  static SnapshotTable table;
+  std::atomic<bool> done(false);
+  std::atomic<uint32_t> reads(0);
+  std::atomic<uint32_t> errors(0);
+  std::thread readers[STRESS_READERS];
+
+  printf("< SnapshotTableStress >\n");
+
+  table.clear();
+  for (uint32_t id = 1; id <= STRESS_SENSORS; id++) {
+    table.write(reading(id, 0));
+  }
+
+  for (int r = 0; r < STRESS_READERS; r++) {
+    readers[r] = std::thread([&]() {
+      uint32_t last[STRESS_SENSORS + 1] = {0};
+      uint32_t lastVersion[STRESS_SENSORS + 1] = {0};
+      uint32_t n = 0;
+      uint32_t e = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        for (uint32_t id = 1; id <= STRESS_SENSORS; id++) {
+          weather_data_t ws;
+          uint32_t version;
+          if (!table.read(id, &ws, &version)) {
+            continue;
+          }
+          n++;
+          uint32_t k = (uint32_t)ws.temp_c;
+          if (!consistent(ws, id) || (k < last[id]) || (version < lastVersion[id])) {
+            e++;
+          }
+          last[id] = k;
+          lastVersion[id] = version;
+        }
+      }
+      reads += n;
+      errors += e;
+    });
+  }
+
+  for (uint32_t k = 1; k <= STRESS_WRITES; k++) {
+    table.write(reading(1 + k % STRESS_SENSORS, k));
+  }
+  done = true;
+  for (int r = 0; r < STRESS_READERS; r++) {
+    readers[r].join();
+  }
+
+  printf("%u reads, %u retries\n", reads.load(), table.retries());
+  CHECK(reads > 0);
+  CHECK_EQUAL(0, errors.load());
+
+  // Final state
+  for (uint32_t id = 1; id <= STRESS_SENSORS; id++) {
+    weather_data_t ws;
+    CHECK(table.read(id, &ws));
+    CHECK(consistent(ws, id));
+    CHECK(ws.temp_c > STRESS_WRITES - STRESS_SENSORS);
+  }
+}
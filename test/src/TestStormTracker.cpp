@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestStormTracker.cpp
+//
+// CppUTest unit tests for StormTracker - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include "StormTracker.h"
+
+#define TOLERANCE 0.1
+#define BASE 1662465600L // 2022-09-06 12:00:00 UTC
+
+TEST_GROUP(TG_StormWindow) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_StormApproach) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_StormRecede) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_StormEnd) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test strike rate and distance statistics within the sliding window
+ */
+TEST(TG_StormWindow, Test_StormWindow) {
+  StormTracker storm;
+
+  printf("< StormWindow >\n");
+
+  CHECK_FALSE(storm.isActive());
+  CHECK_EQUAL(0, storm.events(BASE));
+  CHECK_EQUAL(STORM_DISTANCE_INVALID, storm.closest(BASE));
+  DOUBLES_EQUAL(-1, storm.meanDistance(BASE), TOLERANCE);
+
+  CHECK_EQUAL(STORM_START, storm.update(BASE, 4, 20));
+  CHECK(storm.isActive());
+  CHECK_EQUAL(0, storm.update(BASE + 60, 0, 20));
+  CHECK_EQUAL(0, storm.update(BASE + 400, 2, 14));
+  CHECK_EQUAL(0, storm.update(BASE + 800, 6, 20));
+
+  CHECK_EQUAL(12, storm.events(BASE + 800));
+  DOUBLES_EQUAL(12 * 2.0, storm.rate(BASE + 800), TOLERANCE);
+  CHECK_EQUAL(14, storm.closest(BASE + 800));
+  DOUBLES_EQUAL((4 * 20 + 2 * 14 + 6 * 20) / 12.0, storm.meanDistance(BASE + 800), TOLERANCE);
+
+  // First bucket leaves the window
+  CHECK_EQUAL(8, storm.events(BASE + STORM_BUCKETS * STORM_BUCKET));
+  CHECK_EQUAL(14, storm.closest(BASE + STORM_BUCKETS * STORM_BUCKET));
+
+  // Bucket reused
+  storm.update(BASE + STORM_BUCKETS * STORM_BUCKET + 10, 1, 30);
+  CHECK_EQUAL(9, storm.events(BASE + STORM_BUCKETS * STORM_BUCKET + 10));
+
+  // Out of order update ignored
+  CHECK_EQUAL(0, storm.update(BASE, 5, 1));
+  CHECK_EQUAL(9, storm.events(BASE + STORM_BUCKETS * STORM_BUCKET + 10));
+
+  storm.reset();
+  CHECK_FALSE(storm.isActive());
+  CHECK_EQUAL(0, storm.events(BASE + 800));
+}
+
+/*
+ * Test approaching storm - distance decreasing by 30 km/h
+ */
+TEST(TG_StormApproach, Test_StormApproach) {
+  StormTracker storm;
+  bool valid;
+  int approach = 0;
+  int nearby = 0;
+
+  printf("< StormApproach >\n");
+
+  for (int i = 0; i <= 35; i++) {
+    uint8_t flags = storm.update(BASE + i * 120, 3, 40 - i);
+    if (i == 0) {
+      CHECK_EQUAL(STORM_START, flags);
+      CHECK_EQUAL(STORM_TREND_UNKNOWN, storm.trend());
+    }
+    if (flags & STORM_APPROACH) {
+      approach++;
+      CHECK_EQUAL(STORM_TREND_MIN_SPAN / 120, i);
+    }
+    if (flags & STORM_NEARBY) {
+      nearby++;
+      CHECK_EQUAL(40 - STORM_ALERT_DISTANCE + 1, i);
+    }
+  }
+  CHECK_EQUAL(1, approach);
+  CHECK_EQUAL(1, nearby);
+  CHECK_EQUAL(STORM_TREND_APPROACHING, storm.trend());
+  DOUBLES_EQUAL(-30.0, storm.speed(&valid), 0.5);
+  CHECK(valid);
+  CHECK_EQUAL(5, storm.closest(BASE + 35 * 120));
+}
+
+/*
+ * Test receding storm with noisy distance - no approach alert
+ */
+TEST(TG_StormRecede, Test_StormRecede) {
+  StormTracker storm;
+  bool valid;
+
+  printf("< StormRecede >\n");
+
+  static const int8_t noise[] = {2, -1, 0, 1, -2, 1, -1, 0};
+
+  for (int i = 0; i <= 40; i++) {
+    uint8_t flags = storm.update(BASE + i * 90, 1, 15 + i / 2 + noise[i % 8]);
+    CHECK_FALSE(flags & STORM_APPROACH);
+  }
+  CHECK_EQUAL(STORM_TREND_RECEDING, storm.trend());
+  float v = storm.speed(&valid);
+  CHECK(valid);
+  CHECK(v > 15.0);
+  CHECK(v < 25.0);
+
+  // Stationary storm
+  storm.reset();
+  for (int i = 0; i <= 40; i++) {
+    storm.update(BASE + i * 90, 1, 15 + noise[i % 8]);
+  }
+  CHECK_EQUAL(STORM_TREND_STEADY, storm.trend());
+}
+
+/*
+ * Test end of storm after STORM_TIMEOUT without events
+ */
+TEST(TG_StormEnd, Test_StormEnd) {
+  StormTracker storm;
+
+  printf("< StormEnd >\n");
+
+  storm.update(BASE, 1, 30);
+  storm.update(BASE + 300, 1, 28);
+  CHECK_EQUAL(STORM_TREND_UNKNOWN, storm.trend());
+  CHECK_EQUAL(STORM_APPROACH, storm.update(BASE + 600, 1, 26));
+  CHECK_EQUAL(STORM_TREND_APPROACHING, storm.trend());
+
+  CHECK_EQUAL(0, storm.update(BASE + 600 + STORM_TIMEOUT - 1, 0, 0));
+  CHECK(storm.isActive());
+  CHECK_EQUAL(STORM_END, storm.update(BASE + 600 + STORM_TIMEOUT, 0, 0));
+  CHECK_FALSE(storm.isActive());
+  CHECK_EQUAL(STORM_TREND_UNKNOWN, storm.trend());
+
+  // New storm starts with a new regression
+  CHECK_EQUAL(STORM_START | STORM_NEARBY, storm.update(BASE + 7200, 1, 8));
+  CHECK_EQUAL(STORM_TREND_UNKNOWN, storm.trend());
+  CHECK_EQUAL(8, storm.closest(BASE + 7200));
+}
@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestTimebase.cpp
+//
+// CppUTest unit tests for Timebase - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CppUTest/TestHarness.h"
+
+#include "Timebase.h"
+
+#define SEC 1000000LL
+#define UTC_BASE (1662451200LL * SEC) // 2022-09-06 08:00:00 UTC
+
+TEST_GROUP(TG_TimebaseBasic) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_TimebaseSlew) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_TimebaseStep) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_TimebaseRate) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test conversion with a single anchor
+ */
+TEST(TG_TimebaseBasic, Test_TimebaseBasic) {
+  Timebase timebase;
+
+  printf("< TimebaseBasic >\n");
+
+  CHECK_FALSE(timebase.valid());
+
+  timebase.anchor(5 * SEC, UTC_BASE);
+  CHECK(timebase.valid());
+  CHECK_EQUAL(UTC_BASE, timebase.toUtcUs(5 * SEC));
+  CHECK_EQUAL(UTC_BASE + 12 * SEC, timebase.toUtcUs(17 * SEC));
+  CHECK_EQUAL((time_t)(UTC_BASE / SEC + 12), timebase.toUtc(17 * SEC));
+
+  // Timestamp captured before the anchor was set
+  CHECK_EQUAL(UTC_BASE - 2 * SEC, timebase.toUtcUs(3 * SEC));
+
+  // No NTP for a day - keep extrapolating
+  CHECK_EQUAL(UTC_BASE + 86400LL * SEC, timebase.toUtcUs(5 * SEC + 86400LL * SEC));
+
+  timebase.reset();
+  CHECK_FALSE(timebase.valid());
+}
+
+/*
+ * Test that small offsets are slewed in without going backwards
+ */
+TEST(TG_TimebaseSlew, Test_TimebaseSlew) {
+  Timebase timebase;
+
+  printf("< TimebaseSlew >\n");
+
+  timebase.anchor(0, UTC_BASE);
+
+  // NTP says we are 100 ms fast after one hour
+  int64_t mono = 3600LL * SEC;
+  int64_t before = timebase.toUtcUs(mono - 1);
+  timebase.anchor(mono, UTC_BASE + 3600LL * SEC - 100000LL);
+
+  // Continuous at the anchor
+  CHECK(timebase.toUtcUs(mono) >= before);
+  CHECK_EQUAL(UTC_BASE + 3600LL * SEC, timebase.toUtcUs(mono));
+
+  // Slewing with at most 500 ppm - 100 ms need 200 s
+  int64_t prev = timebase.toUtcUs(mono);
+  for (int i = 1; i <= 300; i++) {
+    int64_t utc = timebase.toUtcUs(mono + i * SEC);
+    CHECK(utc > prev);
+    prev = utc;
+  }
+  CHECK_EQUAL(UTC_BASE + (3600LL + 10) * SEC - 5000LL, timebase.toUtcUs(mono + 10 * SEC));
+  CHECK_EQUAL(UTC_BASE + (3600LL + 300) * SEC - 100000LL, timebase.toUtcUs(mono + 300 * SEC));
+}
+
+/*
+ * Test that large offsets are stepped
+ */
+TEST(TG_TimebaseStep, Test_TimebaseStep) {
+  Timebase timebase;
+
+  printf("< TimebaseStep >\n");
+
+  timebase.anchor(0, UTC_BASE);
+  timebase.anchor(60 * SEC, UTC_BASE + 3600LL * SEC);
+  CHECK_EQUAL(UTC_BASE + 3600LL * SEC, timebase.toUtcUs(60 * SEC));
+  CHECK_EQUAL(UTC_BASE + 3601LL * SEC, timebase.toUtcUs(61 * SEC));
+  CHECK_EQUAL(0, timebase.rate());
+}
+
+/*
+ * Test that a constant clock rate error is learned
+ */
+TEST(TG_TimebaseRate, Test_TimebaseRate) {
+  Timebase timebase;
+
+  printf("< TimebaseRate >\n");
+
+  // Local clock runs 50 ppm slow
+  timebase.anchor(0, UTC_BASE);
+  int64_t err = 0;
+  for (int64_t h = 1; h <= 24; h++) {
+    int64_t mono = h * 3600LL * SEC;
+    int64_t utc = UTC_BASE + mono + mono / 20000LL;
+    err = utc - timebase.toUtcUs(mono);
+    timebase.anchor(mono, utc);
+  }
+  CHECK(err < 20000LL);
+  CHECK(err > -20000LL);
+  CHECK(timebase.rate() > 40000);
+  CHECK(timebase.rate() < 60000);
+}
@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestWindAggregator.cpp
+//
+// CppUTest unit tests for WindAggregator - artificial test cases
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Vitor Cantarella
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261019 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CppUTest/TestHarness.h"
+
+#include <math.h>
+#include "WindAggregator.h"
+
+#define TOLERANCE 0.1
+
+TEST_GROUP(TG_WindLut) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_WindDirection) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_WindSpeed) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TG_WindRose) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test lookup table trigonometry against the math library
+ */
+TEST(TG_WindLut, Test_WindLut) {
+  printf("< WindLut >\n");
+
+  for (int deg = -360; deg <= 720; deg++) {
+    double rad = deg * M_PI / 180.0;
+    DOUBLES_EQUAL(sin(rad), WindAggregator::sinQ15(deg) / 32768.0, 1.0 / 16384);
+    DOUBLES_EQUAL(cos(rad), WindAggregator::cosQ15(deg) / 32768.0, 1.0 / 16384);
+  }
+  CHECK_EQUAL(0, WindAggregator::sinQ15(180));
+  CHECK_EQUAL(-32767, WindAggregator::sinQ15(270));
+}
+
+/*
+ * Test vector mean of the wind direction
+ */
+TEST(TG_WindDirection, Test_WindDirection) {
+  WindAggregator wind;
+  bool valid;
+
+  printf("< WindDirection >\n");
+
+  wind.reset();
+  CHECK_EQUAL(0, wind.count());
+  wind.direction(&valid);
+  CHECK_FALSE(valid);
+
+  // Around north - the arithmetic mean would be 180 deg
+  wind.update(350, 5, 8);
+  wind.update(10, 5, 8);
+  float dir = wind.direction(&valid);
+  CHECK(valid);
+  CHECK((dir < TOLERANCE) || (dir > 360 - TOLERANCE));
+
+  // Weighted by speed
+  wind.reset();
+  wind.update(0, 1, 1);
+  wind.update(90, 3, 3);
+  DOUBLES_EQUAL(atan2(3.0, 1.0) * 180 / M_PI, wind.direction(), TOLERANCE);
+
+  // Constant direction - no deviation
+  wind.reset();
+  for (int i = 0; i < 100; i++) {
+    wind.update(225, 4, 6);
+  }
+  DOUBLES_EQUAL(225, wind.direction(), TOLERANCE);
+  DOUBLES_EQUAL(0, wind.directionStdDev(), 0.5);
+
+  // Uniformly varying +-30 deg around west - standard deviation 30/sqrt(3)
+  wind.reset();
+  for (int i = -30; i <= 30; i++) {
+    wind.update(270 + i, 4, 6);
+  }
+  DOUBLES_EQUAL(270, wind.direction(), TOLERANCE);
+  DOUBLES_EQUAL(30 / sqrt(3.0), wind.directionStdDev(), 0.5);
+
+  // Calm - no direction
+  wind.reset();
+  wind.update(123, 0, 0);
+  wind.direction(&valid);
+  CHECK_FALSE(valid);
+  CHECK_EQUAL(1, wind.calm());
+}
+
+/*
+ * Test wind speed statistics and gust maximum
+ */
+TEST(TG_WindSpeed, Test_WindSpeed) {
+  WindAggregator wind;
+
+  printf("< WindSpeed >\n");
+
+  wind.reset();
+  wind.update(0, 2.0, 3.5);
+  wind.update(0, 4.0, 7.2);
+  wind.update(0, 6.0, 5.0);
+  CHECK_EQUAL(3, wind.count());
+  DOUBLES_EQUAL(4.0, wind.speed(), 0.01);
+  DOUBLES_EQUAL(sqrt(8.0 / 3), wind.speedStdDev(), 0.01);
+  DOUBLES_EQUAL(7.2, wind.gustMax(), 0.01);
+}
+
+/*
+ * Test wind rose sectors and speed bins
+ */
+TEST(TG_WindRose, Test_WindRose) {
+  WindAggregator wind;
+
+  printf("< WindRose >\n");
+
+  CHECK_EQUAL(0, WindAggregator::sector(0));
+  CHECK_EQUAL(0, WindAggregator::sector(11));
+  CHECK_EQUAL(1, WindAggregator::sector(12));
+  CHECK_EQUAL(4, WindAggregator::sector(90));
+  CHECK_EQUAL(15, WindAggregator::sector(348));
+  CHECK_EQUAL(0, WindAggregator::sector(349));
+  CHECK_EQUAL(0, WindAggregator::sector(359.6));
+  CHECK_EQUAL(12, WindAggregator::sector(-90));
+
+  wind.reset();
+  wind.update(0, 0.4, 1);     // calm
+  wind.update(0, 0.5, 1);     // N, bin 0
+  wind.update(355, 1.9, 1);   // N, bin 0
+  wind.update(90, 2.0, 3);    // E, bin 1
+  wind.update(180, 7.9, 9);   // S, bin 3
+  wind.update(180, 8.0, 9);   // S, bin 4
+  wind.update(247, 30, 40);   // WSW, bin 4
+
+  CHECK_EQUAL(1, wind.calm());
+  CHECK_EQUAL(2, wind.rose(0, 0));
+  CHECK_EQUAL(1, wind.rose(4, 1));
+  CHECK_EQUAL(1, wind.rose(8, 3));
+  CHECK_EQUAL(1, wind.rose(8, 4));
+  CHECK_EQUAL(1, wind.rose(11, 4));
+
+  int sum = wind.calm();
+  for (int s = 0; s < WIND_ROSE_SECTORS; s++) {
+    for (int b = 0; b < WIND_ROSE_BINS; b++) {
+      sum += wind.rose(s, b);
+    }
+  }
+  CHECK_EQUAL(wind.count(), sum);
+}